@@ -14,13 +14,26 @@ double Length = 10.0;   // 목표물의 길이
 double Width = 10.0;    // 목표물의 폭
 double Height = 10.0;   // 목표물의 높이
 double tInc = 0.1;      // 시뮬레이션 시간 증가 단위
+int integratorType = 0; // 적분기 종류 (0: 반암시적 오일러, 1: 속도 베를레, 2: RK4, 3: 적응형 RK45)
+bool eventDriven = false; // 사건 구동 진행 (탄도 구간을 해석적으로 건너뜀)
+std::string targetMeshPath; // 목표물 메시 OBJ 파일 (비어 있으면 상자 목표물)
+
+// 선택된 적분기 생성
+std::shared_ptr<const Integrator> CreateIntegrator(int type) {
+    switch (type) {
+    case 1: return std::make_shared<VelocityVerletIntegrator>();
+    case 2: return std::make_shared<RK4Integrator>();
+    case 3: return std::make_shared<AdaptiveRK45Integrator>();
+    default: return std::make_shared<SymplecticEulerIntegrator>();
+    }
+}
 
 // 유저 입력을 받아 각 파라미터 설정
 void GetUserInput() {
     char key;
     double inputValue;
     while (true) {
-        std::cout << "Enter 'x' to set Pitch (Alpha) or 'y' to set Yaw (Gamma), or 's' to start simulation: ";
+        std::cout << "Enter 'x' to set Pitch (Alpha), 'y' to set Yaw (Gamma), 'i' to select integrator, 'e' to toggle event-driven stepping, 'm' to load a target mesh, or 's' to start simulation: ";
         std::cin >> key;
 
         if (key == 's') {
@@ -52,15 +65,35 @@ void GetUserInput() {
                 std::cout << "Invalid input, Yaw (Gamma) remains " << Gamma << " degrees.\n";
             }
             break;
+        case 'i':
+            std::cout << "Select integrator (0: Symplectic Euler, 1: Velocity Verlet, 2: RK4, 3: Adaptive RK45): ";
+            std::cin >> inputValue;
+            if (!std::cin.fail() && inputValue >= 0 && inputValue <= 3) {
+                integratorType = static_cast<int>(inputValue);
+            }
+            else {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Invalid input, integrator remains " << integratorType << ".\n";
+            }
+            break;
+        case 'e':
+            eventDriven = !eventDriven;
+            std::cout << "Event-driven stepping " << (eventDriven ? "enabled" : "disabled") << ".\n";
+            break;
+        case 'm':
+            std::cout << "Enter target mesh OBJ path (coordinates relative to the target position): ";
+            std::cin >> targetMeshPath;
+            break;
         default:
-            std::cout << "Invalid option. Please enter 'x', 'y', or 's'.\n";
+            std::cout << "Invalid option. Please enter 'x', 'y', 'i', 'e', 'm', or 's'.\n";
             break;
         }
     }
 }
 
 void runSimulation(Simulator& simulator) {
-    while (simulator.runSimulationStep() == 0) {
+    while ((eventDriven ? simulator.advanceToNextEvent() : simulator.runSimulationStep()) == 0) {
         std::string status = simulator.getSimulationStatus();
         std::cout << status << std::endl;
 
@@ -82,6 +115,17 @@ int main() {
     GetUserInput();
     Simulator simulator(Vm, Alpha, Gamma, Yb, X, Z, Length, Width, Height, tInc);
     simulator.initialize();
+    simulator.setIntegrator(CreateIntegrator(integratorType));
+    if (!targetMeshPath.empty()) {
+        try {
+            std::shared_ptr<TriangleMesh> mesh = TriangleMesh::loadObj(targetMeshPath);
+            std::cout << "Loaded target mesh with " << mesh->getTriangleCount() << " triangles.\n";
+            simulator.setTargetMesh(mesh);
+        }
+        catch (const std::exception& e) {
+            std::cout << e.what() << "\nUsing box target.\n";
+        }
+    }
     runSimulation(simulator);
     return 0;
 }
@@ -7,10 +7,13 @@
 #include <random>
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include "FixedStepScheduler.h"
+#include "VectorField.h"
 
 // 파티클 구조체
 struct Particle {
     sf::Vector2f position;
+    sf::Vector2f previousPosition;  // 직전 고정 스텝 시작 때의 위치 (표시용 보간)
     sf::Vector2f velocity;
     sf::Color color;
     float lifetime;
@@ -26,14 +29,50 @@ void createParticles(std::vector<Particle>& particles, int count, sf::Vector2f p
         float angleRad = (angle + dis(gen)) * M_PI / 180.0f;
         sf::Vector2f velocityVec(velocity * cos(angleRad), velocity * sin(angleRad));
         sf::Color randomColor(rand() % 255, rand() % 255, rand() % 255);
-        particles.push_back({ position, velocityVec, randomColor, 5.0f });
+        particles.push_back({ position, position, velocityVec, randomColor, 5.0f });
     }
 }
 
-// 파티클 업데이트 함수 (중력 가속도 적용)
-void updateParticles(std::vector<Particle>& particles, float deltaTime, float gravity, float timeScale) {
-    for (auto& p : particles) {
+// 화면 전체를 덮는 소용돌이 난류 (phase 에 따라 모양이 바뀌는 단위 세기 장)
+VectorField::Generator makeTurbulence(double phase) {
+    return [phase](const Vector3<double>& p) {
+        return Vector3<double>(
+            std::sin(p.y * 0.013 + phase) + 0.5 * std::sin(p.y * 0.041 - 1.7 * phase),
+            std::cos(p.x * 0.011 - phase) + 0.5 * std::cos(p.x * 0.037 + 1.3 * phase),
+            0.0);
+    };
+}
+
+// 파티클 위치의 바람을 한 번에 샘플링 (버퍼는 호출 간 재사용)
+struct WindSampler {
+    std::vector<float> x, y, z;
+    std::vector<float> windX, windY, windZ;
+
+    void sample(const VectorField& field, const std::vector<Particle>& particles) {
+        std::size_t count = particles.size();
+        x.resize(count);
+        y.resize(count);
+        z.assign(count, 0.0f);
+        windX.resize(count);
+        windY.resize(count);
+        windZ.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            x[i] = particles[i].position.x;
+            y[i] = particles[i].position.y;
+        }
+        field.sampleBatch(x.data(), y.data(), z.data(), count, windX.data(), windY.data(), windZ.data());
+    }
+};
+
+// 파티클 업데이트 함수 (중력 가속도 + 바람 저항 적용)
+void updateParticles(std::vector<Particle>& particles, float deltaTime, float gravity, float timeScale,
+    const WindSampler& wind, float windStrength, float windDrag) {
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        Particle& p = particles[i];
         p.velocity.y += gravity * deltaTime * timeScale;  // 중력 가속도 적용
+        // 바람 속도로 끌려가는 선형 저항
+        sf::Vector2f air(wind.windX[i] * windStrength, wind.windY[i] * windStrength);
+        p.velocity += (air - p.velocity) * std::min(windDrag * deltaTime, 1.0f);
         p.position += p.velocity * deltaTime;  // 속도에 따른 위치 변화
         p.lifetime -= deltaTime;  // 파티클 수명 감소
     }
@@ -55,6 +94,22 @@ int main() {
     float gravity = 9.8f;
     float angle = 0.0f;
     float timeScale = 100.0f;
+    int physicsRate = 120;      // 초당 물리 스텝 수
+    int substeps = 1;           // 스텝당 하위 스텝 수
+
+    // 고정 주기 물리 스케줄러 (프레임당 최대 8 스텝)
+    FixedStepScheduler scheduler(physicsRate, substeps, 8);
+
+    // 바람 장: 화면을 50 px 격자로 덮고 2 초마다 다음 난류 프레임으로 넘어감
+    bool windEnabled = true;
+    float windStrength = 150.0f;    // px/s
+    float windDrag = 1.5f;          // 1/s
+    const double windFrameDuration = 2.0;
+    double windPhase = 0.0;
+    VectorField windField(17, 13, 2, 50.0);
+    windField.fill(makeTurbulence(windPhase));
+    windField.fillNext(makeTurbulence(windPhase + 1.0));
+    WindSampler windSampler;
 
     while (window.isOpen()) {
         sf::Event event;
@@ -74,19 +129,42 @@ int main() {
         ImGui::SliderFloat("Velocity", &initialVelocity, 0.0f, 1000.0f);
         ImGui::SliderFloat("Gravity", &gravity, 0.0f, 1000.0f);  // 중력값 조절 가능
         ImGui::SliderFloat("Angle", &angle, 0.0f, 360.0f);
+        if (ImGui::SliderInt("Physics Rate", &physicsRate, 30, 240)) {
+            scheduler.setStepRate(physicsRate);
+        }
+        if (ImGui::SliderInt("Substeps", &substeps, 1, 8)) {
+            scheduler.setSubsteps(substeps);
+        }
+        ImGui::Checkbox("Wind", &windEnabled);
+        ImGui::SliderFloat("Wind Strength", &windStrength, 0.0f, 500.0f);
+        ImGui::SliderFloat("Wind Drag", &windDrag, 0.0f, 10.0f);
         if (ImGui::Button("Create Particle Explosion")) {
             createParticles(particles, particleCount, sf::Vector2f(400, 300), initialVelocity, angle);
         }
         ImGui::End();
 
-        // 파티클 업데이트 (중력 추가)
-        updateParticles(particles, deltaTime, gravity, timeScale);
+        // 파티클 업데이트 (중력 추가): 프레임 시간과 무관하게 고정 dt 로 진행
+        // 보간은 고정 스텝 하나를 기준으로 하므로 이전 위치는 하위 스텝이 아니라 고정 스텝 시작 때 저장한다
+        scheduler.advance(deltaTime, [&]() {
+            for (Particle& p : particles) {
+                p.previousPosition = p.position;
+            }
+        }, [&](double stepDeltaTime) {
+            if (windField.advance(stepDeltaTime, windFrameDuration)) {
+                windPhase += 1.0;
+                windField.fillNext(makeTurbulence(windPhase + 1.0));
+            }
+            windSampler.sample(windField, particles);
+            updateParticles(particles, static_cast<float>(stepDeltaTime), gravity, timeScale,
+                windSampler, windEnabled ? windStrength : 0.0f, windEnabled ? windDrag : 0.0f);
+        });
+        float alpha = static_cast<float>(scheduler.getAlpha());
 
         // 파티클을 화면에 그리기
         window.clear();
         for (const auto& p : particles) {
             sf::CircleShape particleShape(3.0f);
-            particleShape.setPosition(p.position);
+            particleShape.setPosition(FixedStepScheduler::interpolate(p.previousPosition, p.position, alpha));
             particleShape.setFillColor(p.color);
             window.draw(particleShape);
         }
@@ -0,0 +1,168 @@
+﻿#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "PhysicsWorld.h"
+
+// 모턴 순서 재배치 벤치마크
+// 같은 장면을 무작위 순서로 추가한 월드 두 개를 같은 만큼 진행하되 한쪽만 reorderInterval 스텝마다 재배치하고,
+// 단계별 평균 스텝 시간과 접촉 쌍/입자 제약이 메모리에서 떨어진 거리를 비교한다.
+// 캐시 미스 하드웨어 계수기는 플랫폼마다 다르므로, 두 원소 사이 거리를 64 바이트 캐시 줄 수로 환산한 값과
+// 4 KB 페이지를 넘는 비율을 대리 지표로 출력한다.
+
+const std::size_t CACHE_LINE = 64;
+const std::size_t PAGE = 4096;
+
+struct SceneSize {
+    int columns;        // 물체 기둥 수 = columns²
+    int stack;          // 기둥당 물체 수
+    int clothSide;      // 천 입자 수 = clothSide²
+    int steps;
+    unsigned interval;  // 재배치 간격 (스텝)
+};
+
+struct Locality {
+    double averageLines;    // 평균 캐시 줄 간격
+    double farFraction;     // 페이지를 넘는 비율
+};
+
+struct RunResult {
+    double phaseTimes[static_cast<std::size_t>(StepPhase::Count)];
+    double total;
+    Locality bodies;
+    Locality particles;
+    std::size_t contacts;
+};
+
+// 두 원소 사이 거리 목록을 캐시 줄/페이지 단위로 요약
+Locality summarize(const std::vector<std::size_t>& strides) {
+    Locality result{ 0.0, 0.0 };
+    if (strides.empty()) {
+        return result;
+    }
+    double lines = 0.0;
+    std::size_t far = 0;
+    for (std::size_t bytes : strides) {
+        lines += static_cast<double>(bytes / CACHE_LINE);
+        far += bytes >= PAGE ? 1 : 0;
+    }
+    result.averageLines = lines / static_cast<double>(strides.size());
+    result.farFraction = static_cast<double>(far) / static_cast<double>(strides.size());
+    return result;
+}
+
+std::size_t distance(std::size_t a, std::size_t b) {
+    return a > b ? a - b : b - a;
+}
+
+RunResult run(const SceneSize& size, bool reorder) {
+    PhysicsWorld world;
+    world.reorderInterval = reorder ? size.interval : 0;
+    std::mt19937 rng(7);
+
+    // 물체 기둥: 격자 위치를 섞어서 추가하므로 추가 순서가 공간 순서와 무관하다
+    std::vector<Vector3<double>> spots;
+    for (int x = 0; x < size.columns; ++x) {
+        for (int z = 0; z < size.columns; ++z) {
+            for (int y = 0; y < size.stack; ++y) {
+                spots.push_back(Vector3<double>(x * 2.05, 1.0 + y * 2.0, z * 2.05));
+            }
+        }
+    }
+    std::shuffle(spots.begin(), spots.end(), rng);
+    for (const Vector3<double>& spot : spots) {
+        PhysicsObject body;
+        body.setScale(Vector3<double>(1.0, 1.0, 1.0));
+        body.setMass(1.0);
+        body.setPosition(spot);
+        world.addBody(body);
+    }
+
+    // 천: 입자를 섞어서 추가하고 격자 이웃끼리 거리 제약, 윗줄은 고정
+    XPBDSolver& cloth = world.getSoftBodies();
+    int side = size.clothSide;
+    std::vector<int> cells(side * side);
+    for (int i = 0; i < side * side; ++i) {
+        cells[i] = i;
+    }
+    std::shuffle(cells.begin(), cells.end(), rng);
+    std::vector<std::size_t> handleOf(side * side);
+    Vector3<double> origin(-side * 0.1, 30.0, -10.0);
+    for (int cell : cells) {
+        int r = cell / side;
+        int c = cell % side;
+        handleOf[cell] = cloth.addParticle(origin + Vector3<double>(c * 0.2, 0.0, r * 0.2), r == 0 ? 0.0 : 0.01);
+    }
+    std::vector<std::pair<std::size_t, std::size_t>> links;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) links.push_back(std::make_pair(handleOf[r * side + c], handleOf[r * side + c + 1]));
+            if (r + 1 < side) links.push_back(std::make_pair(handleOf[r * side + c], handleOf[(r + 1) * side + c]));
+        }
+    }
+    for (const auto& link : links) {
+        cloth.addDistanceConstraint(link.first, link.second, 1e-6);
+    }
+
+    RunResult result{};
+    const int warmup = static_cast<int>(size.interval) + 1;
+    for (int s = 0; s < warmup; ++s) {
+        world.step(1.0 / 60.0);
+    }
+    for (int s = 0; s < size.steps; ++s) {
+        world.step(1.0 / 60.0);
+        const StepReport& report = world.getLastStepReport();
+        for (std::size_t p = 0; p < static_cast<std::size_t>(StepPhase::Count); ++p) {
+            result.phaseTimes[p] += report.phaseTimes[p] / size.steps;
+        }
+        result.total += report.total / size.steps;
+    }
+
+    // 마지막 스텝의 물체 쌍 접촉과 천 제약이 잇는 두 원소의 메모리 거리
+    std::vector<std::size_t> strides;
+    for (const Contact& contact : world.getContacts()) {
+        if (contact.bodyA != Contact::STATIC_BODY) {
+            strides.push_back(distance(contact.bodyA, contact.bodyB) * sizeof(PhysicsObject));
+            ++result.contacts;
+        }
+    }
+    result.bodies = summarize(strides);
+    strides.clear();
+    for (const auto& link : links) {
+        strides.push_back(distance(cloth.getParticleSlot(link.first), cloth.getParticleSlot(link.second)) * sizeof(Vector3<double>));
+    }
+    result.particles = summarize(strides);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    // 사용법: 003-MortonOrder [기둥 한 변] [기둥 높이] [천 한 변] [측정 스텝] [재배치 간격]
+    SceneSize size{ 40, 4, 96, 120, 30 };
+    if (argc > 1) size.columns = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) size.stack = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) size.clothSide = std::max(2, std::atoi(argv[3]));
+    if (argc > 4) size.steps = std::max(1, std::atoi(argv[4]));
+    if (argc > 5) size.interval = static_cast<unsigned>(std::max(1, std::atoi(argv[5])));
+
+    std::printf("bodies %d, cloth particles %d, %d measured steps, reorder every %u steps\n",
+        size.columns * size.columns * size.stack, size.clothSide * size.clothSide, size.steps, size.interval);
+
+    RunResult inserted = run(size, false);
+    RunResult morton = run(size, true);
+
+    std::printf("\n%-12s %14s %14s\n", "phase (ms)", "insertion", "morton");
+    for (std::size_t p = 0; p < static_cast<std::size_t>(StepPhase::Count); ++p) {
+        std::printf("%-12s %14.3f %14.3f\n", getStepPhaseName(static_cast<StepPhase>(p)),
+            inserted.phaseTimes[p] * 1e3, morton.phaseTimes[p] * 1e3);
+    }
+    std::printf("%-12s %14.3f %14.3f\n", "total", inserted.total * 1e3, morton.total * 1e3);
+
+    std::printf("\n%-28s %14s %14s\n", "locality", "insertion", "morton");
+    std::printf("%-28s %14zu %14zu\n", "body pair contacts", inserted.contacts, morton.contacts);
+    std::printf("%-28s %14.1f %14.1f\n", "body pair lines apart", inserted.bodies.averageLines, morton.bodies.averageLines);
+    std::printf("%-28s %13.1f%% %13.1f%%\n", "body pairs beyond a page", inserted.bodies.farFraction * 100.0, morton.bodies.farFraction * 100.0);
+    std::printf("%-28s %14.1f %14.1f\n", "cloth link lines apart", inserted.particles.averageLines, morton.particles.averageLines);
+    std::printf("%-28s %13.1f%% %13.1f%%\n", "cloth links beyond a page", inserted.particles.farFraction * 100.0, morton.particles.farFraction * 100.0);
+    return 0;
+}
@@ -0,0 +1,100 @@
+﻿#ifndef ARTICULATEDBODY_H
+#define ARTICULATEDBODY_H
+
+#include <cstddef>
+#include <vector>
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "Matrix3x3.h"
+#include "SpatialMath.h"
+
+// 관절 종류
+enum class JointType {
+    Revolute,   // 축 회전 1 자유도 (각도, rad)
+    Prismatic,  // 축 이동 1 자유도 (변위, m)
+    Spherical   // 구면 3 자유도 (쿼터니언, 각속도는 자식 좌표계 기준)
+};
+
+// 축약 좌표 다관절체 (고정 기저)
+// 링크는 부모가 먼저 추가된 트리이며, 순동역학은 Featherstone 의 관절체 알고리즘(ABA)으로 O(n) 에 계산한다.
+// 각 링크 좌표계의 원점은 그 링크의 관절 위치이다.
+class ArticulatedBody {
+public:
+    static constexpr int BASE = -1;
+
+    struct Link {
+        int parent;                     // 부모 링크 (BASE 이면 기저)
+        JointType joint;
+        Vector3<double> axis;           // 관절 축 (관절 좌표계, 단위 벡터)
+        Vector3<double> offset;         // 부모 좌표계에서 관절 위치
+        Quaternion<double> frame;       // 부모 좌표계에 대한 관절 좌표계 방향
+
+        double mass;
+        Vector3<double> centerOfMass;   // 링크 좌표계
+        Matrix3x3<double> inertia;      // 질량 중심 기준 관성 텐서 (링크 좌표계)
+
+        double position;                // 1 자유도 관절 좌표
+        Quaternion<double> rotation;    // 구면 관절 좌표
+        Vector3<double> velocity;       // 관절 속도 (1 자유도는 x 성분만 사용)
+        Vector3<double> acceleration;   // 관절 가속도
+        Vector3<double> torque;         // 관절 토크/힘
+        double damping;                 // 관절 점성 감쇠
+    };
+
+    ArticulatedBody();
+
+    // 링크 추가 (parent 는 BASE 또는 이미 추가된 링크), 반환값은 링크 인덱스
+    std::size_t addLink(int parent, JointType joint, const Vector3<double>& axis, const Vector3<double>& offset,
+        double mass, const Vector3<double>& centerOfMass, const Matrix3x3<double>& inertia,
+        const Quaternion<double>& frame = Quaternion<double>(1.0, 0.0, 0.0, 0.0));
+
+    std::size_t getLinkCount() const { return links.size(); }
+    Link& getLink(std::size_t index) { return links[index]; }
+    const Link& getLink(std::size_t index) const { return links[index]; }
+
+    // 기저 (운동학적으로 배치)
+    Vector3<double> basePosition;
+    Quaternion<double> baseOrientation;
+    Vector3<double> gravity;        // 월드 좌표계
+
+    // 다음 스텝에만 작용하는 외력 (월드 좌표의 힘과 작용점)
+    void applyLinkForce(std::size_t index, const Vector3<double>& force, const Vector3<double>& point);
+
+    // 순동역학: 현재 관절 좌표/속도/토크에서 관절 가속도 계산
+    void computeForwardDynamics();
+
+    // 반암시적 오일러 스텝 (가속도 계산 → 속도 → 좌표)
+    void step(double deltaTime);
+
+    // 월드 좌표계 링크 자세 (computeForwardDynamics 또는 updateKinematics 이후 유효)
+    Vector3<double> getLinkPosition(std::size_t index) const { return worldPositions[index]; }
+    Matrix3x3<double> getLinkRotation(std::size_t index) const { return worldRotations[index]; }
+    void updateKinematics();
+
+    // 운동 에너지 + 중력 위치 에너지 (검증용)
+    double computeEnergy();
+
+private:
+    std::vector<Link> links;
+
+    // 알고리즘 작업 버퍼 (링크별)
+    std::vector<SpatialTransform> parentToLink;     // Xup
+    std::vector<SpatialVector> velocities;
+    std::vector<SpatialVector> biasAccelerations;   // c
+    std::vector<SpatialVector> biasForces;          // pA
+    std::vector<SpatialMatrix> articulatedInertias; // IA
+    std::vector<SpatialVector> externalForces;      // 링크 좌표계
+    std::vector<SpatialVector> spatialAccelerations;
+    std::vector<SpatialVector> motionSubspace;      // 링크당 3 열 (사용하지 않는 열은 0)
+    std::vector<SpatialVector> projectedInertia;    // U = IA S
+    std::vector<Matrix3x3<double>> inverseJointInertias;    // D⁻¹
+    std::vector<Vector3<double>> jointForces;       // u = τ - Sᵀ pA
+    std::vector<Vector3<double>> worldPositions;
+    std::vector<Matrix3x3<double>> worldRotations;
+
+    static std::size_t dofCount(JointType joint) { return joint == JointType::Spherical ? 3 : 1; }
+    SpatialTransform jointTransform(const Link& link) const;
+    void resizeBuffers();
+};
+
+#endif // ARTICULATEDBODY_H
@@ -0,0 +1,145 @@
+﻿#ifndef COLLISIONSHAPE_H
+#define COLLISIONSHAPE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix3x3.h"
+#include "Quaternion.h"
+
+// 충돌 형상 종류
+enum class ShapeType {
+    Sphere,
+    Box,
+    Capsule,
+    Cylinder,
+    ConvexHull,
+    Compound
+};
+
+// 충돌 형상 기반 클래스
+// 생성 시 질량 특성을 한 번만 계산하고 이후에는 변경되지 않으므로 여러 물체가 하나의 인스턴스를 공유할 수 있다.
+// 관성 텐서는 단위 질량(1kg) 기준이며, 질량 m 인 물체는 I = m * unitInertia, I⁻¹ = unitInverseInertia / m 로 얻는다.
+class CollisionShape {
+public:
+    virtual ~CollisionShape() {}
+
+    ShapeType getType() const { return type; }
+    double getVolume() const { return volume; }
+    double getMass(double density) const { return density * volume; }
+    Vector3<double> getCenterOfMass() const { return centerOfMass; }     // 형상 원점 기준 질량 중심
+    const Matrix3x3<double>& getUnitInertia() const { return unitInertia; }
+    const Matrix3x3<double>& getUnitInverseInertia() const { return unitInverseInertia; }
+    double getBoundingRadius() const { return boundingRadius; }          // 형상 원점 기준 경계 구 반지름
+
+protected:
+    explicit CollisionShape(ShapeType type);
+
+    // 대각 관성 텐서 설정 (역행렬을 닫힌 형태로 계산)
+    void setDiagonalInertia(double ix, double iy, double iz);
+    // 일반 관성 텐서 설정 (생성 시 한 번만 역행렬 계산)
+    void setInertia(const Matrix3x3<double>& inertia);
+
+    ShapeType type;
+    double volume;
+    Vector3<double> centerOfMass;
+    Matrix3x3<double> unitInertia;
+    Matrix3x3<double> unitInverseInertia;
+    double boundingRadius;
+};
+
+// 구
+class SphereShape : public CollisionShape {
+public:
+    explicit SphereShape(double radius);
+    double getRadius() const { return radius; }
+
+private:
+    double radius;
+};
+
+// 직육면체 (반 크기 기준)
+class BoxShape : public CollisionShape {
+public:
+    explicit BoxShape(const Vector3<double>& halfExtents);
+    Vector3<double> getHalfExtents() const { return halfExtents; }
+
+private:
+    Vector3<double> halfExtents;
+};
+
+// 캡슐 (y 축 방향, halfHeight 는 원통 부분의 절반 길이)
+class CapsuleShape : public CollisionShape {
+public:
+    CapsuleShape(double radius, double halfHeight);
+    double getRadius() const { return radius; }
+    double getHalfHeight() const { return halfHeight; }
+
+private:
+    double radius;
+    double halfHeight;
+};
+
+// 원기둥 (y 축 방향)
+class CylinderShape : public CollisionShape {
+public:
+    CylinderShape(double radius, double halfHeight);
+    double getRadius() const { return radius; }
+    double getHalfHeight() const { return halfHeight; }
+
+private:
+    double radius;
+    double halfHeight;
+};
+
+// 볼록 껍질 (바깥쪽을 향하는 반시계 방향 삼각형 목록)
+class ConvexHullShape : public CollisionShape {
+public:
+    ConvexHullShape(const std::vector<Vector3<double>>& vertices, const std::vector<unsigned int>& triangles);
+    const std::vector<Vector3<double>>& getVertices() const { return vertices; }
+    const std::vector<unsigned int>& getTriangles() const { return triangles; }
+
+private:
+    std::vector<Vector3<double>> vertices;
+    std::vector<unsigned int> triangles;
+};
+
+// 여러 형상을 상대 위치/회전으로 묶은 복합 형상 (밀도 균일 가정)
+class CompoundShape : public CollisionShape {
+public:
+    struct Child {
+        std::shared_ptr<const CollisionShape> shape;
+        Vector3<double> position;
+        Quaternion<double> orientation;
+    };
+
+    explicit CompoundShape(const std::vector<Child>& children);
+    const std::vector<Child>& getChildren() const { return children; }
+
+private:
+    std::vector<Child> children;
+};
+
+// 같은 매개변수의 기본 형상을 하나의 인스턴스로 공유하는 캐시
+// 사용하는 물체가 모두 사라지면 형상도 해제된다 (weak_ptr 보관).
+class ShapeCache {
+public:
+    static std::shared_ptr<const CollisionShape> sphere(double radius);
+    static std::shared_ptr<const CollisionShape> box(const Vector3<double>& halfExtents);
+    static std::shared_ptr<const CollisionShape> capsule(double radius, double halfHeight);
+    static std::shared_ptr<const CollisionShape> cylinder(double radius, double halfHeight);
+
+private:
+    typedef std::tuple<int, double, double, double> Key;
+
+    template<typename Factory>
+    static std::shared_ptr<const CollisionShape> findOrCreate(const Key& key, Factory create);
+
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<const CollisionShape>> shapes;
+};
+
+#endif // COLLISIONSHAPE_H
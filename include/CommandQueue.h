@@ -0,0 +1,78 @@
+﻿#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "HandlePool.h"
+
+class PhysicsObject;
+
+enum class BodyCommandType {
+    ApplyForce,         // 이번 스텝 외력에 누적
+    ApplyTorque,        // 이번 스텝 토크에 누적
+    ApplyImpulse,       // 질량 중심에 선충격량
+    SetPosition,
+    SetOrientation,
+    SetVelocity,
+    SetAngularVelocity
+};
+
+// 다른 스레드에서 물리 스레드로 보내는 물체 명령
+struct BodyCommand {
+    BodyCommandType type;
+    BodyHandle body;
+    Vector3<double> vector;         // 힘/토크/충격량/위치/속도/각속도
+    Quaternion<double> orientation; // SetOrientation 전용
+};
+
+// 고정 용량 다중 생산자/단일 소비자 명령 큐 (셀마다 순번을 두는 링 버퍼, 잠금 없음)
+// 생산자는 쓰기 위치를 CAS 로 예약한 뒤 셀을 채우고 순번을 올린다. 소비자는 순번이 맞는 셀까지만 꺼낸다.
+// 가득 차면 push 가 false 를 돌려주며 명령은 버려지지 않고 호출자에게 남는다.
+class CommandQueue {
+public:
+    // capacity 는 2 의 거듭제곱으로 올림
+    explicit CommandQueue(std::size_t capacity = 4096);
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // 생산자 (아무 스레드)
+    bool push(const BodyCommand& command);
+    bool applyForce(BodyHandle body, const Vector3<double>& force) { return pushVector(BodyCommandType::ApplyForce, body, force); }
+    bool applyTorque(BodyHandle body, const Vector3<double>& torque) { return pushVector(BodyCommandType::ApplyTorque, body, torque); }
+    bool applyImpulse(BodyHandle body, const Vector3<double>& impulse) { return pushVector(BodyCommandType::ApplyImpulse, body, impulse); }
+    bool setPosition(BodyHandle body, const Vector3<double>& position) { return pushVector(BodyCommandType::SetPosition, body, position); }
+    bool setVelocity(BodyHandle body, const Vector3<double>& velocity) { return pushVector(BodyCommandType::SetVelocity, body, velocity); }
+    bool setAngularVelocity(BodyHandle body, const Vector3<double>& w) { return pushVector(BodyCommandType::SetAngularVelocity, body, w); }
+    bool setOrientation(BodyHandle body, const Quaternion<double>& q);
+
+    // 소비자 (물리 스레드): 지금까지 들어온 명령을 순서대로 out 뒤에 붙이고 개수를 돌려준다
+    std::size_t drain(std::vector<BodyCommand>& out);
+
+    std::size_t getCapacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        BodyCommand command;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> enqueuePosition;
+    alignas(64) std::size_t dequeuePosition;
+
+    bool pushVector(BodyCommandType type, BodyHandle body, const Vector3<double>& v);
+};
+
+// 꺼낸 명령을 물체별로 합쳐 물체마다 한 번씩 적용하고 적용한 물체 수를 돌려준다 (commands 는 물체 슬롯 순으로 안정 정렬됨)
+// 같은 물체의 명령은 들어온 순서를 지키며 합친다: 힘/토크/충격량은 더하고, 설정 명령은 마지막 값이 이긴다.
+// 속도 설정은 그 앞의 충격량을 덮어쓰고 뒤의 충격량은 설정값에 더해진다.
+// 핸들은 handles 로 bodies 의 슬롯을 찾으며, 명령을 받은 물체는 깨어나고 오래된 핸들의 명령은 버린다.
+std::size_t applyBodyCommands(std::vector<BodyCommand>& commands, const HandlePool& handles, PhysicsObject* bodies);
+
+#endif // COMMANDQUEUE_H
@@ -0,0 +1,80 @@
+﻿#ifndef CONSTRAINTBATCH_H
+#define CONSTRAINTBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Contact.h"
+#include "PhysicsObject.h"
+#include "SimdLanes.h"
+
+// 레인 단위로 Vector3 성분을 모아둔 SoA 벡터
+template<std::size_t N>
+struct LaneVector3 {
+    double x[N];
+    double y[N];
+    double z[N];
+
+    void set(std::size_t lane, const Vector3<double>& v) { x[lane] = v.x; y[lane] = v.y; z[lane] = v.z; }
+    Vector3<double> get(std::size_t lane) const { return Vector3<double>(x[lane], y[lane], z[lane]); }
+};
+
+// 같은 색의 접촉 LANES 개를 묶은 배치
+// 한 배치 안의 접촉은 동적 물체를 공유하지 않으므로 모든 레인을 동시에 갱신할 수 있다.
+struct ContactBatch {
+    static constexpr std::size_t LANES = GAMEPHYSICS_SIMD_DOUBLE_LANES;
+    static constexpr std::size_t EMPTY_LANE = static_cast<std::size_t>(-1);
+
+    std::size_t contact[LANES];     // 원본 Contact 인덱스 (빈 레인은 EMPTY_LANE)
+    std::size_t bodyA[LANES];
+    std::size_t bodyB[LANES];
+
+    LaneVector3<LANES> normal;
+    LaneVector3<LANES> tangent;
+    LaneVector3<LANES> rAxN;        // rA × n
+    LaneVector3<LANES> rBxN;        // rB × n
+    LaneVector3<LANES> angularAN;   // I_A⁻¹ (rA × n)
+    LaneVector3<LANES> angularBN;   // I_B⁻¹ (rB × n)
+    LaneVector3<LANES> rAxT;
+    LaneVector3<LANES> rBxT;
+    LaneVector3<LANES> angularAT;
+    LaneVector3<LANES> angularBT;
+
+    double inverseMassA[LANES];
+    double inverseMassB[LANES];
+    double normalMass[LANES];       // 1 / K_n
+    double tangentMass[LANES];      // 1 / K_t
+    double targetVelocity[LANES];   // 반발 + 위치 보정 목표 분리 속도
+    double normalImpulse[LANES];
+    double tangentImpulse[LANES];
+};
+
+// 섬 내부 접촉 그래프를 탐욕적으로 색칠하고 색마다 SIMD 폭 배치로 묶는다
+class ConstraintBatcher {
+public:
+    // 비트마스크로 추적하는 최대 색 수. 넘치는 접촉은 overflow 목록에서 순차적으로 푼다.
+    static constexpr std::size_t MAX_COLORS = 64;
+
+    void build(const std::vector<PhysicsObject>& bodies,
+        const std::vector<Contact>& contacts,
+        const std::vector<std::size_t>& islandContacts);
+
+    std::size_t getColorCount() const { return colorOffsets.empty() ? 0 : colorOffsets.size() - 1; }
+
+    // 색 c 에 속한 배치 범위 [getColorBegin(c), getColorEnd(c))
+    std::size_t getColorBegin(std::size_t color) const { return colorOffsets[color]; }
+    std::size_t getColorEnd(std::size_t color) const { return colorOffsets[color + 1]; }
+
+    std::vector<ContactBatch>& getBatches() { return batches; }
+    const std::vector<std::size_t>& getOverflow() const { return overflow; }
+
+private:
+    std::vector<ContactBatch> batches;
+    std::vector<std::size_t> colorOffsets;
+    std::vector<std::size_t> overflow;
+
+    std::vector<std::uint64_t> bodyColors;              // 물체별 사용 중인 색 비트마스크
+    std::vector<std::vector<std::size_t>> colorContacts;
+};
+
+#endif // CONSTRAINTBATCH_H
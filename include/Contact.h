@@ -0,0 +1,32 @@
+﻿#ifndef CONTACT_H
+#define CONTACT_H
+
+#include <cstddef>
+#include "Vector3.h"
+
+// 두 물체 사이의 접촉 정보
+// bodyB 가 STATIC_BODY 이면 바닥과 같은 고정 환경과의 접촉을 의미한다.
+struct Contact {
+    static constexpr std::size_t STATIC_BODY = static_cast<std::size_t>(-1);
+
+    std::size_t bodyA;
+    std::size_t bodyB;
+    Vector3<double> point;      // 월드 좌표계 접촉점
+    Vector3<double> normal;     // A → B 방향 단위 법선
+    double penetration;         // 침투 깊이
+
+    // 솔버 누적 값 (프레임 간 유지되지 않음)
+    double normalImpulse;
+    double tangentImpulse;
+    double velocityBias;        // 반발 계수로 계산한 목표 분리 속도
+    Vector3<double> tangent;    // 마찰 방향
+};
+
+// 두 물체의 중심 사이 거리를 유지하는 거리 제약
+struct DistanceJoint {
+    std::size_t bodyA;
+    std::size_t bodyB;
+    double restLength;
+};
+
+#endif // CONTACT_H
@@ -0,0 +1,74 @@
+﻿#ifndef CONTACTEVENTS_H
+#define CONTACTEVENTS_H
+
+#include <cstddef>
+#include <vector>
+#include "Contact.h"
+#include "Vector3.h"
+#include "HandlePool.h"
+
+// 접촉 이벤트 종류
+enum class ContactEventType {
+    Begin,      // 이번 스텝에 새로 생긴 접촉
+    Persist,    // 이전 스텝부터 이어지는 접촉
+    End         // 이번 스텝에 사라진 접촉 (마지막으로 알려진 접촉점/법선, 충격량 0)
+};
+
+// 스텝 단위 이벤트 버퍼에 기록되는 접촉 이벤트 (물체 핸들 bodyA < bodyB)
+// 고정 환경은 번호가 가장 큰 null 핸들이므로 항상 bodyB 이며 bodyB.isNull() 로 알 수 있다.
+// 제거된 물체와의 접촉은 다음 스텝에 End 로 한 번 기록되며, 이때의 핸들은 이미 오래된 핸들이다.
+struct ContactEvent {
+    ContactEventType type;
+    BodyHandle bodyA;
+    BodyHandle bodyB;
+    Vector3<double> point;
+    Vector3<double> normal;     // A → B
+    double normalImpulse;
+    double tangentImpulse;
+};
+
+// 매 스텝의 접촉 목록을 이전 스텝과 비교해 Begin/Persist/End 이벤트를 평탄한 배열에 기록
+// 솔버 루프 안에서는 콜백을 호출하지 않으며, 게임 코드는 스텝이 끝난 뒤 이벤트를 한꺼번에 처리한다.
+class ContactEventBuffer {
+public:
+    // 이번 스텝의 접촉으로 이벤트를 다시 만든다 (이전 이벤트는 지워짐)
+    // 접촉의 물체 인덱스는 bodyHandles[인덱스] 로 바꿔 기록하므로, 물체 배열 순서가 바뀌어도 쌍이 이어지고
+    // 제거된 물체의 번호가 재사용되어도 세대가 달라 새 쌍으로 구분된다.
+    void update(const std::vector<Contact>& contacts, const std::vector<BodyHandle>& bodyHandles);
+
+    // 고정 환경을 나타내는 핸들
+    static BodyHandle getStaticHandle() { return BodyHandle(0xFFFFFFFFu, 0); }
+
+    const std::vector<ContactEvent>& getEvents() const { return events; }
+
+    // 이벤트 배열을 out 과 맞바꾼다. 다른 스레드의 소비자가 복사 없이 소유권을 가져갈 때 사용
+    void swapEvents(std::vector<ContactEvent>& out) { events.swap(out); events.clear(); }
+
+    void clear();
+
+    // 이전 스텝에 접촉 중이던 쌍 (다음 스텝의 Begin/End 판정 기준, 스냅샷에 포함됨)
+    struct PairRecord {
+        BodyHandle bodyA;
+        BodyHandle bodyB;
+        Vector3<double> point;
+        Vector3<double> normal;
+        double normalImpulse;
+        double tangentImpulse;
+
+        bool operator<(const PairRecord& other) const {
+            return bodyA != other.bodyA ? bodyA < other.bodyA : bodyB < other.bodyB;
+        }
+    };
+
+    const std::vector<PairRecord>& getPreviousPairs() const { return previousPairs; }
+
+    // 스냅샷 복원: 이전 스텝 쌍 목록을 교체하고 이번 스텝 이벤트는 비운다
+    void restorePreviousPairs(const PairRecord* pairs, std::size_t count);
+
+private:
+    std::vector<ContactEvent> events;
+    std::vector<PairRecord> previousPairs;
+    std::vector<PairRecord> currentPairs;
+};
+
+#endif // CONTACTEVENTS_H
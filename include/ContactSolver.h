@@ -0,0 +1,49 @@
+﻿#ifndef CONTACTSOLVER_H
+#define CONTACTSOLVER_H
+
+#include <vector>
+#include "Contact.h"
+#include "ConstraintBatch.h"
+#include "Island.h"
+#include "PhysicsObject.h"
+#include "ThreadPool.h"
+
+// 순차 충격량(Sequential Impulse) 방식의 접촉/제약 솔버
+class ContactSolver {
+public:
+    ContactSolver();
+
+    int velocityIterations;     // 속도 반복 횟수
+    double restitution;         // 반발 계수
+    double friction;            // 마찰 계수
+    double baumgarte;           // 위치 오차 보정 비율
+    double penetrationSlop;     // 허용 침투 깊이
+
+    // 섬 하나의 접촉과 제약을 푼다. 섬끼리는 물체를 공유하지 않으므로 동시에 호출해도 안전하다.
+    void solveIsland(std::vector<PhysicsObject>& bodies,
+        std::vector<Contact>& contacts,
+        const std::vector<DistanceJoint>& joints,
+        const Island& island,
+        double deltaTime) const;
+
+    // 큰 섬(쌓인 더미 등)용: 접촉 그래프를 색칠하고 같은 색의 SIMD 배치를 스레드 풀에서 동시에 푼다.
+    // 스레드 풀의 parallelFor 안에서 호출하면 안 된다.
+    void solveIslandBatched(std::vector<PhysicsObject>& bodies,
+        std::vector<Contact>& contacts,
+        const std::vector<DistanceJoint>& joints,
+        const Island& island,
+        ConstraintBatcher& batcher,
+        ThreadPool& threadPool,
+        double deltaTime) const;
+
+    // 배치 처리 (레인 데이터 준비 / 모든 레인에 대한 한 번의 충격량 계산)
+    void prepareBatch(std::vector<PhysicsObject>& bodies, std::vector<Contact>& contacts, ContactBatch& batch, double deltaTime) const;
+    void solveBatch(std::vector<PhysicsObject>& bodies, ContactBatch& batch) const;
+
+    // 개별 접촉 처리 (반복 전 준비 / 한 번의 충격량 계산)
+    void prepareContact(std::vector<PhysicsObject>& bodies, Contact& c) const;
+    void solveContact(std::vector<PhysicsObject>& bodies, Contact& c, double deltaTime) const;
+    void solveJoint(std::vector<PhysicsObject>& bodies, const DistanceJoint& j, double deltaTime) const;
+};
+
+#endif // CONTACTSOLVER_H
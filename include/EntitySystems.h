@@ -0,0 +1,43 @@
+﻿#ifndef ENTITYSYSTEMS_H
+#define ENTITYSYSTEMS_H
+
+#include "EntityWorld.h"
+#include "ThreadPool.h"
+
+class PhysicsObject;
+
+// PhysicsObject 의 적분 과정을 구성 요소 위의 시스템으로 옮긴 것
+// 각 시스템은 필요한 구성 요소를 모두 가진 청크만 골라 청크 단위로 병렬 처리하며,
+// 같은 초기 상태에서 PhysicsObject 의 integrateVelocity / integratePosition 과 같은 결과를 낸다.
+// 접촉 해결과 섬/수면 처리는 PhysicsWorld 에 남아 있다.
+
+// 강체 엔티티의 구성 요소 조합
+const ComponentMask RIGID_BODY_COMPONENTS = componentBit(ComponentType::Transform) | componentBit(ComponentType::Velocity)
+    | componentBit(ComponentType::Mass) | componentBit(ComponentType::Force)
+    | componentBit(ComponentType::Shape) | componentBit(ComponentType::Collider);
+
+// 질량과 형상(nullptr 이면 scale 기반 근사)으로 질량 구성 요소 생성 (isStatic 이면 역질량/역관성 0)
+Mass makeMass(double mass, const Vector3<double>& scale, const CollisionShape* shape, bool isStatic = false);
+
+// PhysicsObject 의 현재 상태로 강체 엔티티 생성 (기존 물체를 옮겨 올 때 사용)
+Entity createRigidBody(EntityWorld& world, const PhysicsObject& body, const Collider& collider);
+
+// Transform + Mass: 월드 좌표계 역관성 텐서 R I⁻¹ Rᵀ 갱신
+void updateWorldInertiaSystem(EntityWorld& world, ThreadPool& pool);
+
+// Mass + Force: 균일 중력을 외력에 누적 (정적 물체 제외)
+void gravitySystem(EntityWorld& world, ThreadPool& pool, const Vector3<double>& gravity);
+
+// Velocity + Mass + Force: 힘 → 속도, 토크 → 각속도 (적분 후 외력과 토크 초기화)
+void integrateVelocitySystem(EntityWorld& world, ThreadPool& pool, double deltaTime);
+
+// Transform + Velocity + Mass: 속도 → 위치, 각속도 → 회전 (정적 물체 제외)
+void integratePositionSystem(EntityWorld& world, ThreadPool& pool, double deltaTime);
+
+// Transform + Velocity + Mass + Shape + Collider: 경계 구가 바닥 아래로 내려가면 바닥 위로 올리고 반발 계수로 튕긴다 (정적 물체 제외)
+void groundCollisionSystem(EntityWorld& world, ThreadPool& pool, double groundHeight);
+
+// 위 시스템을 한 스텝 순서대로 실행
+void stepRigidBodySystems(EntityWorld& world, ThreadPool& pool, double deltaTime, const Vector3<double>& gravity, double groundHeight);
+
+#endif // ENTITYSYSTEMS_H
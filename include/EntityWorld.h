@@ -0,0 +1,245 @@
+﻿#ifndef ENTITYWORLD_H
+#define ENTITYWORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "Matrix3x3.h"
+#include "CollisionShape.h"
+#include "HandlePool.h"
+#include "ThreadPool.h"
+
+// 엔티티 핸들 (제거된 엔티티의 핸들은 번호가 재사용되어도 오래된 핸들로 판별됨)
+typedef GenerationalHandle Entity;
+
+// 구성 요소
+struct Transform {
+    Vector3<double> position;
+    Quaternion<double> orientation;
+    Vector3<double> scale;
+};
+
+struct Velocity {
+    Vector3<double> linear;
+    Vector3<double> angular;
+};
+
+// 질량 특성 (정적 물체는 inverseMass 0, 역관성 0 행렬)
+struct Mass {
+    double mass;
+    double inverseMass;
+    Matrix3x3<double> inverseInertiaLocal;
+    Matrix3x3<double> inverseInertiaWorld;  // R I⁻¹ Rᵀ 캐시
+};
+
+// 스텝 동안 누적되는 외력과 토크 (적분 후 0 으로 초기화)
+struct ForceAccumulator {
+    Vector3<double> force;
+    Vector3<double> torque;
+};
+
+// 공유 충돌 형상 (nullptr 이면 Transform::scale 기반 근사)과 경계 구 반지름
+struct Shape {
+    std::shared_ptr<const CollisionShape> shape;
+    double boundingRadius;
+};
+
+struct Collider {
+    double restitution;
+    double friction;
+    std::uint32_t layer;
+};
+
+// 구성 요소 종류와 조합 마스크 (같은 마스크의 엔티티가 하나의 원형(archetype)을 이룬다)
+enum class ComponentType {
+    Transform,
+    Velocity,
+    Mass,
+    Force,
+    Shape,
+    Collider,
+    Count
+};
+
+typedef std::uint32_t ComponentMask;
+
+inline ComponentMask componentBit(ComponentType type) { return 1u << static_cast<std::uint32_t>(type); }
+
+template<typename T> struct ComponentTraits;
+template<> struct ComponentTraits<Transform> { static const ComponentType type = ComponentType::Transform; };
+template<> struct ComponentTraits<Velocity> { static const ComponentType type = ComponentType::Velocity; };
+template<> struct ComponentTraits<Mass> { static const ComponentType type = ComponentType::Mass; };
+template<> struct ComponentTraits<ForceAccumulator> { static const ComponentType type = ComponentType::Force; };
+template<> struct ComponentTraits<Shape> { static const ComponentType type = ComponentType::Shape; };
+template<> struct ComponentTraits<Collider> { static const ComponentType type = ComponentType::Collider; };
+
+template<typename T>
+ComponentMask componentBit() { return componentBit(ComponentTraits<T>::type); }
+
+// 한 원형의 엔티티를 최대 CAPACITY 개 담는 청크
+// 구성 요소마다 따로 연속 배열(SoA)을 두고 생성 시 용량을 모두 잡아 두므로, 청크 안에서는 재할당이 없고
+// 행 i 의 구성 요소들은 모두 같은 엔티티 getEntities()[i] 의 것이다. 원형에 없는 구성 요소의 배열은 비어 있다.
+class EntityChunk {
+public:
+    static constexpr std::size_t CAPACITY = 128;
+
+    explicit EntityChunk(ComponentMask mask);
+
+    ComponentMask getMask() const { return mask; }
+    std::size_t size() const { return entities.size(); }
+    bool isFull() const { return entities.size() == CAPACITY; }
+    const Entity* getEntities() const { return entities.data(); }
+
+    template<typename T> bool has() const { return (mask & componentBit<T>()) != 0; }
+    // 구성 요소 배열의 시작 (원형에 없으면 nullptr)
+    template<typename T> T* get() { return has<T>() ? column<T>().data() : nullptr; }
+    template<typename T> const T* get() const { return has<T>() ? const_cast<EntityChunk*>(this)->column<T>().data() : nullptr; }
+
+private:
+    friend class EntityWorld;
+
+    ComponentMask mask;
+    std::vector<Entity> entities;
+    std::vector<Transform> transforms;
+    std::vector<Velocity> velocities;
+    std::vector<Mass> masses;
+    std::vector<ForceAccumulator> forces;
+    std::vector<Shape> shapes;
+    std::vector<Collider> colliders;
+
+    template<typename T> std::vector<T>& column();
+
+    // 원형에 있는 구성 요소 배열마다 f(배열) 호출
+    template<typename F> void forEachColumn(F f) {
+        if (has<Transform>()) f(transforms);
+        if (has<Velocity>()) f(velocities);
+        if (has<Mass>()) f(masses);
+        if (has<ForceAccumulator>()) f(forces);
+        if (has<Shape>()) f(shapes);
+        if (has<Collider>()) f(colliders);
+    }
+
+    std::size_t pushRow(Entity entity);     // 기본값으로 채운 행 추가
+    void moveRow(EntityChunk& from, std::size_t fromRow, std::size_t toRow);    // 같은 원형의 행 이동
+    void copyShared(const EntityChunk& from, std::size_t fromRow, std::size_t toRow);  // 두 원형에 모두 있는 구성 요소 복사
+    void popRow();
+};
+
+template<> inline std::vector<Transform>& EntityChunk::column<Transform>() { return transforms; }
+template<> inline std::vector<Velocity>& EntityChunk::column<Velocity>() { return velocities; }
+template<> inline std::vector<Mass>& EntityChunk::column<Mass>() { return masses; }
+template<> inline std::vector<ForceAccumulator>& EntityChunk::column<ForceAccumulator>() { return forces; }
+template<> inline std::vector<Shape>& EntityChunk::column<Shape>() { return shapes; }
+template<> inline std::vector<Collider>& EntityChunk::column<Collider>() { return colliders; }
+
+// 원형 청크 기반 엔티티 저장소
+// 엔티티는 구성 요소 조합(원형)별 청크에 빈틈 없이 놓이며, 제거는 원형의 마지막 엔티티를 빈자리로 옮긴다.
+// 구성 요소를 더하거나 빼면 엔티티가 다른 원형으로 옮겨지므로 그 전에 얻은 구성 요소 포인터는 무효가 된다.
+// 비워진 청크는 해제하지 않고 재사용하므로 한 번 도달한 규모 안에서는 생성/제거에 할당이 없다.
+// 엔티티 핸들은 HandlePool 이 발급하며, 엔티티의 청크 위치는 그 슬롯 순서의 밀집 배열에 둔다.
+class EntityWorld {
+public:
+    EntityWorld();
+
+    EntityWorld(const EntityWorld&) = delete;
+    EntityWorld& operator=(const EntityWorld&) = delete;
+
+    // mask 의 구성 요소를 기본값으로 가진 엔티티 생성
+    Entity create(ComponentMask mask);
+    bool destroy(Entity entity);    // 오래된 핸들이면 false
+    bool isValid(Entity entity) const { return handles.isValid(entity); }
+    std::size_t size() const { return handles.size(); }
+    ComponentMask getMask(Entity entity) const;     // 오래된 핸들이면 0
+
+    // 오래된 핸들이거나 구성 요소가 없으면 nullptr
+    template<typename T> T* find(Entity entity);
+    // 오래된 핸들이거나 구성 요소가 없으면 std::invalid_argument
+    template<typename T> T& get(Entity entity);
+
+    // 구성 요소 추가(이미 있으면 값만 바꿈) / 제거 (오래된 핸들이면 std::invalid_argument)
+    template<typename T> T& add(Entity entity, const T& value);
+    template<typename T> void remove(Entity entity);
+
+    // required 구성 요소를 모두 가진 비어 있지 않은 청크 목록
+    void getChunks(ComponentMask required, std::vector<EntityChunk*>& out);
+
+    // required 구성 요소를 모두 가진 청크마다 task(청크) 를 스레드 풀에서 병렬 실행 (청크 하나는 한 스레드가 처리)
+    void forEachChunk(ComponentMask required, ThreadPool& pool, const std::function<void(EntityChunk&)>& task);
+
+    void clear();
+
+private:
+    struct Archetype {
+        ComponentMask mask;
+        std::vector<std::unique_ptr<EntityChunk>> chunks;
+        std::size_t activeChunks;       // [0, activeChunks) 청크에 엔티티가 있고 마지막 청크만 덜 찰 수 있음
+    };
+
+    // 엔티티가 놓인 청크 위치
+    struct Record {
+        std::uint32_t archetype;
+        std::uint32_t chunk;
+        std::uint32_t row;
+    };
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    HandlePool handles;
+    std::vector<Record> records;            // 핸들 슬롯 순서
+    std::vector<EntityChunk*> chunkScratch;
+
+    std::uint32_t findArchetype(ComponentMask mask);
+    EntityChunk& allocateRow(std::uint32_t archetype, Entity entity, Record& record);
+    void releaseRow(const Record& record);
+    const Record& requireRecord(Entity entity) const;
+    Record& recordOf(Entity entity) { return records[handles.getSlot(entity)]; }
+    EntityChunk& chunkOf(const Record& record) { return *archetypes[record.archetype]->chunks[record.chunk]; }
+    void changeMask(Entity entity, ComponentMask mask);
+};
+
+template<typename T>
+T* EntityWorld::find(Entity entity) {
+    if (!isValid(entity)) {
+        return nullptr;
+    }
+    const Record& record = recordOf(entity);
+    EntityChunk& chunk = chunkOf(record);
+    return chunk.has<T>() ? &chunk.column<T>()[record.row] : nullptr;
+}
+
+template<typename T>
+T& EntityWorld::get(Entity entity) {
+    T* component = find<T>(entity);
+    if (!component) {
+        throw std::invalid_argument("EntityWorld::get stale entity or missing component");
+    }
+    return *component;
+}
+
+template<typename T>
+T& EntityWorld::add(Entity entity, const T& value) {
+    const Record& record = requireRecord(entity);
+    ComponentMask mask = archetypes[record.archetype]->mask;
+    if ((mask & componentBit<T>()) == 0) {
+        changeMask(entity, mask | componentBit<T>());
+    }
+    const Record& current = recordOf(entity);
+    T& component = chunkOf(current).column<T>()[current.row];
+    component = value;
+    return component;
+}
+
+template<typename T>
+void EntityWorld::remove(Entity entity) {
+    const Record& record = requireRecord(entity);
+    ComponentMask mask = archetypes[record.archetype]->mask;
+    if ((mask & componentBit<T>()) != 0) {
+        changeMask(entity, mask & ~componentBit<T>());
+    }
+}
+
+#endif // ENTITYWORLD_H
@@ -0,0 +1,86 @@
+﻿#ifndef EXPLOSION_H
+#define EXPLOSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Vector3.h"
+#include "PhysicsObject.h"
+#include "HeightField.h"
+#include "TriangleMesh.h"
+#include "ThreadPool.h"
+
+// 방사형 폭발 하나
+// 물체가 받는 충격량 크기는 impulse * (1 - d / radius)^falloffExponent (d: 폭심에서 물체 표면의 가장 가까운 점까지 거리)
+struct Explosion {
+    Vector3<double> center;
+    double radius;
+    double impulse;             // 폭심에서의 충격량 크기 (N·s)
+    double falloffExponent;     // 0 이면 반경 안에서 일정, 1 이면 선형 감쇠
+};
+
+// 폭발이 물체 하나에 준 충격량 (적용 전 중간 결과)
+struct ExplosionHit {
+    std::size_t body;
+    Vector3<double> linearImpulse;
+    Vector3<double> angularImpulse;     // 질량 중심 기준 (작용점 × 충격량)
+};
+
+// 대기 중인 폭발을 한 번에 처리하는 방사형 충격량 시스템
+// 1. 물체 중심을 균일 격자(해시 버킷)에 계수 정렬로 한 번 넣는다.
+// 2. 폭발마다 반경 + 최대 물체 반지름을 덮는 칸만 훑어 후보를 찾고, 작용점/감쇠/가림을 계산한다 (폭발 단위 병렬).
+// 3. 물체별로 충격량을 합쳐 물체마다 한 번씩 적용한다 (폭발 순서에 관계없이 결정적).
+// 작용점은 상자 형상(또는 형상 없는 비균일 scale 물체)은 회전된 상자 위, 그 외에는 경계 구 위의 폭심에 가장 가까운 점이며,
+// 작용점이 질량 중심을 벗어나면 월드 역관성 텐서로 각충격량이 반영된다.
+class ExplosionSystem {
+public:
+    ExplosionSystem();
+
+    // 격자 칸 크기 (0 이면 대기 중인 폭발 반경의 평균과 최대 물체 지름 중 큰 값)
+    double cellSize;
+
+    // 폭심 → 작용점 선분이 지형이나 가림 메시에 막히면 충격량을 주지 않는다
+    bool occlusion;
+
+    // 가림 메시 (origin 기준 좌표, nullptr 이면 지형만 검사)
+    void setOccluder(std::shared_ptr<const TriangleMesh> mesh, const Vector3<double>& origin = Vector3<double>());
+
+    // 다음 apply 에서 처리할 폭발 추가 (반경이 양수가 아니면 std::invalid_argument)
+    void queue(const Explosion& explosion);
+    std::size_t getPendingCount() const { return pending.size(); }
+    void clear() { pending.clear(); }
+
+    // 대기 중인 폭발을 모두 적용하고 비운다. 충격량을 받은 물체 수를 돌려줌
+    // 정적 물체는 제외되고 충격량을 받은 물체는 깨어난다. 스레드 풀의 parallelFor 안에서 호출하면 안 된다.
+    std::size_t apply(std::vector<PhysicsObject>& bodies, const HeightField* terrain, ThreadPool& threadPool);
+
+    // 마지막 apply 에서 폭발마다 계산된 충격량 (폭발 순서, 폭발 안에서는 물체 순서)
+    const std::vector<std::vector<ExplosionHit>>& getLastHits() const { return hits; }
+
+private:
+    std::vector<Explosion> pending;
+    std::shared_ptr<const TriangleMesh> occluder;
+    Vector3<double> occluderOrigin;
+
+    // 격자 (스텝마다 재사용)
+    double gridCellSize;
+    double maxBodyRadius;
+    std::vector<std::uint32_t> bucketStart;     // 버킷 수 + 1
+    std::vector<std::size_t> bucketBodies;
+    std::vector<std::uint32_t> bodyBucket;
+
+    std::vector<std::vector<ExplosionHit>> hits;
+    std::vector<std::vector<std::uint32_t>> visitedBuckets;
+    std::vector<Vector3<double>> linearSum;
+    std::vector<Vector3<double>> angularSum;
+    std::vector<std::size_t> touched;
+    std::vector<unsigned char> touchedFlags;
+
+    void buildGrid(const std::vector<PhysicsObject>& bodies);
+    std::uint32_t bucketOf(long long x, long long y, long long z) const;
+    void gather(std::size_t index, const std::vector<PhysicsObject>& bodies, const HeightField* terrain);
+    bool isOccluded(const Vector3<double>& from, const Vector3<double>& to, const HeightField* terrain) const;
+};
+
+#endif // EXPLOSION_H
@@ -0,0 +1,56 @@
+﻿#ifndef FIXEDSTEPSCHEDULER_H
+#define FIXEDSTEPSCHEDULER_H
+
+#include <functional>
+#include "Vector3.h"
+#include "Quaternion.h"
+
+// 고정 물리 주기 스케줄러
+// 프레임 시간을 누적해 고정 dt 단위로만 물리를 진행하고, 남은 시간 비율(alpha)로 표시용 보간을 제공한다.
+class FixedStepScheduler {
+public:
+    // stepRate: 초당 물리 스텝 수, substeps: 스텝당 하위 스텝 수,
+    // maxStepsPerFrame: 한 프레임에 허용하는 최대 스텝 수 (죽음의 나선 방지)
+    FixedStepScheduler(double stepRate = 60.0, int substeps = 1, int maxStepsPerFrame = 5);
+
+    // 프레임 시간을 누적하고 필요한 만큼 step(substepDeltaTime)을 호출. 실행한 물리 스텝 수를 반환
+    int advance(double frameTime, const std::function<void(double)>& step);
+    // 고정 스텝마다 하위 스텝 전에 beginStep() 을 한 번 호출 (보간용 이전 상태를 스텝 단위로 저장할 때 사용)
+    int advance(double frameTime, const std::function<void()>& beginStep, const std::function<void(double)>& step);
+
+    // 보간 비율: 마지막 스텝 이후 누적 시간 / 고정 dt (0 ~ 1)
+    double getAlpha() const { return accumulator / fixedDeltaTime; }
+
+    double getFixedDeltaTime() const { return fixedDeltaTime; }
+    double getSubstepDeltaTime() const { return fixedDeltaTime / substeps; }
+    void setStepRate(double stepRate);
+
+    int getSubsteps() const { return substeps; }
+    void setSubsteps(int s) { substeps = s > 0 ? s : 1; }
+
+    int getMaxStepsPerFrame() const { return maxStepsPerFrame; }
+    void setMaxStepsPerFrame(int m) { maxStepsPerFrame = m > 0 ? m : 1; }
+
+    // 최대 스텝 제한으로 버려진 누적 시간 (진단용)
+    double getDroppedTime() const { return droppedTime; }
+
+    void reset() { accumulator = 0.0; droppedTime = 0.0; }
+
+    // 표시용 보간: previous 와 current 사이를 alpha 로 선형 보간
+    template<typename T, typename S>
+    static T interpolate(const T& previous, const T& current, S alpha) {
+        return previous + (current - previous) * alpha;
+    }
+
+    // 회전 보간 (정규화된 선형 보간, 최단 경로)
+    static Quaternion<double> interpolate(const Quaternion<double>& previous, const Quaternion<double>& current, double alpha);
+
+private:
+    double fixedDeltaTime;
+    int substeps;
+    int maxStepsPerFrame;
+    double accumulator;
+    double droppedTime;
+};
+
+#endif // FIXEDSTEPSCHEDULER_H
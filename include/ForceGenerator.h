@@ -0,0 +1,129 @@
+﻿#ifndef FORCEGENERATOR_H
+#define FORCEGENERATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Vector3.h"
+
+class PhysicsObject;
+
+// 힘 계산 대상 물체들의 SoA 뷰 (각 배열은 count 개)
+struct ForceBatch {
+    std::size_t count;
+    const Vector3<double>* positions;
+    const Vector3<double>* velocities;
+    const double* masses;
+    Vector3<double>* forces;    // 누적 출력
+};
+
+// 전역 힘 장 (모든 대상 물체에 같은 규칙으로 작용)
+// 물체 하나마다 가상 호출을 하지 않고, 장 하나가 배치 전체를 한 번의 루프로 처리한다.
+class ForceField {
+public:
+    virtual ~ForceField() = default;
+    virtual void accumulate(const ForceBatch& batch) const = 0;
+
+    // 위치/속도/질량과 무관한 균일 가속도장이면 그 가속도를 돌려준다 (해석적 궤적 예측용)
+    virtual bool getUniformAcceleration(Vector3<double>&) const { return false; }
+};
+
+// 균일 중력장: F = m g
+class GravityField : public ForceField {
+public:
+    explicit GravityField(const Vector3<double>& gravity);
+
+    const Vector3<double>& getGravity() const { return gravity; }
+    void setGravity(const Vector3<double>& g) { gravity = g; }
+
+    void accumulate(const ForceBatch& batch) const override;
+    bool getUniformAcceleration(Vector3<double>& acceleration) const override { acceleration = gravity; return true; }
+
+private:
+    Vector3<double> gravity;
+};
+
+// 공기 저항: F = -(k1 + k2 |v_rel|) v_rel, v_rel = v - 공기 속도
+class DragField : public ForceField {
+public:
+    DragField(double linear, double quadratic);
+
+    double linear;      // k1 (N·s/m)
+    double quadratic;   // k2 (N·s²/m²)
+
+    void accumulate(const ForceBatch& batch) const override;
+
+protected:
+    Vector3<double> airVelocity;
+};
+
+// 바람: 바람 속도로 움직이는 공기에 대한 저항
+class WindField : public DragField {
+public:
+    WindField(const Vector3<double>& windVelocity, double linear, double quadratic);
+
+    const Vector3<double>& getWindVelocity() const { return airVelocity; }
+    void setWindVelocity(const Vector3<double>& wind) { airVelocity = wind; }
+};
+
+// 두 물체 사이의 스프링/댐퍼 (stiffness 0 이면 순수 댐퍼)
+// 물체 인덱스는 ForceRegistry::apply 에 넘기는 물체 배열 기준이다.
+struct SpringForce {
+    std::size_t bodyA;
+    std::size_t bodyB;
+    double restLength;
+    double stiffness;   // k (N/m)
+    double damping;     // c (N·s/m), 축 방향 상대 속도에 작용
+};
+
+// 힘 생성기 등록부
+// 전역 장과 쌍 스프링을 한 번 등록해 두면, 적분 직전에 깨어 있는 동적 물체를 SoA 버퍼로 모아
+// 장마다 한 번의 일괄 루프로 힘을 계산한 뒤 물체에 한 번씩 되돌려 쓴다.
+class ForceRegistry {
+public:
+    std::size_t addField(std::shared_ptr<ForceField> field);
+    void removeField(const std::shared_ptr<ForceField>& field);
+    const std::vector<std::shared_ptr<ForceField>>& getFields() const { return fields; }
+
+    std::size_t addSpring(const SpringForce& spring);
+    SpringForce& getSpring(std::size_t index) { return springs[index]; }
+    std::size_t getSpringCount() const { return springs.size(); }
+    const std::vector<SpringForce>& getSprings() const { return springs; }
+
+    // 물체 배열의 순서가 바뀌었을 때 스프링의 물체 인덱스를 새 위치로 옮긴다 (newIndexOf[이전 인덱스] = 새 인덱스)
+    void remapBodies(const std::vector<std::size_t>& newIndexOf);
+
+    // 물체 index 가 제거되고 movedFrom 의 물체가 그 자리로 옮겨졌을 때: index 에 걸린 스프링을 지우고 movedFrom 을 index 로 바꾼다
+    void removeBody(std::size_t index, std::size_t movedFrom);
+
+    void clear();
+
+    // 스프링이 없고 모든 힘장이 균일 가속도장이면 합 가속도를 돌려준다 (탄도 운동 판정)
+    bool getUniformAcceleration(Vector3<double>& acceleration) const;
+
+    // bodies[0 .. count) 중 깨어 있는 동적 물체에 등록된 모든 힘을 누적
+    void apply(PhysicsObject* bodies, std::size_t count);
+
+    // bodies[index] 가 위치 position, 속도 velocity 에 있을 때 등록된 힘이 주는 가속도 (다른 물체는 현재 상태)
+    // 적분기에 넘기는 상태 의존 가속도 함수 a(x, v, t) 를 만들 때 사용한다.
+    Vector3<double> evaluateAcceleration(const PhysicsObject* bodies, std::size_t index,
+        const Vector3<double>& position, const Vector3<double>& velocity) const;
+
+private:
+    std::vector<std::shared_ptr<ForceField>> fields;
+    std::vector<SpringForce> springs;
+
+    // 스텝마다 재사용하는 SoA 버퍼
+    std::vector<std::size_t> bodyIndices;
+    std::vector<std::size_t> slotOfBody;    // 물체 인덱스 → 버퍼 위치 (대상이 아니면 NO_SLOT)
+    std::vector<Vector3<double>> positions;
+    std::vector<Vector3<double>> velocities;
+    std::vector<double> masses;
+    std::vector<Vector3<double>> forces;
+
+    static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+    void accumulateSprings(const PhysicsObject* bodies);
+};
+
+#endif // FORCEGENERATOR_H
@@ -0,0 +1,97 @@
+﻿#ifndef FRAMEBUDGET_H
+#define FRAMEBUDGET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Vector3.h"
+
+// 스텝 단계 (시간 측정 단위)
+enum class StepPhase {
+    Reorder,        // 모턴 순서 재배치 (reorderInterval 스텝마다)
+    Commands,       // 명령 큐, 폭발
+    Forces,         // 관성 갱신, 힘 생성기
+    Contacts,       // 접촉 생성
+    Islands,        // 섬 구성, 부분 스텝 선택
+    Solve,          // 섬 풀이, 적분, 수면 판정
+    SoftBodies,     // 연성체
+    Events,         // 접촉 이벤트, 상태 발행
+    Count
+};
+
+const char* getStepPhaseName(StepPhase phase);
+
+// 저하 단계 (앞 단계를 포함하며 우선순위 순서로 누적)
+enum class DegradationLevel {
+    None,
+    ReducedIterations,      // 솔버 속도 반복 횟수 절반 (minVelocityIterations 이상)
+    CoarseDistantBodies,    // 반복 횟수 최소 + 초점에서 먼 섬은 부분 스텝 없이 한 번에 진행
+    DeferredSleep           // + 수면 판정을 sleepCheckInterval 스텝마다 몰아서 수행
+};
+
+const char* getDegradationLevelName(DegradationLevel level);
+
+// 스텝 시간 예산 설정
+struct FrameBudget {
+    double budget;                              // 스텝당 허용 시간 (s), 0 이면 저하하지 않음
+    int minVelocityIterations;                  // 반복 횟수 하한
+    std::vector<Vector3<double>> focusPoints;   // 카메라/플레이어 위치 (비어 있으면 모든 섬이 먼 섬)
+    double farDistance;                         // 초점에서 이보다 먼 섬이 먼 섬
+    unsigned sleepCheckInterval;                // 수면 판정 지연 시 판정 간격 (스텝)
+    double recoverFraction;                     // 스텝 시간이 budget * recoverFraction 아래로
+    unsigned recoverSteps;                      // 이만큼 연속되면 한 단계 회복
+
+    FrameBudget()
+        : budget(0.0), minVelocityIterations(2), farDistance(50.0), sleepCheckInterval(4),
+        recoverFraction(0.6), recoverSteps(30) {}
+};
+
+// 한 스텝의 측정값과 저하 결과
+struct StepReport {
+    std::uint64_t frame;
+    double phaseTimes[static_cast<std::size_t>(StepPhase::Count)];     // 단계별 시간 (s)
+    double total;
+    double budget;
+    StepPhase slowestPhase;
+    DegradationLevel level;         // 이번 스텝에 적용된 단계
+    DegradationLevel nextLevel;     // 측정 결과로 정한 다음 스텝 단계
+    int velocityIterations;         // 이번 스텝에 사용한 반복 횟수
+    std::size_t coarsenedIslands;   // 먼 섬이라 부분 스텝을 생략한 섬 수
+    bool sleepCheckDeferred;        // 이번 스텝에 수면 판정을 건너뛰었는지
+    std::string reason;             // 단계가 바뀐 이유 (바뀌지 않았으면 빈 문자열)
+};
+
+// 측정된 스텝 시간으로 다음 스텝의 저하 단계를 정하는 제어기
+// 예산을 넘으면 즉시 한 단계 올리고, recoverFraction 아래로 recoverSteps 스텝 연속 유지되면 한 단계 내린다 (떨림 방지).
+class FrameBudgetController {
+public:
+    FrameBudgetController();
+
+    const FrameBudget& getBudget() const { return budget; }
+    void setBudget(const FrameBudget& b);
+
+    DegradationLevel getLevel() const { return level; }
+
+    // 이번 스텝에 적용할 값
+    int getVelocityIterations(int baseIterations) const;
+    bool coarsensDistantBodies() const { return level >= DegradationLevel::CoarseDistantBodies; }
+    bool defersSleep() const { return level >= DegradationLevel::DeferredSleep; }
+
+    // 수면 판정 지연 중이면 판정할 스텝에만 true 와 그동안 누적된 시간을 돌려준다
+    bool takeSleepCheck(double deltaTime, double& elapsed);
+
+    // report 의 측정값으로 다음 단계 결정 (slowestPhase, nextLevel, reason 을 채움)
+    void update(StepReport& report);
+
+    void reset();
+
+private:
+    FrameBudget budget;
+    DegradationLevel level;
+    unsigned underBudgetSteps;
+    unsigned sleepCheckCounter;
+    double sleepElapsed;
+};
+
+#endif // FRAMEBUDGET_H
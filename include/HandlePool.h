@@ -0,0 +1,109 @@
+﻿#ifndef HANDLEPOOL_H
+#define HANDLEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 세대 핸들: 핸들 번호(index)와 그 번호가 쓰인 횟수(generation)
+// 번호가 해제되면 세대가 올라가므로, 해제 전에 받은 핸들은 번호가 재사용되어도 오래된 핸들로 판별된다.
+// generation 0 은 어떤 객체도 가리키지 않는 null 핸들이다.
+struct GenerationalHandle {
+    std::uint32_t index;
+    std::uint32_t generation;
+
+    GenerationalHandle() : index(0), generation(0) {}
+    GenerationalHandle(std::uint32_t i, std::uint32_t g) : index(i), generation(g) {}
+
+    bool isNull() const { return generation == 0; }
+
+    bool operator==(const GenerationalHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const GenerationalHandle& other) const { return !(*this == other); }
+    bool operator<(const GenerationalHandle& other) const {
+        return index != other.index ? index < other.index : generation < other.generation;
+    }
+};
+
+// PhysicsWorld 물체 핸들
+typedef GenerationalHandle BodyHandle;
+
+// 세대 핸들 ↔ 밀집 배열 위치(슬롯) 대응표
+// 객체는 호출자가 가진 밀집 배열의 [0, size()) 에 빈틈 없이 놓이고, 생성은 끝에 추가, 제거는 마지막 원소를 빈자리로 옮긴다.
+// 해제된 핸들 번호는 표 안의 자유 목록으로 재사용하므로 생성/제거가 O(1) 이고, 용량을 넘지 않으면 할당이 없다.
+class HandlePool {
+public:
+    static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+    HandlePool();
+
+    // 밀집 배열 끝(슬롯 size())에 놓일 객체의 핸들 발급
+    GenerationalHandle create();
+
+    // 핸들을 해제하고 비워진 슬롯을 돌려준다 (오래된 핸들이면 NO_SLOT).
+    // 호출자는 같은 슬롯에 마지막 원소를 옮겨 밀집 배열을 맞춘다 (swapRemove).
+    std::size_t destroy(GenerationalHandle handle);
+
+    bool isValid(GenerationalHandle handle) const {
+        return handle.generation != 0 && handle.index < entries.size() && entries[handle.index].generation == handle.generation;
+    }
+    // 오래된 핸들이면 NO_SLOT
+    std::size_t getSlot(GenerationalHandle handle) const { return isValid(handle) ? entries[handle.index].slot : NO_SLOT; }
+    GenerationalHandle getHandle(std::size_t slot) const { return handleOfSlot[slot]; }
+    const std::vector<GenerationalHandle>& getHandles() const { return handleOfSlot; }    // 슬롯 → 핸들
+
+    // 살아 있는 객체 수와 지금까지 쓰인 핸들 번호 수
+    std::size_t size() const { return handleOfSlot.size(); }
+    std::size_t getIndexCount() const { return entries.size(); }
+    // 핸들 번호가 살아 있으면 그 핸들, 비어 있으면 null 핸들 (번호 순 순회용)
+    GenerationalHandle getHandleAtIndex(std::size_t index) const;
+
+    void reserve(std::size_t capacity);
+    void clear();
+
+    // order[새 슬롯] = 이전 슬롯 인 순열을 반영하고, 이전 슬롯 → 새 슬롯 표를 newSlotOf 에 채운다 (핸들은 그대로)
+    void permute(const std::vector<std::size_t>& order, std::vector<std::size_t>& newSlotOf);
+
+private:
+    static constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    struct Entry {
+        std::uint32_t slot;         // 살아 있으면 슬롯, 해제되었으면 다음 자유 번호
+        std::uint32_t generation;   // 살아 있는 핸들의 세대 (해제 시 증가)
+    };
+
+    std::vector<Entry> entries;
+    std::vector<GenerationalHandle> handleOfSlot;
+    std::uint32_t freeHead;
+};
+
+// 슬롯 → 핸들 표에 order[새 슬롯] = 이전 슬롯 인 순열을 제자리에서 반영하고, 이전 슬롯 → 새 슬롯 표를 newSlotOf 에 채운다
+// setSlot(핸들, 슬롯) 으로 핸들 쪽 표에 새 슬롯을 먼저 기록한 뒤, slotOf(핸들) 과 다른 자리의 핸들을 그 슬롯으로 맞바꾸어 보낸다
+// (맞바꿀 때마다 하나가 자리를 찾으므로 O(n), 추가 버퍼 없음). HandlePool 과 SlotRemap 이 함께 쓴다.
+template<typename Handle, typename SlotOf, typename SetSlot>
+void permuteHandleSlots(std::vector<Handle>& handleOfSlot, const std::vector<std::size_t>& order, std::vector<std::size_t>& newSlotOf,
+    SlotOf slotOf, SetSlot setSlot) {
+    newSlotOf.resize(order.size());
+    for (std::size_t slot = 0; slot < order.size(); ++slot) {
+        newSlotOf[order[slot]] = slot;
+    }
+    for (std::size_t slot = 0; slot < handleOfSlot.size(); ++slot) {
+        setSlot(handleOfSlot[slot], newSlotOf[slot]);
+    }
+    for (std::size_t slot = 0; slot < handleOfSlot.size(); ++slot) {
+        while (slotOf(handleOfSlot[slot]) != slot) {
+            std::swap(handleOfSlot[slot], handleOfSlot[slotOf(handleOfSlot[slot])]);
+        }
+    }
+}
+
+// 밀집 배열에서 slot 원소를 마지막 원소로 덮고 하나 줄인다 (HandlePool::destroy 와 짝)
+template<typename T>
+void swapRemove(std::vector<T>& items, std::size_t slot) {
+    if (slot + 1 != items.size()) {
+        items[slot] = std::move(items.back());
+    }
+    items.pop_back();
+}
+
+#endif // HANDLEPOOL_H
@@ -0,0 +1,108 @@
+﻿#ifndef HEIGHTFIELD_H
+#define HEIGHTFIELD_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Vector3.h"
+
+// 높이 필드 레이 질의
+struct HeightFieldRay {
+    Vector3<double> origin;
+    Vector3<double> direction;  // 단위 벡터
+    double maxDistance;
+};
+
+// 높이 필드 레이 질의 결과
+struct HeightFieldHit {
+    bool hit;
+    double distance;
+    Vector3<double> point;
+    Vector3<double> normal;
+};
+
+// 정규 격자 높이 필드 지형 충돌체
+// 격자점 (column, row) 의 월드 좌표는 origin + (column * cellSize, height * heightScale, row * cellSize) 이다.
+// 높이 배열은 직접 소유하거나 메모리 매핑된 파일을 그대로 가리킬 수 있으며, 모든 질의는 힙 할당을 하지 않는다.
+class HeightField {
+public:
+    // 원시 파일 형식
+    enum class RawFormat {
+        Float32,    // 리틀 엔디언 32비트 실수
+        UInt16      // 리틀 엔디언 16비트 정수 (0 ~ 65535 → 0 ~ 1 로 정규화)
+    };
+
+    // 메모리의 높이 배열을 복사하여 생성 (행 우선, columns * rows 개)
+    HeightField(std::size_t columns, std::size_t rows, const std::vector<float>& heights,
+        double cellSize = 1.0, double heightScale = 1.0, const Vector3<double>& origin = Vector3<double>());
+    ~HeightField();
+
+    HeightField(const HeightField&) = delete;
+    HeightField& operator=(const HeightField&) = delete;
+
+    // 원시 파일을 읽어 생성
+    static std::shared_ptr<HeightField> loadRaw(const std::string& path, std::size_t columns, std::size_t rows,
+        RawFormat format, double cellSize = 1.0, double heightScale = 1.0, const Vector3<double>& origin = Vector3<double>());
+
+    // Float32 원시 파일을 메모리 매핑하여 생성 (복사 없음, 4k x 4k 지형도 즉시 사용 가능)
+    static std::shared_ptr<HeightField> mapRaw(const std::string& path, std::size_t columns, std::size_t rows,
+        double cellSize = 1.0, double heightScale = 1.0, const Vector3<double>& origin = Vector3<double>());
+
+    std::size_t getColumns() const { return columns; }
+    std::size_t getRows() const { return rows; }
+    double getCellSize() const { return cellSize; }
+    double getHeightScale() const { return heightScale; }
+    Vector3<double> getOrigin() const { return origin; }
+
+    // 격자점 높이 (월드 단위)
+    double getSample(std::size_t column, std::size_t row) const { return origin.y + heights[row * columns + column] * heightScale; }
+
+    // (x, z) 가 격자 범위 안에 있는지
+    bool contains(double x, double z) const;
+
+    // 쌍선형 보간 높이 (범위 밖은 가장자리 값으로 고정)
+    double getHeight(double x, double z) const;
+
+    // 쌍선형 보간 면의 단위 법선
+    Vector3<double> getNormal(double x, double z) const;
+
+    // 높이와 법선을 함께 계산 (셀 조회를 한 번만 수행)
+    double getHeightAndNormal(double x, double z, Vector3<double>& normal) const;
+
+    // 레이 질의 (높이 차의 부호 변화를 셀 크기 절반 간격으로 찾은 뒤 이분법으로 정밀화)
+    bool raycast(const HeightFieldRay& ray, HeightFieldHit& hit) const;
+
+    // 일괄 질의: 출력 배열은 호출자가 count 개 이상 준비한다
+    void getHeights(const Vector3<double>* points, std::size_t count, double* outHeights) const;
+    void getHeightsAndNormals(const Vector3<double>* points, std::size_t count, double* outHeights, Vector3<double>* outNormals) const;
+    std::size_t raycastBatch(const HeightFieldRay* rays, std::size_t count, HeightFieldHit* outHits) const;
+
+private:
+    HeightField(std::size_t columns, std::size_t rows, double cellSize, double heightScale, const Vector3<double>& origin);
+
+    std::size_t columns;
+    std::size_t rows;
+    double cellSize;
+    double inverseCellSize;
+    double heightScale;
+    Vector3<double> origin;
+
+    const float* heights;           // 소유 배열 또는 매핑된 파일을 가리킴
+    std::vector<float> ownedHeights;
+
+    // 메모리 매핑 핸들
+    void* mappedView;
+    std::size_t mappedSize;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    // 셀 좌표와 셀 내부 비율 계산
+    void locate(double x, double z, std::size_t& column, std::size_t& row, double& fx, double& fz) const;
+};
+
+#endif // HEIGHTFIELD_H
@@ -0,0 +1,82 @@
+﻿#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include <functional>
+#include <string>
+#include "Vector3.h"
+
+// 적분기가 다루는 병진 상태
+struct IntegrationState {
+    Vector3<double> position;
+    Vector3<double> velocity;
+    double stepHint;    // 적응형 적분기가 다음 호출에 사용할 권장 스텝 (0 이면 미정)
+};
+
+// 가속도 함수 a(x, v, t)
+typedef std::function<Vector3<double>(const Vector3<double>& position, const Vector3<double>& velocity, double time)> AccelerationFunction;
+
+// 적분기 인터페이스
+// 적분기는 상태를 갖지 않으므로 여러 물체와 스레드가 하나의 인스턴스를 공유할 수 있다.
+class Integrator {
+public:
+    virtual ~Integrator() {}
+
+    // [time, time + deltaTime] 구간을 적분하고 가속도 함수 호출 횟수를 반환
+    virtual int integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const = 0;
+
+    virtual std::string getName() const = 0;
+
+    // 등가속도 a 에서 스텝 h 로 n 번 적분한 결과의 닫힌 형태:
+    // x = x0 + (v0 + bias a h) t + ½ a t², v = v0 + a t (t = n h). 2차 이상 정확한 적분기는 0.
+    // 사건 예측과 해석적 건너뛰기가 스텝 진행과 같은 궤적을 따르게 하는 데 사용한다.
+    virtual double getBallisticBias() const { return 0.0; }
+};
+
+// 반암시적(심플렉틱) 오일러: v 를 먼저 갱신하고 새 v 로 x 를 갱신 (1차, 에너지 보존이 좋음)
+class SymplecticEulerIntegrator : public Integrator {
+public:
+    int integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const override;
+    std::string getName() const override { return "Symplectic Euler"; }
+    double getBallisticBias() const override { return 0.5; }
+};
+
+// 속도 베를레 (2차)
+class VelocityVerletIntegrator : public Integrator {
+public:
+    int integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const override;
+    std::string getName() const override { return "Velocity Verlet"; }
+};
+
+// 고전 4차 룽게-쿠타
+class RK4Integrator : public Integrator {
+public:
+    int integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const override;
+    std::string getName() const override { return "RK4"; }
+};
+
+// 도르만-프린스 RK45: 4/5차 내장 오차 추정으로 스텝 크기를 스스로 조절
+class AdaptiveRK45Integrator : public Integrator {
+public:
+    AdaptiveRK45Integrator(double absoluteTolerance = 1e-6, double relativeTolerance = 1e-6,
+        double minStep = 1e-6, double maxStep = 1.0);
+
+    // deltaTime 구간 전체를 필요한 만큼의 내부 스텝으로 적분 (state.stepHint 를 갱신)
+    int integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const override;
+    std::string getName() const override { return "Adaptive RK45"; }
+
+    // 스텝 하나를 시도: 오차가 허용치 이내가 될 때까지 줄여가며 진행한 실제 스텝을 반환하고
+    // nextStep 에 다음 권장 스텝을 기록한다. 가속도 함수 호출 횟수는 evaluations 에 누적된다.
+    double adaptiveStep(IntegrationState& state, const AccelerationFunction& acceleration, double time,
+        double trialStep, double& nextStep, int& evaluations) const;
+
+    double getAbsoluteTolerance() const { return absoluteTolerance; }
+    double getRelativeTolerance() const { return relativeTolerance; }
+
+private:
+    double absoluteTolerance;
+    double relativeTolerance;
+    double minStep;
+    double maxStep;
+};
+
+#endif // INTEGRATOR_H
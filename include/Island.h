@@ -0,0 +1,50 @@
+﻿#ifndef ISLAND_H
+#define ISLAND_H
+
+#include <cstddef>
+#include <vector>
+#include "Contact.h"
+#include "ForceGenerator.h"
+
+class PhysicsObject;
+
+// 접촉/제약 그래프로 연결된 동적 물체의 집합
+// 서로 다른 섬은 물체를 공유하지 않으므로 병렬로 풀 수 있다.
+struct Island {
+    std::vector<std::size_t> bodies;
+    std::vector<std::size_t> contacts;
+    std::vector<std::size_t> joints;
+    bool sleeping;
+    unsigned substepLevel;  // 다중 속도 적분 단계 (이 섬은 스텝당 2^substepLevel 번의 부분 스텝으로 진행)
+};
+
+// 경로 압축과 랭크 합치기를 사용하는 분리 집합
+class UnionFind {
+public:
+    void reset(std::size_t count);
+    std::size_t find(std::size_t i);
+    void unite(std::size_t a, std::size_t b);
+
+private:
+    std::vector<std::size_t> parent;
+    std::vector<unsigned char> rank;
+};
+
+// 매 스텝 접촉/제약/스프링 그래프로부터 섬을 구성
+class IslandBuilder {
+public:
+    // 섬에는 동적 물체만 포함된다. 정적 물체와의 접촉은 동적 물체 쪽 섬에 속한다.
+    // 스프링 양 끝도 한 섬으로 묶으므로, 한쪽이 깨어 있으면 잠든 반대쪽도 깨어나 함께 움직이고 함께 잠든다.
+    // 수면 중인 물체와 깨어 있는 물체가 한 섬에 묶이면 섬 전체를 깨운다.
+    void build(std::vector<PhysicsObject>& bodies,
+        const std::vector<Contact>& contacts,
+        const std::vector<DistanceJoint>& joints,
+        const std::vector<SpringForce>& springs,
+        std::vector<Island>& islands);
+
+private:
+    UnionFind sets;
+    std::vector<std::size_t> islandOfRoot;
+};
+
+#endif // ISLAND_H
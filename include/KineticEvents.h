@@ -0,0 +1,68 @@
+﻿#ifndef KINETICEVENTS_H
+#define KINETICEVENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "Vector3.h"
+
+// 등가속도 궤적 x(t) = position + velocity t + ½ acceleration t²
+// 적분기의 이산 궤적을 나타낼 때는 velocity 에 Integrator::getBallisticBias 보정을 넣는다.
+struct BallisticPath {
+    Vector3<double> position;
+    Vector3<double> velocity;
+    Vector3<double> acceleration;
+
+    Vector3<double> positionAt(double t) const { return position + velocity * t + acceleration * (0.5 * t * t); }
+    Vector3<double> velocityAt(double t) const { return velocity + acceleration * t; }
+
+    // y(t) <= height 가 처음 성립하는 t >= 0 (지금 이미 아래면 0, 도달하지 않으면 무한대)
+    double predictPlaneCrossing(double height) const;
+
+    // [0, horizon] 안에서 상자 안에 처음 들어가는 시각 (지금 안이면 0, 없으면 무한대)
+    double predictBoxEntry(const Vector3<double>& boxMin, const Vector3<double>& boxMax, double horizon) const;
+
+    // [0, horizon] 안에서 상자 밖으로 처음 나가는 시각 (지금 밖이면 0, 없으면 무한대)
+    double predictBoxExit(const Vector3<double>& boxMin, const Vector3<double>& boxMax, double horizon) const;
+};
+
+enum class KineticEventType {
+    GroundContact,  // 바닥(또는 지형 최고 높이) 도달
+    TargetEntry,    // 목표 상자 진입
+    BoundsExit      // 관심 영역 상자 이탈
+};
+
+struct KineticEvent {
+    double time;
+    std::size_t body;
+    KineticEventType type;
+    std::uint32_t version;  // 예약 당시 물체 버전 (무효화되면 꺼낼 때 버림)
+};
+
+// 물체별 예측 사건을 시각 순으로 꺼내는 운동 사건 큐
+// 물체의 궤적이 바뀌면 invalidate 로 버전을 올려 그 물체의 예약을 한꺼번에 무효화하고 다시 예측한다 (지연 삭제).
+class KineticEventQueue {
+public:
+    void schedule(std::size_t body, KineticEventType type, double time);
+    void invalidate(std::size_t body);
+
+    // 가장 이른 유효 사건 (없으면 nullptr)
+    const KineticEvent* peek();
+    bool pop(KineticEvent& out);
+
+    bool empty() { return peek() == nullptr; }
+    void clear();
+
+private:
+    struct Later {
+        bool operator()(const KineticEvent& a, const KineticEvent& b) const { return a.time > b.time; }
+    };
+
+    std::priority_queue<KineticEvent, std::vector<KineticEvent>, Later> events;
+    std::vector<std::uint32_t> versions;
+
+    bool isStale(const KineticEvent& event) const;
+};
+
+#endif // KINETICEVENTS_H
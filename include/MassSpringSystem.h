@@ -0,0 +1,100 @@
+﻿#ifndef MASSSPRINGSYSTEM_H
+#define MASSSPRINGSYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix3x3.h"
+
+// 질점-스프링 계 (천, 로프)
+// 질점은 속성(위치, 속도, 질량 등)마다 따로 연속 배열에 담고 (벡터 속성은 Vector3 원소 배열이며 x/y/z 를 나누지는 않는다), 스프링은 끝점 인덱스 순으로 정렬해 순회 시 메모리 접근을 지역화한다.
+// 스텝은 암시적 후방 오일러 (M - h ∂f/∂v - h² ∂f/∂x) Δv = h (f + h ∂f/∂x v) 를
+// 행렬을 만들지 않는 켤레 기울기법으로 풀며, 스프링마다 3x3 야코비안 블록만 보관한다.
+class MassSpringSystem {
+public:
+    struct Spring {
+        std::uint32_t a;
+        std::uint32_t b;
+        double restLength;
+        double stiffness;   // k (N/m)
+        double damping;     // c (N·s/m), 축 방향 상대 속도에 작용
+    };
+
+    MassSpringSystem();
+
+    // 질점 추가 (mass <= 0 이면 고정점)
+    std::size_t addParticle(const Vector3<double>& position, double mass);
+
+    // 스프링 추가 (restLength < 0 이면 현재 거리를 정지 길이로 사용)
+    // 스프링 배열은 다음 스텝에서 재정렬되므로 개별 스프링은 인덱스가 아닌 끝점 쌍으로 식별한다.
+    void addSpring(std::size_t a, std::size_t b, double stiffness, double damping, double restLength = -1.0);
+
+    // 격자 천 생성: origin 에서 uAxis, vAxis 방향으로 (columns x rows) 질점, 인장/전단/굽힘 스프링 연결
+    // 반환값은 첫 질점 인덱스 (질점 (c, r) 은 first + r * columns + c)
+    std::size_t addCloth(const Vector3<double>& origin, const Vector3<double>& uAxis, const Vector3<double>& vAxis,
+        std::size_t columns, std::size_t rows, double totalMass,
+        double stretchStiffness, double shearStiffness, double bendStiffness, double damping);
+
+    // 로프 생성: start 에서 end 까지 segments 개 구간
+    std::size_t addRope(const Vector3<double>& start, const Vector3<double>& end, std::size_t segments,
+        double totalMass, double stiffness, double damping);
+
+    // 질점 고정/해제
+    void setPinned(std::size_t index, bool pinned);
+    bool isPinned(std::size_t index) const { return inverseMasses[index] == 0.0; }
+
+    std::size_t getParticleCount() const { return positions.size(); }
+    const std::vector<Vector3<double>>& getPositions() const { return positions; }
+    const std::vector<Vector3<double>>& getVelocities() const { return velocities; }
+    void setPosition(std::size_t index, const Vector3<double>& p) { positions[index] = p; }
+    void setVelocity(std::size_t index, const Vector3<double>& v) { velocities[index] = v; }
+
+    std::size_t getSpringCount() const { return springs.size(); }
+    const std::vector<Spring>& getSprings() const { return springs; }
+
+    // 다음 스텝에만 적용되는 외력
+    void applyForce(std::size_t index, const Vector3<double>& force) { externalForces[index] += force; }
+
+    Vector3<double> gravity;
+    std::size_t maxIterations;      // 켤레 기울기법 최대 반복 수
+    double tolerance;               // 상대 잔차 허용치
+
+    // 암시적 스텝
+    void step(double deltaTime);
+
+    // 마지막 스텝의 켤레 기울기법 반복 수
+    std::size_t getLastIterationCount() const { return lastIterationCount; }
+
+private:
+    // 질점 (속성별 배열)
+    std::vector<Vector3<double>> positions;
+    std::vector<Vector3<double>> velocities;
+    std::vector<Vector3<double>> externalForces;
+    std::vector<double> masses;
+    std::vector<double> inverseMasses;      // 고정점은 0
+    std::vector<double> restMasses;         // 고정 해제 시 되돌릴 질량
+
+    std::vector<Spring> springs;
+    bool springsSorted;
+
+    // 스텝 작업 버퍼 (재사용)
+    std::vector<Vector3<double>> forces;
+    std::vector<Matrix3x3<double>> stiffnessBlocks;    // J = h² K + h C = -(h² ∂f_a/∂x_a + h ∂f_a/∂v_a)
+    std::vector<Vector3<double>> rhs;
+    std::vector<Vector3<double>> deltaVelocity;
+    std::vector<Vector3<double>> residual;
+    std::vector<Vector3<double>> direction;
+    std::vector<Vector3<double>> product;
+    std::vector<Vector3<double>> preconditioned;
+    std::vector<double> preconditioner;
+    std::size_t lastIterationCount;
+
+    void sortSprings();
+    void computeForcesAndJacobians(double deltaTime);
+    void multiply(const std::vector<Vector3<double>>& x, std::vector<Vector3<double>>& out) const;
+    void filter(std::vector<Vector3<double>>& v) const;
+    void solve();
+};
+
+#endif // MASSSPRINGSYSTEM_H
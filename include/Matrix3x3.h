@@ -28,6 +28,12 @@ public:
     // 단위 행렬 생성
     static Matrix3x3 identity();
 
+    // 외적 행렬 u vᵀ
+    static Matrix3x3 outerProduct(const Vector3<T>& u, const Vector3<T>& v);
+
+    // 벡터 외적의 행렬 표현 [v]× (skew(v) * u == v ^ u)
+    static Matrix3x3 skew(const Vector3<T>& v);
+
     // 행렬 대각합 (Trace)
     T trace() const;
 
@@ -0,0 +1,63 @@
+﻿#ifndef MORTONORDER_H
+#define MORTONORDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Vector3.h"
+#include "HandlePool.h"
+
+// 3 차원 모턴(Z 곡선) 키: 축마다 21 비트를 x, y, z 순으로 한 비트씩 엇갈려 63 비트로 만든다
+std::uint64_t encodeMorton3(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+// 점들을 경계 상자 기준 21 비트 격자로 양자화한 모턴 키 순서 (order[새 위치] = 이전 위치, 키가 같으면 이전 위치 순)
+// 공간적으로 가까운 점이 배열에서도 가까워지도록 저장 순서를 다시 잡을 때 사용한다.
+void computeMortonOrder(const Vector3<double>* points, std::size_t count, std::vector<std::size_t>& order);
+
+// 저장 순서를 바꿔도 그대로 유지되는 핸들(추가 순서)과 현재 저장 위치(슬롯) 사이의 대응표
+class SlotRemap {
+public:
+    // 끝에 새 슬롯을 추가하고 그 핸들을 돌려준다
+    std::size_t add();
+    void clear();
+
+    std::size_t size() const { return slotOfHandle.size(); }
+    std::size_t getSlot(std::size_t handle) const { return slotOfHandle[handle]; }
+    std::size_t getHandle(std::size_t slot) const { return handleOfSlot[slot]; }
+    const std::vector<std::size_t>& getHandles() const { return handleOfSlot; }    // 슬롯 → 핸들
+
+    // order[새 슬롯] = 이전 슬롯 인 순열을 반영하고, 이전 슬롯 → 새 슬롯 표를 newSlotOf 에 채운다
+    void permute(const std::vector<std::size_t>& order, std::vector<std::size_t>& newSlotOf);
+
+private:
+    std::vector<std::size_t> slotOfHandle;
+    std::vector<std::size_t> handleOfSlot;
+};
+
+// items 를 order 순서로 제자리에서 다시 채운다 (order[새 위치] = 이전 위치)
+// 순환마다 첫 원소만 잠시 빼 두고 나머지를 한 칸씩 당겨 오므로 items 의 용량이 유지된다.
+// placed 는 채운 위치 표시용 버퍼로, 호출자가 들고 재사용하면 할당이 없다.
+template<typename T>
+void applyOrder(std::vector<T>& items, const std::vector<std::size_t>& order, std::vector<unsigned char>& placed) {
+    placed.assign(items.size(), 0);
+    for (std::size_t start = 0; start < items.size(); ++start) {
+        if (placed[start]) {
+            continue;
+        }
+        placed[start] = 1;
+        if (order[start] == start) {
+            continue;
+        }
+        T held = std::move(items[start]);
+        std::size_t to = start;
+        while (order[to] != start) {
+            items[to] = std::move(items[order[to]]);
+            to = order[to];
+            placed[to] = 1;
+        }
+        items[to] = std::move(held);
+    }
+}
+
+#endif // MORTONORDER_H
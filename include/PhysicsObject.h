@@ -4,53 +4,153 @@
 #include "Vector3.h"
 #include "Quaternion.h"
 #include "Matrix3x3.h"
+#include "Integrator.h"
+#include "CollisionShape.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 class PhysicsObject {
 public:
+    // 스냅샷 대상인 동적 상태 (파생 값인 관성 텐서 캐시 포함)
+    // 자명하게 복사 가능한 평탄한 구조체이므로 memcpy 로 저장/복원하며, 복원 시 관성 재계산이 필요 없다.
+    // 형상과 적분기 같은 구성 요소는 포함하지 않는다.
+    struct State {
+        Vector3<double> position;
+        Quaternion<double> orientation;
+        Vector3<double> scale;
+        double mass;
+        Vector3<double> velocity;
+        Vector3<double> acceleration;
+        Vector3<double> force;
+        Vector3<double> torque;                 // 누적 토크
+        Matrix3x3<double> inertiaTensor;        // 관성 텐서
+        Matrix3x3<double> inverseInertiaTensor; // 역관성 텐서
+        Matrix3x3<double> inverseInertiaWorld;  // 월드 좌표계 역관성 텐서 캐시
+        Vector3<double> angularVelocity;        // 각속도
+        double groundHeight;                    // 바닥 높이
+        double sleepTimer;                      // 정지 상태가 지속된 시간
+        double integratorStepHint;              // 적응형 적분기의 권장 스텝
+        bool isStaticBody;                      // 정적 객체 여부
+        bool sleeping;                          // 수면 상태
+    };
+
     PhysicsObject();
 
+    // 동적 상태 전체 저장/복원 (setter 를 거치지 않으므로 파생 값도 그대로 복원됨)
+    const State& getState() const { return state; }
+    void setState(const State& s) { std::memcpy(&state, &s, sizeof(State)); }
+
     // Position 접근자
-    Vector3<double> getPosition() const { return position; }
-    void setPosition(const Vector3<double>& pos) { position = pos; }
+    Vector3<double> getPosition() const { return state.position; }
+    void setPosition(const Vector3<double>& pos) { state.position = pos; }
+
+    // Orientation 접근자
+    Quaternion<double> getOrientation() const { return state.orientation; }
+    void setOrientation(const Quaternion<double>& q) { state.orientation = q; updateWorldInertia(); }
 
     // Velocity 접근자
-    Vector3<double> getVelocity() const { return velocity; }
-    void setVelocity(const Vector3<double>& vel) { velocity = vel; }
+    Vector3<double> getVelocity() const { return state.velocity; }
+    void setVelocity(const Vector3<double>& vel) { state.velocity = vel; }
+
+    // AngularVelocity 접근자
+    Vector3<double> getAngularVelocity() const { return state.angularVelocity; }
+    void setAngularVelocity(const Vector3<double>& w) { state.angularVelocity = w; }
 
     // Mass 접근자
-    double getMass() const { return mass; }
-    void setMass(double m) { mass = m; calculateInertiaTensor(); }
+    double getMass() const { return state.mass; }
+    void setMass(double m) { state.mass = m; calculateInertiaTensor(); }
+
+    // 역질량 (정적 객체는 0)
+    double getInverseMass() const { return state.isStaticBody ? 0.0 : 1.0 / state.mass; }
+
+    // 역관성 텐서 (정적 객체는 0 행렬)
+    Matrix3x3<double> getInverseInertiaTensor() const { return state.isStaticBody ? Matrix3x3<double>() : state.inverseInertiaTensor; }
+
+    // 월드 좌표계 역관성 텐서 캐시 R I⁻¹ Rᵀ (정적 객체는 0 행렬)
+    // 토크와 충격량 적용은 모두 이 캐시를 읽는다. 회전이 바뀐 뒤에는 updateWorldInertia 로 갱신한다.
+    const Matrix3x3<double>& getInverseInertiaWorld() const { return state.inverseInertiaWorld; }
+    void updateWorldInertia();
 
     // Scale 접근자
-    Vector3<double> getScale() const { return scale; }
-    void setScale(const Vector3<double>& sc) { scale = sc; calculateInertiaTensor(); }
+    Vector3<double> getScale() const { return state.scale; }
+    void setScale(const Vector3<double>& sc) { state.scale = sc; calculateInertiaTensor(); }
+
+    // 충돌 형상 접근자 (설정하면 형상의 사전 계산된 관성을 사용, nullptr 이면 scale 기반 근사)
+    std::shared_ptr<const CollisionShape> getShape() const { return shape; }
+    void setShape(std::shared_ptr<const CollisionShape> s) { shape = s; calculateInertiaTensor(); }
 
     // GroundHeight 접근자
-    double getGroundHeight() const { return groundHeight; }
-    void setGroundHeight(double gh) { groundHeight = gh; }
+    double getGroundHeight() const { return state.groundHeight; }
+    void setGroundHeight(double gh) { state.groundHeight = gh; }
+
+    // 적분기 접근자 (nullptr 이면 기본 반암시적 오일러)
+    // 적분기는 단독 update 에서만 쓰인다. PhysicsWorld 는 속도 적분 → 접촉 해결 → 위치 적분으로 나눠 진행하므로
+    // 물체별 적분기를 무시하고 항상 반암시적 오일러로 적분한다.
+    std::shared_ptr<const Integrator> getIntegrator() const { return integrator; }
+    void setIntegrator(std::shared_ptr<const Integrator> i) { integrator = i; state.integratorStepHint = 0.0; }
+
+    // 정적 객체 여부 (정적 객체는 움직이지 않고 섬을 연결하지 않음)
+    bool isStatic() const { return state.isStaticBody; }
+    void setStatic(bool s) { state.isStaticBody = s; updateWorldInertia(); }
+
+    // 수면 상태 접근자
+    bool isSleeping() const { return state.sleeping; }
+    void setSleeping(bool s);
+    double getSleepTimer() const { return state.sleepTimer; }
+    void setSleepTimer(double t) { state.sleepTimer = t; }
+
+    // 충돌 검사용 경계 구의 반지름
+    double getBoundingRadius() const;
 
     void applyForce(const Vector3<double>& newForce);
-    void applyTorque(const Vector3<double>& torque);
+    void accumulateForce(const Vector3<double>& newForce) { state.force += newForce; }  // 수면 상태와 타이머를 건드리지 않음
+    void applyImpulse(const Vector3<double>& impulse, const Vector3<double>& relativePoint);
+    void applyAngularImpulse(const Vector3<double>& angularImpulse);
+    void applyTorque(const Vector3<double>& newTorque);
+    void integrateVelocity(double deltaTime, bool clearForces = true);  // 힘 → 속도 (부분 스텝 사이에는 외력을 유지)
+    void integratePosition(double deltaTime);   // 속도 → 위치, 회전
     void updatePosition(double deltaTime);
     void updateRotation(double deltaTime);
     void update(double deltaTime);
+
+    // 힘 원천(힘장, 스프링 등)이 주는 상태 의존 가속도 a(x, v, t) 를 함께 적분 (t 는 이번 스텝 시작 기준)
+    // 적분기는 중간 단계마다 이 함수를 다시 평가하므로 고차/적응형 적분기의 정확도와 오차 추정이 살아난다.
+    // 누적된 외력(applyForce 등)은 스텝 동안 일정한 가속도로 더해진다.
+    void updatePosition(double deltaTime, const AccelerationFunction& acceleration);
+    void update(double deltaTime, const AccelerationFunction& acceleration);
+
+    // 외력이 균일 가속도 acceleration 뿐이고 토크가 없을 때 update(deltaTime) 를 steps 번 호출한 결과로 한 번에 이동
+    // 적분기의 이산 궤적(getBallisticBias)을 따르므로 스텝 진행과 반올림 오차 범위에서 같다.
+    void advanceBallistic(const Vector3<double>& acceleration, double deltaTime, std::size_t steps);
+    double getBallisticBias() const { return integrator ? integrator->getBallisticBias() : 0.5; }
     void onCollision(PhysicsObject& other);
+
+    // 질량과 형상(nullptr 이면 scale 기반 구/박스 근사)으로 본체 좌표계 관성 텐서와 그 역행렬 계산
+    // PhysicsObject 와 엔티티 시스템이 같은 공식을 쓰도록 공유한다.
+    static void computeInertia(double mass, const Vector3<double>& scale, const CollisionShape* shape,
+        Matrix3x3<double>& inertia, Matrix3x3<double>& inverseInertia);
+    // 경계 구의 반지름 (형상이 있으면 형상 기준, 없으면 구형: scale.x, 박스형: 대각선의 절반)
+    static double computeBoundingRadius(const Vector3<double>& scale, const CollisionShape* shape);
     void onGroundCollision(); // 바닥 충돌 처리 함수
 
 private:
-    Vector3<double> position;
-    Quaternion<double> orientation;
-    Vector3<double> scale;
-    double mass;
-    Vector3<double> velocity;
-    Vector3<double> acceleration;
-    Vector3<double> force;
-    Matrix3x3<double> inertiaTensor;        // 관성 텐서
-    Matrix3x3<double> inverseInertiaTensor; // 역관성 텐서
-    Vector3<double> angularVelocity;        // 각속도
-    double groundHeight;                    // 바닥 높이
+    State state;
+    std::shared_ptr<const CollisionShape> shape;    // 공유 충돌 형상
+    std::shared_ptr<const Integrator> integrator;   // 병진 운동 적분기
 
     void calculateInertiaTensor();          // 관성 텐서를 계산하는 함수
+    void integrateAngularVelocity(double deltaTime);   // 토크 → 각속도
 };
 
+static_assert(std::is_trivially_copyable<PhysicsObject::State>::value, "PhysicsObject::State must be trivially copyable");
+
+// State 에서 값이 들어 있는 앞쪽 바이트 수 (끝의 패딩 제외)
+// 직렬화는 이만큼만 복사하고 나머지를 0 으로 두어야 패딩의 쓰레기 값이 스냅샷 바이트에 섞이지 않는다.
+const std::size_t PHYSICS_STATE_VALUE_BYTES = offsetof(PhysicsObject::State, sleeping) + sizeof(bool);
+static_assert(offsetof(PhysicsObject::State, sleeping) == offsetof(PhysicsObject::State, isStaticBody) + sizeof(bool)
+    && offsetof(PhysicsObject::State, isStaticBody) == offsetof(PhysicsObject::State, integratorStepHint) + sizeof(double),
+    "PhysicsObject::State must have padding only after its last field");
+
 #endif // PHYSICSOBJECT_H
\ No newline at end of file
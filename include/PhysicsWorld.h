@@ -0,0 +1,207 @@
+﻿#ifndef PHYSICSWORLD_H
+#define PHYSICSWORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "PhysicsObject.h"
+#include "Contact.h"
+#include "ContactEvents.h"
+#include "Island.h"
+#include "ConstraintBatch.h"
+#include "ContactSolver.h"
+#include "ForceGenerator.h"
+#include "HeightField.h"
+#include "ThreadPool.h"
+#include "XPBDSolver.h"
+#include "WorldSnapshot.h"
+#include "PublishedState.h"
+#include "CommandQueue.h"
+#include "Explosion.h"
+#include "FrameBudget.h"
+#include "MortonOrder.h"
+#include "HandlePool.h"
+
+// 여러 PhysicsObject 를 담고 접촉 생성 → 섬 구성 → 섬별 병렬 풀이 → 적분 순서로 스텝을 진행하는 월드
+// 물체는 세대 핸들로 가리키며, 저장 위치(슬롯)는 물체 제거와 모턴 순서 재배치로 바뀔 수 있다.
+// 접촉, 섬, 폭발 결과처럼 스텝 내부 목록의 물체 번호는 슬롯이므로 getBodyHandle 로 핸들로 바꾼다.
+class PhysicsWorld {
+public:
+    // threadCount == 0 이면 하드웨어 스레드 수를 사용
+    explicit PhysicsWorld(std::size_t threadCount = 0);
+
+    // 물체 추가 / 제거
+    // 물체는 밀집 배열에 빈틈 없이 저장되고 제거는 마지막 물체를 빈자리로 옮기므로 둘 다 O(1) 이며,
+    // reserveBodies 로 잡은 용량 안에서는 할당이 없다. 제거된 물체의 핸들은 번호가 재사용되어도 오래된 핸들로 판별된다.
+    // 제거하면 그 물체에 걸린 관절과 스프링도 지워지고(뒤 번호가 당겨짐), 닿아 있던 물체는 깨어난다.
+    BodyHandle addBody(const PhysicsObject& body);
+    bool removeBody(BodyHandle handle);     // 오래된 핸들이면 false
+    void reserveBodies(std::size_t capacity);
+
+    bool isValid(BodyHandle handle) const { return bodyHandles.isValid(handle); }
+    // 오래된 핸들이면 std::invalid_argument
+    PhysicsObject& getBody(BodyHandle handle);
+    const PhysicsObject& getBody(BodyHandle handle) const;
+    // 오래된 핸들이면 nullptr
+    PhysicsObject* findBody(BodyHandle handle);
+    std::size_t getBodyCount() const { return bodies.size(); }
+    const std::vector<PhysicsObject>& getBodies() const { return bodies; }     // 슬롯 순서
+
+    // 핸들 ↔ 슬롯 (오래된 핸들의 슬롯은 HandlePool::NO_SLOT)
+    std::size_t getBodySlot(BodyHandle handle) const { return bodyHandles.getSlot(handle); }
+    BodyHandle getBodyHandle(std::size_t slot) const { return bodyHandles.getHandle(slot); }
+
+    // 핸들 번호 순 순회: [0, getBodyIndexCount()) 중 비어 있는 번호는 null 핸들
+    std::size_t getBodyIndexCount() const { return bodyHandles.getIndexCount(); }
+    BodyHandle getBodyHandleAtIndex(std::size_t index) const { return bodyHandles.getHandleAtIndex(index); }
+
+    // 두 물체 사이의 거리 제약 / 스프링 추가 (오래된 핸들이면 std::invalid_argument)
+    std::size_t addDistanceJoint(BodyHandle bodyA, BodyHandle bodyB, double restLength);
+    std::size_t addSpring(BodyHandle bodyA, BodyHandle bodyB, double restLength, double stiffness, double damping);
+
+    // 모턴 순서 재배치: reorderInterval 스텝마다 스텝 시작 때 물체와 연성체 입자를 위치의 Z 곡선 순서로 다시 저장한다 (0 이면 끔)
+    // 브로드페이즈, 접촉 풀이, 입자 제약 루프에서 가까운 물체끼리 캐시 줄을 공유하게 된다. 핸들은 그대로 유지된다.
+    // 같은 입력이라도 풀이 순서가 바뀌므로 재배치 전후의 결과는 비트 단위로 같지 않다.
+    unsigned reorderInterval;
+    void reorderBodies();
+
+    // 바닥 평면 높이
+    double getGroundHeight() const { return groundHeight; }
+    void setGroundHeight(double gh) { groundHeight = gh; }
+
+    // 높이 필드 지형 (설정하면 바닥 평면 대신 지형과 접촉, nullptr 이면 평면으로 복귀)
+    const std::shared_ptr<const HeightField>& getTerrain() const { return terrain; }
+    void setTerrain(std::shared_ptr<const HeightField> field) { terrain = std::move(field); }
+
+    // 수면 판정 기준
+    double sleepLinearThreshold;    // 선속도 한계 (m/s)
+    double sleepAngularThreshold;   // 각속도 한계 (rad/s)
+    double timeToSleep;             // 한계 이하로 유지되어야 하는 시간 (s)
+
+    // 접촉 수가 이 값 이상인 섬은 그래프 색칠 + SIMD 배치로 섬 내부를 병렬 풀이
+    std::size_t batchedIslandThreshold;
+
+    // 다중 속도 적분: 섬마다 속도, 접촉 상태, 오차 추정으로 2^k 개의 부분 스텝을 고른다 (k <= maxSubstepLevel, 0 이면 끔)
+    // 모든 섬은 스텝 경계에서 같은 시각에 도달한다. 부분 스텝 동안 외력은 스텝 시작 값으로 고정되고,
+    // 바닥/지형 접촉은 부분 스텝마다 다시 찾지만 물체 쌍은 스텝 시작 때 섬에 속한 접촉만 갱신한다.
+    // 배치 풀이 대상인 큰 섬은 항상 한 번에 진행한다.
+    unsigned maxSubstepLevel;
+    double substepMotionFraction;   // 부분 스텝당 허용 이동 거리 (경계 구 반지름 대비 비율)
+    double substepTolerance;        // 스텝당 허용 위치 오차 추정치 (m, 직전 스텝 대비 가속도 변화로 추정)
+
+    ContactSolver& getSolver() { return solver; }
+
+    // 힘 생성기 (기본으로 표준 중력장이 등록되어 있음, 직접 등록하는 스프링의 물체 번호는 슬롯)
+    ForceRegistry& getForces() { return forces; }
+    const std::shared_ptr<GravityField>& getGravity() const { return gravity; }
+
+    // 위치 기반 연성체/로프 (강체 풀이 뒤에 같은 스텝에서 진행, 중력은 월드 중력장을 따름)
+    XPBDSolver& getSoftBodies() { return softBodies; }
+    const XPBDSolver& getSoftBodies() const { return softBodies; }
+
+    // 다른 스레드에서 보내는 힘/토크/충격량/설정 명령 (물체는 핸들, 스텝 시작 때 물체별로 합쳐서 적용)
+    CommandQueue& getCommands() { return commands; }
+
+    // 방사형 폭발 (queue 로 쌓아 두면 다음 스텝 시작 때 명령 적용 직후 한 번에 처리, 지형이 있으면 가림 검사에 사용)
+    ExplosionSystem& getExplosions() { return explosions; }
+
+    // 한 스텝 진행
+    void step(double deltaTime);
+
+    // 스텝 시간 예산: 스텝이 예산을 넘으면 다음 스텝부터 솔버 반복 횟수 → 먼 섬의 부분 스텝 → 수면 판정 순으로 저하하고,
+    // 여유가 생기면 한 단계씩 되돌린다. 저하 중에도 dt 는 그대로이므로 틱 속도가 유지된다.
+    void setFrameBudget(const FrameBudget& budget) { budgetController.setBudget(budget); }
+    const FrameBudget& getFrameBudget() const { return budgetController.getBudget(); }
+    DegradationLevel getDegradationLevel() const { return budgetController.getLevel(); }
+
+    // 마지막 스텝의 단계별 시간과 저하 내역
+    const StepReport& getLastStepReport() const { return lastReport; }
+
+    // 지금까지 진행한 스텝 수 (스냅샷의 프레임 번호)
+    std::uint64_t getStepCount() const { return stepCount; }
+
+    // 동적 상태(물체, 연성체 입자, 이전 접촉 쌍)를 연속 버퍼에 저장 / 버퍼에서 복원
+    // 물체와 입자의 저장 순서(슬롯 → 핸들)도 담아 복원 때 되돌리므로, 사이에 재배치가 있었어도 되감은 뒤 같은 결과로 다시 진행된다.
+    // 물체 추가/제거는 구조 변경이므로 같은 물체 집합인 월드에만 복원한다.
+    // 복원은 상태 블록 복사이며 관성 재계산 같은 setter 부수 효과가 없다. 물체/입자 수가 다르면 예외.
+    void saveSnapshot(WorldSnapshot& out) const;
+    void restoreSnapshot(const WorldSnapshot& snapshot);
+
+    const std::vector<Contact>& getContacts() const { return contacts; }
+    const std::vector<Island>& getIslands() const { return islands; }
+
+    // 다른 스레드용 읽기 전용 상태 독자 등록 (스텝과 스냅샷 복원이 끝날 때마다 발행, 독자가 없으면 발행하지 않음)
+    // 등록은 물리 스레드에서 하거나 스텝을 진행하지 않는 동안에 한다.
+    std::shared_ptr<StateReader> createStateReader() { return publisher.createReader(); }
+
+    // 이번 스텝의 접촉 시작/유지/종료 이벤트 (물체는 핸들, 스텝이 끝난 뒤 일괄 소비)
+    ContactEventBuffer& getContactEvents() { return contactEvents; }
+    const ContactEventBuffer& getContactEvents() const { return contactEvents; }
+
+private:
+    std::vector<PhysicsObject> bodies;
+    HandlePool bodyHandles;
+    std::vector<DistanceJoint> joints;
+    std::vector<Contact> contacts;
+    std::vector<Island> islands;
+    ContactEventBuffer contactEvents;
+    StatePublisher publisher;
+    CommandQueue commands;
+    std::vector<BodyCommand> pendingCommands;   // 스텝마다 재사용
+    ExplosionSystem explosions;
+    FrameBudgetController budgetController;
+    StepReport lastReport;
+    bool sleepCheckThisStep;    // 수면 판정 지연 중이면 판정하는 스텝에만 true
+    double sleepCheckTime;      // 이번 판정에 반영할 경과 시간
+    std::vector<std::size_t> sweepOrder;    // 브로드페이즈 정렬 순서
+    std::vector<Vector3<double>> reorderPoints;     // 재배치 버퍼
+    std::vector<std::size_t> reorderOrder;
+    std::vector<std::size_t> reorderSlots;
+    std::vector<unsigned char> reorderPlaced;
+
+    IslandBuilder islandBuilder;
+    ContactSolver solver;
+    ForceRegistry forces;
+    XPBDSolver softBodies;
+    std::shared_ptr<GravityField> gravity;
+    ConstraintBatcher batcher;
+    std::vector<std::size_t> largeIslands;
+    std::vector<std::vector<Contact>> substepContacts;  // 섬별 부분 스텝 접촉 (스텝마다 재사용)
+    std::vector<Island> substepIslands;
+    std::vector<std::vector<std::size_t>> substepSources;  // 부분 스텝 접촉 → 프레임 접촉 인덱스 (없으면 NO_CONTACT)
+    std::vector<std::size_t> groundContactOf;           // 물체 슬롯 → 프레임 바닥 접촉 인덱스 (부분 스텝 섬에서만 채움)
+    std::unique_ptr<ThreadPool> threadPool;
+    double groundHeight;
+    std::shared_ptr<const HeightField> terrain;
+    std::uint64_t stepCount;
+
+    static constexpr std::size_t NO_CONTACT = static_cast<std::size_t>(-1);
+
+    // 지형 일괄 질의 버퍼 (스텝마다 재사용)
+    std::vector<std::size_t> groundQueryBodies;
+    std::vector<Vector3<double>> groundQueryPoints;
+    std::vector<double> groundQueryHeights;
+    std::vector<Vector3<double>> groundQueryNormals;
+
+    std::size_t requireSlot(BodyHandle handle) const;
+    void permuteBodies();
+    void applyCommands();
+    void updateWorldInertias();
+    void applyForces();
+    void detectContacts();
+    void detectGroundContacts();
+    bool makeGroundContact(std::size_t index, Contact& out) const;
+    bool makePairContact(std::size_t a, std::size_t b, Contact& out) const;
+    void chooseSubstepLevels(double deltaTime);
+    bool isFarIsland(const Island& island) const;
+    void solveIslands(double deltaTime);
+    void stepSoftBodies(double deltaTime);
+    void integrateIslandVelocities(const Island& island, double deltaTime);
+    void substepIsland(std::size_t index, double deltaTime);
+    void finishIsland(Island& island, double deltaTime);
+    void updateIslandSleep(Island& island, double deltaTime);
+};
+
+#endif // PHYSICSWORLD_H
@@ -0,0 +1,80 @@
+﻿#ifndef PUBLISHEDSTATE_H
+#define PUBLISHEDSTATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "HandlePool.h"
+
+class PhysicsWorld;
+
+// 렌더링/네트워크 스레드가 읽는 물체 하나의 발행 상태 (관성 텐서 같은 내부 값은 제외)
+struct PublishedBody {
+    BodyHandle handle;                  // 비어 있는 핸들 번호이면 null 핸들 (나머지 필드는 의미 없음)
+    Vector3<double> position;
+    Quaternion<double> orientation;
+    Vector3<double> velocity;
+    Vector3<double> angularVelocity;
+    bool sleeping;
+};
+
+// 한 스텝이 끝난 시점의 일관된 읽기 전용 상태
+struct PublishedFrame {
+    std::uint64_t frame;                        // PhysicsWorld::getStepCount
+    std::vector<PublishedBody> bodies;          // 물체 핸들 번호(index) 순서
+    std::vector<Vector3<double>> particles;     // 연성체 입자 위치 (입자 핸들 순서)
+};
+
+// 발행자 하나와 독자 하나 사이의 삼중 버퍼
+// 발행자는 뒤 버퍼를 채운 뒤 가운데 버퍼와 원자적으로 맞바꾸고, 독자는 새 프레임이 있을 때만 앞 버퍼와 가운데 버퍼를 맞바꾼다.
+// 양쪽 모두 교환 한 번으로 끝나므로 잠금도 대기도 없으며, 독자가 쥔 앞 버퍼는 다음 acquire 전까지 바뀌지 않는다.
+class StateReader {
+public:
+    StateReader();
+
+    StateReader(const StateReader&) = delete;
+    StateReader& operator=(const StateReader&) = delete;
+
+    // 가장 최근에 발행된 프레임 (새 프레임이 없으면 직전에 받은 프레임, 아직 발행 전이면 빈 프레임)
+    // 반환된 참조는 같은 독자의 다음 acquire 호출 전까지 유효하다. 한 독자는 한 스레드에서만 사용한다.
+    const PublishedFrame& acquire();
+
+    // 마지막 acquire 이후 새 프레임이 발행되었는지
+    bool hasNewFrame() const { return (middle.load(std::memory_order_relaxed) & FRESH) != 0; }
+
+private:
+    friend class StatePublisher;
+
+    static constexpr unsigned INDEX_MASK = 3u;
+    static constexpr unsigned FRESH = 4u;
+
+    PublishedFrame buffers[3];
+    std::atomic<unsigned> middle;   // 가운데 버퍼 번호 | FRESH
+    unsigned front;                 // 독자 전용
+    unsigned back;                  // 발행자 전용
+
+    PublishedFrame& getBackBuffer() { return buffers[back]; }
+    void swapBack();
+};
+
+// 스텝이 끝날 때마다 월드 상태를 모든 독자의 삼중 버퍼에 발행
+// 물리 스레드는 발행할 때 물체당 PublishedBody 하나만 복사한다.
+// createReader 와 publish 는 물리 스레드(또는 스텝을 진행하지 않는 동안)에서만 호출한다.
+// 독자가 핸들을 모두 놓으면 다음 발행 때 목록에서 정리된다.
+class StatePublisher {
+public:
+    std::shared_ptr<StateReader> createReader();
+    std::size_t getReaderCount() const { return readers.size(); }
+
+    void publish(const PhysicsWorld& world);
+
+private:
+    std::vector<std::shared_ptr<StateReader>> readers;
+    PublishedFrame staging;
+};
+
+#endif // PUBLISHEDSTATE_H
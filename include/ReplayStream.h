@@ -0,0 +1,142 @@
+﻿#ifndef REPLAYSTREAM_H
+#define REPLAYSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "Vector3.h"
+#include "Quaternion.h"
+
+class PhysicsWorld;
+
+// 리플레이 한 프레임의 물체 상태
+struct ReplayBody {
+    Vector3<double> position;
+    Quaternion<double> orientation;
+    Vector3<double> velocity;
+};
+
+// 양자화 설정 (스트림 헤더에 기록되어 디코더가 그대로 사용)
+struct ReplaySettings {
+    double positionResolution;      // 위치 고정소수점 단위 (m)
+    double velocityResolution;      // 속도 고정소수점 단위 (m/s)
+    std::uint32_t orientationBits;  // smallest-three 성분당 비트 수 (부호 포함, 2 ~ 31)
+    std::uint32_t keyframeInterval; // 키프레임 간격 (프레임)
+
+    ReplaySettings() : positionResolution(1e-4), velocityResolution(1e-3), orientationBits(15), keyframeInterval(60) {}
+};
+
+// 프레임 부호화 상태: 직전 프레임의 양자화 값과 적응형 확률 모델 (키프레임마다 초기화)
+// 부호기와 복호기가 같은 상태를 같은 순서로 갱신하므로 양자화 오차가 누적되지 않는다.
+struct ReplayCodecState {
+    struct IntegerModel {
+        std::uint16_t zero;
+        std::uint16_t sign;
+        std::uint16_t length[64];   // 크기의 비트 길이 (단항 부호)
+    };
+
+    std::vector<std::int64_t> positions;        // 물체당 3 개
+    std::vector<std::int64_t> velocities;       // 물체당 3 개
+    std::vector<std::int64_t> orientations;     // 물체당 3 개 (가장 큰 성분을 뺀 나머지)
+    std::vector<std::uint8_t> largest;          // 가장 큰 사원수 성분 인덱스 (w, x, y, z)
+
+    IntegerModel positionModel;
+    IntegerModel velocityModel;
+    IntegerModel orientationModel;
+    std::uint16_t largestChanged;
+    std::uint16_t largestBits[3];
+
+    void resize(std::size_t bodyCount);
+    void resetModels();
+};
+
+// 양자화 + 프레임 간 델타 + 프레임 단위 적응형 산술 부호화 리플레이 기록기
+// - 위치: 고정소수점. 델타 프레임은 직전 위치 + 직전 속도 * 프레임 간격 예측과의 잔차
+// - 회전: smallest-three (가장 큰 성분 인덱스 2 비트 + 나머지 세 성분)
+// - 속도: 고정소수점, 직전 프레임과의 차이
+// 각 프레임은 [종류 1 바이트 | 길이 4 바이트 | 본문] 으로 기록되며, close 시 키프레임 색인을 덧붙여 탐색할 수 있게 한다.
+// 출력 스트림은 순차 쓰기만 하므로 파이프나 소켓에도 기록할 수 있다.
+class ReplayWriter {
+public:
+    ReplayWriter(std::ostream& out, std::size_t bodyCount, double frameInterval, const ReplaySettings& settings = ReplaySettings());
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    // bodies 는 bodyCount 개
+    void writeFrame(const ReplayBody* bodies);
+
+    // 월드의 살아 있는 물체를 핸들 번호 순서로 기록 (물체 수가 bodyCount 와 같아야 함)
+    void writeFrame(const PhysicsWorld& world);
+
+    // 키프레임 색인을 쓰고 스트림을 비운다. 이후 writeFrame 은 예외
+    void close();
+
+    std::size_t getBodyCount() const { return bodyCount; }
+    std::uint64_t getFrameCount() const { return frameCount; }
+    std::uint64_t getByteCount() const { return byteCount; }
+
+private:
+    std::ostream& out;
+    std::size_t bodyCount;
+    double frameInterval;
+    ReplaySettings settings;
+    ReplayCodecState state;
+    std::uint64_t frameCount;
+    std::uint64_t byteCount;
+    bool closed;
+
+    std::vector<std::uint8_t> payload;
+    std::vector<ReplayBody> gathered;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> keyframes;    // (프레임, 바이트 위치)
+
+    void writeBytes(const std::uint8_t* data, std::size_t size);
+};
+
+// 스트리밍 복호기: 프레임을 하나씩 읽어 궤적을 재현한다.
+// 탐색 시에는 색인(없으면 프레임 머리만 훑어서 만든 색인)으로 가장 가까운 이전 키프레임으로 이동한 뒤 앞으로 복호한다.
+class ReplayReader {
+public:
+    explicit ReplayReader(std::istream& in);
+
+    std::size_t getBodyCount() const { return bodyCount; }
+    double getFrameInterval() const { return frameInterval; }
+    const ReplaySettings& getSettings() const { return settings; }
+
+    // 다음 프레임 복호 (bodies 는 bodyCount 개로 조정됨). 스트림 끝이면 false
+    bool readFrame(std::vector<ReplayBody>& bodies);
+
+    // 다음 readFrame 이 돌려줄 프레임 번호
+    std::uint64_t getFrameIndex() const { return frameIndex; }
+
+    // 다음 readFrame 이 frame 을 돌려주도록 이동 (범위를 벗어나면 std::out_of_range)
+    void seek(std::uint64_t frame);
+
+    // 전체 프레임 수 (색인이 필요하므로 입력 스트림이 탐색 가능해야 함)
+    std::uint64_t getFrameCount();
+
+private:
+    std::istream& in;
+    std::streampos origin;
+    std::size_t bodyCount;
+    double frameInterval;
+    ReplaySettings settings;
+    ReplayCodecState state;
+    std::uint64_t frameIndex;
+    std::uint64_t byteOffset;
+    bool finished;
+
+    std::vector<std::uint8_t> payload;
+    std::vector<ReplayBody> scratch;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> keyframes;
+    std::uint64_t totalFrames;
+    bool indexLoaded;
+
+    void loadIndex();
+    bool readBytes(std::uint8_t* data, std::size_t size);
+};
+
+#endif // REPLAYSTREAM_H
@@ -0,0 +1,17 @@
+﻿#ifndef SIMDLANES_H
+#define SIMDLANES_H
+
+// SIMD 레인 수 (한 번에 처리하는 원소 수). 레지스터 하나에 담기는 원소 수가 형식마다 다르므로 따로 정한다.
+// 기본값 4 는 SSE2/NEON 에서 float 레지스터 1 개, double 레지스터 2 개에 해당한다.
+
+// double 레인: 접촉 배치 풀이 (ConstraintBatch). SSE2/NEON: 2, AVX: 4, AVX-512: 8 권장
+#ifndef GAMEPHYSICS_SIMD_DOUBLE_LANES
+#define GAMEPHYSICS_SIMD_DOUBLE_LANES 4
+#endif
+
+// float 레인: 벡터장 샘플링 (VectorField), 삼각형 메시 BVH (TriangleMesh). SSE2/NEON: 4, AVX: 8, AVX-512: 16 권장
+#ifndef GAMEPHYSICS_SIMD_FLOAT_LANES
+#define GAMEPHYSICS_SIMD_FLOAT_LANES 4
+#endif
+
+#endif // SIMDLANES_H
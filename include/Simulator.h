@@ -2,15 +2,57 @@
 #define SIMULATOR_H
 
 #include "PhysicsObject.h"
+#include "HeightField.h"
+#include "TriangleMesh.h"
+#include "ForceGenerator.h"
+#include "ReplayStream.h"
+#include "KineticEvents.h"
 #include "Logging.h"
 #include <string>
+#include <type_traits>
 
 class Simulator {
 public:
     Simulator(double Vm, double Alpha, double Gamma, double Yb, double X, double Z, double Length, double Width, double Height, double tInc, double floorHeight = 0.0);
     
     void initialize();
+
+    // 발사체 적분기 선택 (nullptr 이면 기본 반암시적 오일러)
+    void setIntegrator(std::shared_ptr<const Integrator> integrator);
+
+    // 지형 설정 (nullptr 이면 floorHeight 평면 사용)
+    void setTerrain(std::shared_ptr<const HeightField> field);
+
+    // 목표물 메시 설정 (목표물 위치 (X, 0, Z) 기준 좌표, nullptr 이면 Length/Width/Height 상자)
+    // 메시가 있으면 매 틱 발사체의 이동 선분이 메시와 교차할 때 명중으로 판정한다.
+    void setTargetMesh(std::shared_ptr<const TriangleMesh> mesh) { targetMesh = mesh; invalidatePredictions(); }
+
+    // 발사체에 작용하는 힘 생성기 (initialize 에서 중력장이 등록됨, 공기 저항 등은 이후 추가)
+    // 사건 예측은 합 가속도가 바뀐 것을 스스로 감지하므로 등록을 바꾼 뒤 따로 알릴 필요가 없다.
+    // 힘장만 지원한다. 스프링의 물체 번호는 PhysicsWorld 의 슬롯이므로 등록되어 있으면 발사체 갱신에서 std::invalid_argument.
+    ForceRegistry& getForces() { return forces; }
+
+    // 리플레이 기록기 설정 (물체 2 개: 발사체, 목표물). 설정하면 매 스텝 발사체 갱신 뒤 한 프레임씩 기록
+    void setReplayWriter(std::shared_ptr<ReplayWriter> writer);
+
+    // 롤백/재시뮬레이션용 동적 상태 (자명하게 복사 가능, memcpy 로 저장/복원)
+    struct Snapshot {
+        PhysicsObject::State projectile;
+        PhysicsObject::State target;
+        double simulationTime;
+        int status;
+    };
+    void saveSnapshot(Snapshot& out) const;
+    void restoreSnapshot(const Snapshot& snapshot);
+
     int runSimulationStep();
+
+    // 사건 구동 진행: 힘이 균일 가속도뿐이면 다음 사건(바닥 도달, 목표 진입, 지형 범위 이탈, 시간 초과)
+    // 직전 틱까지 발사체를 해석적으로 건너뛴 뒤 한 틱을 정상 진행한다. 건너뛴 틱은 로그를 남기지 않는다.
+    // 예측한 사건은 절대 시각으로 큐에 남아 다음 호출에서 재사용되며, 발사체 궤적이 바뀔 때(바닥 고정, 상태 복원,
+    // 적분기/지형/목표/가속도 변경)에만 물체 버전을 올려 무효화하고 다시 예측한다.
+    // 움직이는 물체는 발사체 하나뿐이며 목표물은 정적이므로 사건의 상자로만 쓰인다.
+    int advanceToNextEvent();
     std::string getSimulationStatus() const;
     double getSimulationTime() const;
 
@@ -20,10 +62,32 @@ private:
     
     PhysicsObject projectile;
     PhysicsObject target;
+    std::shared_ptr<const HeightField> terrain;
+    std::shared_ptr<const TriangleMesh> targetMesh;
+    Vector3<double> previousPosition;   // 직전 틱의 발사체 위치 (메시 명중 선분의 시작점)
+    ForceRegistry forces;
+    std::shared_ptr<ReplayWriter> replay;
+    KineticEventQueue events;
+    bool predicted;                         // events 에 발사체의 유효한 예측이 들어 있는지
+    Vector3<double> predictedAcceleration;  // 예측에 사용한 합 가속도
+    double terrainTop;      // 지형 최고 높이 (사건 예측에서 바닥 대신 사용)
+
+    static constexpr double TIMEOUT = 60.0;
+    static constexpr std::size_t PROJECTILE = 0;    // 사건 큐의 발사체 번호
+
+    std::size_t predictQuietTicks(Vector3<double>& acceleration);
+    void schedulePredictions(const Vector3<double>& acceleration);
+    void invalidatePredictions();
+    void clampToFloor();
+    void getTargetBounds(Vector3<double>& boundsMin, Vector3<double>& boundsMax) const;
+
+    double getGroundHeight(double x, double z) const;
 
     void updateProjectile();
     bool checkCollision() const;
     bool isSimulationTimedOut() const;
 };
 
+static_assert(std::is_trivially_copyable<Simulator::Snapshot>::value, "Simulator::Snapshot must be trivially copyable");
+
 #endif // SIMULATOR_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+﻿#ifndef SPATIALMATH_H
+#define SPATIALMATH_H
+
+#include "Vector3.h"
+#include "Matrix3x3.h"
+
+// 6차원 공간 벡터 (Featherstone 표기)
+// 운동 벡터는 [각속도; 선속도], 힘 벡터는 [모멘트; 힘] 순서이며 모두 같은 좌표계의 원점 기준이다.
+struct SpatialVector {
+    Vector3<double> angular;
+    Vector3<double> linear;
+
+    SpatialVector() : angular(0.0, 0.0, 0.0), linear(0.0, 0.0, 0.0) {}
+    SpatialVector(const Vector3<double>& angular, const Vector3<double>& linear) : angular(angular), linear(linear) {}
+
+    SpatialVector& operator+=(const SpatialVector& u) { angular += u.angular; linear += u.linear; return *this; }
+    SpatialVector& operator-=(const SpatialVector& u) { angular -= u.angular; linear -= u.linear; return *this; }
+    SpatialVector operator+(const SpatialVector& u) const { return SpatialVector(angular + u.angular, linear + u.linear); }
+    SpatialVector operator-(const SpatialVector& u) const { return SpatialVector(angular - u.angular, linear - u.linear); }
+    SpatialVector operator-() const { return SpatialVector(-angular, -linear); }
+    SpatialVector operator*(double s) const { return SpatialVector(angular * s, linear * s); }
+
+    // 내적 (운동 벡터 · 힘 벡터 = 일률)
+    double dot(const SpatialVector& u) const { return angular * u.angular + linear * u.linear; }
+
+    // 운동 벡터 외적 v ×m m
+    SpatialVector crossMotion(const SpatialVector& m) const;
+
+    // 힘 벡터 외적 v ×f f
+    SpatialVector crossForce(const SpatialVector& f) const;
+};
+
+// 6x6 공간 행렬 (3x3 블록 [a b; c d])
+struct SpatialMatrix {
+    Matrix3x3<double> a, b, c, d;
+
+    SpatialMatrix() {}
+    SpatialMatrix(const Matrix3x3<double>& a, const Matrix3x3<double>& b, const Matrix3x3<double>& c, const Matrix3x3<double>& d)
+        : a(a), b(b), c(c), d(d) {}
+
+    // 강체 공간 관성: 질량 m, 질량 중심 com, 질량 중심 기준 관성 텐서 inertia
+    static SpatialMatrix inertia(double mass, const Vector3<double>& com, const Matrix3x3<double>& inertia);
+
+    // 외적 행렬 u vᵀ
+    static SpatialMatrix outerProduct(const SpatialVector& u, const SpatialVector& v);
+
+    SpatialMatrix& operator+=(const SpatialMatrix& m);
+    SpatialMatrix& operator-=(const SpatialMatrix& m);
+    SpatialMatrix operator*(const SpatialMatrix& m) const;
+    SpatialMatrix operator*(double s) const;
+    SpatialVector operator*(const SpatialVector& v) const;
+    SpatialMatrix transpose() const;
+};
+
+// 좌표계 변환 X (A → B): rotation 은 A 좌표를 B 좌표로 바꾸는 회전 E, translation 은 A 좌표로 나타낸 B 원점 r
+struct SpatialTransform {
+    Matrix3x3<double> rotation;
+    Vector3<double> translation;
+
+    SpatialTransform() : rotation(Matrix3x3<double>::identity()), translation(0.0, 0.0, 0.0) {}
+    SpatialTransform(const Matrix3x3<double>& rotation, const Vector3<double>& translation) : rotation(rotation), translation(translation) {}
+
+    // 합성: (this * other) 는 other 를 먼저 적용
+    SpatialTransform operator*(const SpatialTransform& other) const;
+
+    SpatialVector applyMotion(const SpatialVector& v) const;             // X v
+    SpatialVector applyInverseMotion(const SpatialVector& v) const;      // X⁻¹ v
+    SpatialVector applyForce(const SpatialVector& f) const;              // X* f
+    SpatialVector applyTransposeForce(const SpatialVector& f) const;     // Xᵀ f (B 의 힘을 A 로)
+
+    // 관성 변환 Xᵀ I X (B 좌표의 관성을 A 좌표로)
+    SpatialMatrix transformInertia(const SpatialMatrix& inertia) const;
+
+    // 6x6 운동 변환 행렬 [E 0; -E[r]× E]
+    SpatialMatrix toMatrix() const;
+};
+
+#endif // SPATIALMATH_H
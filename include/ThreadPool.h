@@ -0,0 +1,46 @@
+﻿#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 고정 개수의 작업 스레드를 유지하는 간단한 스레드 풀
+// parallelFor 호출 스레드도 작업에 참여하며, 모든 인덱스가 처리될 때까지 반환하지 않는다.
+class ThreadPool {
+public:
+    // threadCount == 0 이면 하드웨어 스레드 수 - 1 개의 작업 스레드를 생성
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // [0, count) 범위의 인덱스를 작업 스레드에 분배하여 task(i)를 실행
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    // 호출 스레드를 포함한 전체 실행 스레드 수
+    std::size_t getThreadCount() const { return workers.size() + 1; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    const std::function<void(std::size_t)>* currentTask;
+    std::size_t taskCount;
+    std::atomic<std::size_t> nextIndex;
+    std::size_t activeWorkers;
+    unsigned long long generation;
+    bool stopping;
+
+    void workerLoop();
+    void runTasks(const std::function<void(std::size_t)>& task, std::size_t count);
+};
+
+#endif // THREADPOOL_H
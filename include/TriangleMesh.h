@@ -0,0 +1,90 @@
+﻿#ifndef TRIANGLEMESH_H
+#define TRIANGLEMESH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Vector3.h"
+#include "SimdLanes.h"
+
+// 삼각형 메시 레이 질의
+struct MeshRay {
+    Vector3<double> origin;
+    Vector3<double> direction;  // 단위 벡터
+    double maxDistance;
+};
+
+// 삼각형 메시 레이 질의 결과
+struct MeshHit {
+    bool hit;
+    double distance;
+    Vector3<double> point;
+    Vector3<double> normal;     // 삼각형 면 법선 (감김 방향 기준)
+    std::size_t triangle;
+};
+
+// 정적 삼각형 메시 충돌체
+// 표면적 휴리스틱(SAH)으로 이진 BVH 를 만든 뒤 LANES 갈래 BVH 로 접어 평탄한 배열에 저장한다.
+// 노드는 자식 LANES 개의 경계 상자를, 잎은 삼각형 LANES 개를 SoA 로 담으므로 상자/삼각형 검사를 레인 단위로 한 번에 수행한다.
+// 정점은 단정도로 저장하며, 질의는 힙 할당을 하지 않는다 (트리 깊이가 고정 순회 스택을 넘는 퇴화 메시만 예외).
+class TriangleMesh {
+public:
+    static constexpr std::size_t LANES = GAMEPHYSICS_SIMD_FLOAT_LANES;
+
+    // 정점 배열과 삼각형 인덱스(삼각형당 3 개)로 생성
+    TriangleMesh(const std::vector<Vector3<double>>& vertices, const std::vector<std::uint32_t>& indices);
+
+    // Wavefront OBJ 의 "v x y z" 와 "f a b c ..." 만 읽어 생성 (다각형은 부채꼴로 분할, 텍스처/법선 인덱스는 무시)
+    static std::shared_ptr<TriangleMesh> loadObj(const std::string& path);
+
+    std::size_t getVertexCount() const { return vertices.size() / 3; }
+    std::size_t getTriangleCount() const { return indices.size() / 3; }
+    std::size_t getNodeCount() const { return nodes.size(); }
+    Vector3<double> getBoundsMin() const { return boundsMin; }
+    Vector3<double> getBoundsMax() const { return boundsMax; }
+
+    // 가장 가까운 교차
+    bool raycast(const MeshRay& ray, MeshHit& hit) const;
+
+    // 선분 a → b 의 첫 교차 (발사체의 틱 간 이동 검사용)
+    bool intersectSegment(const Vector3<double>& a, const Vector3<double>& b, MeshHit& hit) const;
+
+    // 교차 여부만 (가장 가까운 교차를 찾지 않고 처음 찾은 교차에서 종료)
+    bool intersectsSegment(const Vector3<double>& a, const Vector3<double>& b) const;
+
+    std::size_t raycastBatch(const MeshRay* rays, std::size_t count, MeshHit* outHits) const;
+
+private:
+    // LANES 갈래 내부 노드: 자식 경계 상자 (빈 레인은 뒤집힌 상자)
+    // child >= 0 이면 내부 노드 번호, child < 0 이면 ~child 가 삼각형 묶음 번호, EMPTY 이면 빈 레인
+    struct Node {
+        float minX[LANES], minY[LANES], minZ[LANES];
+        float maxX[LANES], maxY[LANES], maxZ[LANES];
+        std::int32_t child[LANES];
+    };
+
+    // 잎 삼각형 LANES 개 (v0, 모서리 e1 = v1 - v0, e2 = v2 - v0). 빈 레인은 퇴화 삼각형
+    struct TrianglePacket {
+        float v0x[LANES], v0y[LANES], v0z[LANES];
+        float e1x[LANES], e1y[LANES], e1z[LANES];
+        float e2x[LANES], e2y[LANES], e2z[LANES];
+        std::uint32_t triangle[LANES];
+    };
+
+    static constexpr std::int32_t EMPTY = static_cast<std::int32_t>(0x80000000u);
+
+    std::vector<float> vertices;            // 정점당 x, y, z
+    std::vector<std::uint32_t> indices;
+    std::vector<Node> nodes;                // nodes[0] 이 뿌리
+    std::vector<TrianglePacket> packets;
+    Vector3<double> boundsMin;
+    Vector3<double> boundsMax;
+    std::size_t stackSize;                  // 순회 스택에 필요한 최대 항목 수 (구축 시 트리 깊이로 계산)
+
+    void build();
+    bool traverse(const MeshRay& ray, bool anyHit, MeshHit& hit) const;
+};
+
+#endif // TRIANGLEMESH_H
@@ -0,0 +1,99 @@
+﻿#ifndef VECTORFIELD_H
+#define VECTORFIELD_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Vector3.h"
+#include "ForceGenerator.h"
+#include "SimdLanes.h"
+
+// 정규 3차원 격자 벡터장 (바람, 유동, 난류)
+// 격자점 (i, j, k) 의 월드 좌표는 origin + (i, j, k) * cellSize 이며, 성분별 float 배열(SoA)로 저장한다.
+// 현재/다음 두 프레임을 이중 버퍼로 보관하고 blend 비율로 시간 보간하므로, 다음 프레임을 채우는 동안에도 샘플링할 수 있다.
+class VectorField {
+public:
+    static constexpr std::size_t LANES = GAMEPHYSICS_SIMD_FLOAT_LANES;
+
+    typedef std::function<Vector3<double>(const Vector3<double>&)> Generator;
+
+    VectorField(std::size_t sizeX, std::size_t sizeY, std::size_t sizeZ, double cellSize,
+        const Vector3<double>& origin = Vector3<double>());
+
+    std::size_t getSizeX() const { return sizeX; }
+    std::size_t getSizeY() const { return sizeY; }
+    std::size_t getSizeZ() const { return sizeZ; }
+    double getCellSize() const { return cellSize; }
+    Vector3<double> getOrigin() const { return origin; }
+
+    // 현재 프레임 격자점 접근 (정적 장은 현재 프레임만 사용)
+    Vector3<double> getVector(std::size_t i, std::size_t j, std::size_t k) const;
+    void setVector(std::size_t i, std::size_t j, std::size_t k, const Vector3<double>& v);
+
+    // 다음 프레임 격자점 쓰기
+    void setNextVector(std::size_t i, std::size_t j, std::size_t k, const Vector3<double>& v);
+
+    // 격자점 월드 좌표로 생성기를 호출해 채운다. fill 은 두 프레임 모두, fillNext 는 다음 프레임만 채운다.
+    void fill(const Generator& generator);
+    void fillNext(const Generator& generator);
+
+    // 시간 보간 비율 (0: 현재 프레임, 1: 다음 프레임)
+    double getBlend() const { return blend; }
+    void setBlend(double b) { blend = b; }
+
+    // 시간 진행. blend 가 1 에 도달하면 다음 프레임이 현재 프레임이 되고 true 를 반환한다
+    // (호출자는 이때 fillNext 로 새 다음 프레임을 채운다).
+    bool advance(double deltaTime, double frameDuration);
+
+    // 삼선형 보간 샘플 (범위 밖은 가장자리 값으로 고정)
+    Vector3<double> sample(const Vector3<double>& position) const;
+
+    // 일괄 샘플: LANES 개씩 묶어 레인 단위로 보간한다. 출력 배열은 호출자가 count 개 이상 준비한다.
+    void sampleBatch(const Vector3<double>* positions, std::size_t count, Vector3<double>* out) const;
+    void sampleBatch(const float* x, const float* y, const float* z, std::size_t count,
+        float* outX, float* outY, float* outZ) const;
+
+private:
+    struct Frame {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+    };
+
+    std::size_t sizeX;
+    std::size_t sizeY;
+    std::size_t sizeZ;
+    double cellSize;
+    double inverseCellSize;
+    Vector3<double> origin;
+
+    Frame frames[2];
+    std::size_t current;    // 현재 프레임 인덱스 (다음 프레임은 1 - current)
+    double blend;
+
+    std::size_t index(std::size_t i, std::size_t j, std::size_t k) const { return (k * sizeY + j) * sizeX + i; }
+    void fillFrame(Frame& frame, const Generator& generator);
+
+    // 레인 묶음 하나를 보간 (count <= LANES)
+    void sampleLanes(const float* x, const float* y, const float* z, std::size_t count,
+        float* outX, float* outY, float* outZ) const;
+};
+
+// 벡터장을 공기 속도로 보는 공기 저항: F = -(k1 + k2 |v_rel|) v_rel, v_rel = v - field(p)
+class FlowDragField : public ForceField {
+public:
+    FlowDragField(std::shared_ptr<const VectorField> field, double linear, double quadratic);
+
+    double linear;
+    double quadratic;
+
+    // 한 스텝에서 한 스레드만 호출한다 (샘플 버퍼를 재사용)
+    void accumulate(const ForceBatch& batch) const override;
+
+private:
+    std::shared_ptr<const VectorField> field;
+    mutable std::vector<Vector3<double>> airVelocities;
+};
+
+#endif // VECTORFIELD_H
@@ -0,0 +1,109 @@
+﻿#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PhysicsWorld;
+
+// 두 스냅샷 사이의 변경분: 달라진 8 바이트 워드의 연속 구간만 담는다.
+// 잠든 물체와 정적 물체는 워드가 그대로이므로 변경분에 나타나지 않는다.
+struct SnapshotDelta {
+    bool baseEmpty;                     // 적용 대상이 빈 스냅샷인지 (빈 스냅샷에는 프레임이 없다)
+    std::uint64_t baseFrame;            // 적용 대상 스냅샷의 프레임
+    std::uint64_t frame;                // 적용 결과 스냅샷의 프레임
+    std::size_t wordCount;              // 결과 스냅샷의 전체 워드 수
+    std::vector<std::uint32_t> runs;    // (시작 워드, 워드 수) 쌍
+    std::vector<std::uint64_t> words;   // 구간 내용 (runs 순서대로 이어 붙임)
+
+    std::size_t getByteSize() const { return runs.size() * sizeof(std::uint32_t) + words.size() * sizeof(std::uint64_t); }
+};
+
+// 월드 동적 상태 스냅샷
+// [헤더 | 물체 상태 | 연성체 입자 위치 | 입자 속도 | 물체 저장 순서 | 입자 저장 순서 | 이전 접촉 쌍] 을 하나의 연속된 워드 버퍼에 담는다.
+// 상태 구역은 자명하게 복사 가능한 값을 물체/입자 핸들 순서로 담은 배열이며, 복원도 값 복사로 끝난다.
+// 저장 순서 구역은 슬롯마다 그 자리의 핸들을 담는다. 풀이 순서가 슬롯 순서를 따르므로 복원 때 이 순서로 되돌려야
+// 모턴 재배치가 켜진 월드에서도 되감은 뒤의 재시뮬레이션이 원래 실행과 같아진다.
+// 물체/입자 수 같은 구조는 스냅샷 대상이 아니므로 같은 구조의 월드에만 복원할 수 있다.
+class WorldSnapshot {
+public:
+    struct Header {
+        std::uint64_t frame;            // PhysicsWorld::getStepCount
+        std::uint64_t bodyCount;
+        std::uint64_t particleCount;
+        std::uint64_t pairCount;
+    };
+
+    WorldSnapshot();
+
+    // 구역 배치를 다시 잡는다 (용량이 충분하면 재할당 없음)
+    void layout(std::uint64_t frame, std::size_t bodyCount, std::size_t particleCount, std::size_t pairCount);
+
+    Header getHeader() const;
+    std::uint64_t getFrame() const { return getHeader().frame; }
+    bool isEmpty() const { return words.empty(); }
+
+    std::size_t getWordCount() const { return words.size(); }
+    std::size_t getByteSize() const { return words.size() * sizeof(std::uint64_t); }
+    const std::uint64_t* getData() const { return words.data(); }
+
+    // 구역 시작 주소 (PhysicsWorld 의 저장/복원에서 사용)
+    void* getBodies() { return words.data() + bodyOffset; }
+    const void* getBodies() const { return words.data() + bodyOffset; }
+    void* getPositions() { return words.data() + positionOffset; }
+    const void* getPositions() const { return words.data() + positionOffset; }
+    void* getVelocities() { return words.data() + velocityOffset; }
+    const void* getVelocities() const { return words.data() + velocityOffset; }
+    void* getBodyOrder() { return words.data() + bodyOrderOffset; }                 // 슬롯 → BodyHandle
+    const void* getBodyOrder() const { return words.data() + bodyOrderOffset; }
+    void* getParticleOrder() { return words.data() + particleOrderOffset; }         // 슬롯 → 입자 핸들 (uint64)
+    const void* getParticleOrder() const { return words.data() + particleOrderOffset; }
+    void* getPairs() { return words.data() + pairOffset; }
+    const void* getPairs() const { return words.data() + pairOffset; }
+
+    // base 에서 이 스냅샷으로 가는 변경분을 out 에 기록 (out 의 버퍼는 재사용)
+    void makeDelta(const WorldSnapshot& base, SnapshotDelta& out) const;
+
+    // 이 스냅샷이 delta.baseFrame 상태일 때 변경분을 적용해 delta.frame 상태로 만든다
+    // 빈 스냅샷 여부나 프레임이 변경분의 기준과 다르면 예외
+    void applyDelta(const SnapshotDelta& delta);
+
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t bodyOffset;
+    std::size_t positionOffset;
+    std::size_t velocityOffset;
+    std::size_t bodyOrderOffset;
+    std::size_t particleOrderOffset;
+    std::size_t pairOffset;
+
+    void updateOffsets();
+};
+
+// 최근 capacity 개 프레임의 스냅샷을 보관하는 고리 버퍼 (롤백/재시뮬레이션용)
+// 슬롯 버퍼를 재사용하므로 정상 상태에서는 저장 시 할당이 없다.
+class SnapshotHistory {
+public:
+    explicit SnapshotHistory(std::size_t capacity);
+
+    // 현재 월드 상태를 가장 오래된 슬롯에 덮어써 저장
+    const WorldSnapshot& record(const PhysicsWorld& world);
+
+    // frame 의 스냅샷 (없으면 nullptr)
+    const WorldSnapshot* find(std::uint64_t frame) const;
+
+    // frame 시점으로 월드를 되돌리고 그 이후 프레임의 기록을 버린다 (없으면 false)
+    bool rewind(PhysicsWorld& world, std::uint64_t frame);
+
+    std::size_t getCapacity() const { return slots.size(); }
+    std::size_t getCount() const { return count; }
+    void clear() { count = 0; }
+
+private:
+    std::vector<WorldSnapshot> slots;
+    std::size_t next;
+    std::size_t count;
+};
+
+#endif // WORLDSNAPSHOT_H
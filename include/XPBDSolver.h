@@ -0,0 +1,129 @@
+﻿#ifndef XPBDSOLVER_H
+#define XPBDSOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+#include "PhysicsObject.h"
+#include "HeightField.h"
+#include "ThreadPool.h"
+#include "MortonOrder.h"
+
+// 확장 위치 기반 동역학(XPBD) 연성체/로프 솔버
+// 제약은 입자를 공유하지 않도록 탐욕적으로 색칠하고, 색 단위로 순서대로(가우스-자이델) 풀되 같은 색 안은 병렬로 푼다.
+// 컴플라이언스 α 는 강성의 역수(m/N)이며, 0 이면 완전 강체 제약이다.
+// 입자 번호는 추가 순서로 정해지는 핸들이며, reorderParticles 로 저장 순서(슬롯)가 바뀌어도 그대로 유지된다.
+class XPBDSolver {
+public:
+    enum class ConstraintType : std::uint8_t {
+        Distance,   // |x0 - x1| = rest
+        Bending,    // |x1 - (x0 + x1 + x2) / 3| = rest (x1 이 가운데 입자)
+        Volume      // 6 · 사면체 부피 = rest
+    };
+
+    struct Constraint {
+        ConstraintType type;
+        std::uint32_t particles[4];
+        double rest;
+        double compliance;
+        double lambda;
+    };
+
+    // 최대 색 수 (비트마스크 폭). 넘치는 제약은 마지막에 순차적으로 푼다.
+    static constexpr std::size_t MAX_COLORS = 64;
+
+    XPBDSolver();
+
+    // 입자 추가 (mass <= 0 이면 고정 입자, 반환값은 입자 핸들)
+    std::size_t addParticle(const Vector3<double>& position, double mass);
+
+    void addDistanceConstraint(std::size_t a, std::size_t b, double compliance, double restLength = -1.0);
+    void addBendingConstraint(std::size_t a, std::size_t middle, std::size_t b, double compliance);
+    void addVolumeConstraint(std::size_t a, std::size_t b, std::size_t c, std::size_t d, double compliance);
+
+    // 로프: start 에서 end 까지 segments 개 구간 (거리 + 굽힘 제약)
+    std::size_t addRope(const Vector3<double>& start, const Vector3<double>& end, std::size_t segments,
+        double totalMass, double stretchCompliance, double bendCompliance);
+
+    // 격자 천: 질점 (c, r) 은 first + r * columns + c (거리 + 전단 + 굽힘 제약)
+    std::size_t addCloth(const Vector3<double>& origin, const Vector3<double>& uAxis, const Vector3<double>& vAxis,
+        std::size_t columns, std::size_t rows, double totalMass, double stretchCompliance, double bendCompliance);
+
+    // 사면체 연성체: 정점과 사면체 인덱스(4 개씩)로 모서리 거리 제약과 부피 제약 생성
+    std::size_t addTetrahedralBody(const std::vector<Vector3<double>>& vertices, const std::vector<unsigned int>& tetrahedra,
+        double totalMass, double edgeCompliance, double volumeCompliance);
+
+    void setPinned(std::size_t handle, bool pinned);
+
+    std::size_t getParticleCount() const { return positions.size(); }
+    Vector3<double> getPosition(std::size_t handle) const { return positions[particleSlots.getSlot(handle)]; }
+    Vector3<double> getVelocity(std::size_t handle) const { return velocities[particleSlots.getSlot(handle)]; }
+    void setPosition(std::size_t handle, const Vector3<double>& p) { positions[particleSlots.getSlot(handle)] = p; }
+    void setVelocity(std::size_t handle, const Vector3<double>& v) { velocities[particleSlots.getSlot(handle)] = v; }
+
+    // 저장 순서(슬롯) 배열 직접 접근. 재배치 후에는 핸들 순서와 다르므로 getParticleHandle 로 대응시킨다.
+    const std::vector<Vector3<double>>& getPositions() const { return positions; }
+    const std::vector<Vector3<double>>& getVelocities() const { return velocities; }
+    std::size_t getParticleSlot(std::size_t handle) const { return particleSlots.getSlot(handle); }
+    std::size_t getParticleHandle(std::size_t slot) const { return particleSlots.getHandle(slot); }
+
+    // 입자를 위치의 모턴 순서로 다시 배치하고 제약을 새 슬롯 기준으로 다시 색칠한다 (핸들은 그대로)
+    void reorderParticles();
+    // 슬롯 → 핸들 표와 그 표대로 저장 순서를 되돌리기 (스냅샷 저장/복원용, 순열이 아니면 std::invalid_argument)
+    const std::vector<std::size_t>& getParticleHandles() const { return particleSlots.getHandles(); }
+    void setParticleOrder(const std::uint64_t* handleOfSlot);
+    std::size_t getConstraintCount() const { return constraints.size(); }
+    std::size_t getColorCount() const { return colorOffsets.empty() ? 0 : colorOffsets.size() - 1; }
+
+    Vector3<double> gravity;
+    std::size_t substeps;       // 스텝당 하위 스텝 수
+    std::size_t iterations;     // 하위 스텝당 제약 반복 수
+    double particleRadius;      // 충돌용 입자 반지름
+    double friction;            // 접촉 시 접선 변위 감쇠 비율 (0 ~ 1)
+    std::size_t parallelThreshold;  // 한 색의 제약 수가 이 값 이상이면 병렬 풀이
+
+    // 한 스텝 진행. bodies 의 경계 구와 바닥(평면 또는 지형)에 대해 충돌하며, 동적 물체에는 반작용 충격량을 준다.
+    void step(double deltaTime, ThreadPool& pool, std::vector<PhysicsObject>& bodies,
+        double groundHeight, const HeightField* terrain);
+
+private:
+    // 입자 상태 (속성별 배열, 벡터는 Vector3 원소)
+    std::vector<Vector3<double>> positions;
+    std::vector<Vector3<double>> previousPositions;
+    std::vector<Vector3<double>> velocities;
+    std::vector<double> inverseMasses;
+    std::vector<double> restInverseMasses;
+    SlotRemap particleSlots;
+    std::vector<std::size_t> reorderOrder;      // 재배치 버퍼 (재배치마다 재사용)
+    std::vector<std::size_t> reorderSlots;
+    std::vector<unsigned char> reorderPlaced;
+
+    std::vector<Constraint> constraints;    // 색 순서로 정렬되어 있음
+    std::vector<std::size_t> colorOffsets;
+    std::size_t overflowBegin;              // 색을 받지 못한 제약의 시작 위치 (순차 풀이)
+    bool constraintsDirty;
+
+    // 입자 충돌 (스텝 시작 시 후보 수집, 하위 스텝마다 부등식 제약으로 풀이)
+    struct ParticleContact {
+        std::size_t particle;
+        std::size_t body;           // Contact::STATIC_BODY 이면 바닥
+        Vector3<double> normal;     // 바닥: 평면 법선
+        Vector3<double> point;      // 바닥: 평면 위 점, 물체: 구 중심
+        double distance;            // 물체: 구 반지름 + 입자 반지름
+        double lambda;              // 물체 접촉의 누적 보정량 (반작용 충격량 계산용)
+    };
+    std::vector<ParticleContact> particleContacts;
+    std::vector<std::size_t> bodyOrder;
+
+    void permuteParticles();
+    void colorConstraints();
+    void solveConstraint(Constraint& constraint, double timeStep);
+    void solveConstraints(ThreadPool& pool, double timeStep);
+    void collectContacts(const std::vector<PhysicsObject>& bodies, double groundHeight, const HeightField* terrain, double deltaTime);
+    void solveContacts(const std::vector<PhysicsObject>& bodies);
+    void applyFriction();
+    void applyReactions(std::vector<PhysicsObject>& bodies, double timeStep);
+};
+
+#endif // XPBDSOLVER_H
@@ -0,0 +1,254 @@
+﻿#ifndef ARTICULATEDBODY_CPP
+#define ARTICULATEDBODY_CPP
+
+#include <stdexcept>
+#include "ArticulatedBody.h"
+#include "Constants.h"
+
+ArticulatedBody::ArticulatedBody()
+    : basePosition(0.0, 0.0, 0.0),
+    baseOrientation(1.0, 0.0, 0.0, 0.0),
+    gravity(0.0, -Constants<double>::GRAVITY, 0.0) {}
+
+std::size_t ArticulatedBody::addLink(int parent, JointType joint, const Vector3<double>& axis, const Vector3<double>& offset,
+    double mass, const Vector3<double>& centerOfMass, const Matrix3x3<double>& inertia, const Quaternion<double>& frame)
+{
+    if (parent != BASE && (parent < 0 || static_cast<std::size_t>(parent) >= links.size())) {
+        throw std::invalid_argument("ArticulatedBody::addLink parent must be BASE or an existing link");
+    }
+    if (mass <= 0.0) {
+        throw std::invalid_argument("ArticulatedBody::addLink mass must be positive");
+    }
+
+    Link link;
+    link.parent = parent;
+    link.joint = joint;
+    link.axis = axis;
+    link.axis.normalize();
+    link.offset = offset;
+    link.frame = frame;
+    link.mass = mass;
+    link.centerOfMass = centerOfMass;
+    link.inertia = inertia;
+    link.position = 0.0;
+    link.rotation = Quaternion<double>(1.0, 0.0, 0.0, 0.0);
+    link.velocity = Vector3<double>(0.0, 0.0, 0.0);
+    link.acceleration = Vector3<double>(0.0, 0.0, 0.0);
+    link.torque = Vector3<double>(0.0, 0.0, 0.0);
+    link.damping = 0.0;
+    links.push_back(link);
+
+    resizeBuffers();
+
+    // 관절 운동 부분공간 S (링크 좌표계, 고정)
+    SpatialVector* s = &motionSubspace[3 * (links.size() - 1)];
+    const Vector3<double> zero(0.0, 0.0, 0.0);
+    switch (joint) {
+    case JointType::Revolute:
+        s[0] = SpatialVector(link.axis, zero);
+        break;
+    case JointType::Prismatic:
+        s[0] = SpatialVector(zero, link.axis);
+        break;
+    case JointType::Spherical:
+        s[0] = SpatialVector(Vector3<double>(1.0, 0.0, 0.0), zero);
+        s[1] = SpatialVector(Vector3<double>(0.0, 1.0, 0.0), zero);
+        s[2] = SpatialVector(Vector3<double>(0.0, 0.0, 1.0), zero);
+        break;
+    }
+    return links.size() - 1;
+}
+
+void ArticulatedBody::resizeBuffers() {
+    std::size_t n = links.size();
+    parentToLink.resize(n);
+    velocities.resize(n);
+    biasAccelerations.resize(n);
+    biasForces.resize(n);
+    articulatedInertias.resize(n);
+    externalForces.resize(n);
+    spatialAccelerations.resize(n);
+    motionSubspace.resize(3 * n);
+    projectedInertia.resize(3 * n);
+    inverseJointInertias.resize(n);
+    jointForces.resize(n);
+    worldPositions.resize(n);
+    worldRotations.resize(n);
+}
+
+void ArticulatedBody::applyLinkForce(std::size_t index, const Vector3<double>& force, const Vector3<double>& point) {
+    updateKinematics();
+    Matrix3x3<double> toLink = worldRotations[index].transpose();
+    Vector3<double> localForce = toLink * force;
+    Vector3<double> localPoint = toLink * (point - worldPositions[index]);
+    externalForces[index] += SpatialVector(localPoint ^ localForce, localForce);
+}
+
+// 부모 → 링크 변환 Xup = X_J(q) X_tree
+SpatialTransform ArticulatedBody::jointTransform(const Link& link) const {
+    SpatialTransform tree(link.frame.toMatrix3x3().transpose(), link.offset);
+    switch (link.joint) {
+    case JointType::Revolute:
+        return SpatialTransform(Quaternion<double>::qVRotate(link.axis, link.position).toMatrix3x3().transpose(),
+            Vector3<double>(0.0, 0.0, 0.0)) * tree;
+    case JointType::Prismatic:
+        return SpatialTransform(Matrix3x3<double>::identity(), link.axis * link.position) * tree;
+    default:
+        return SpatialTransform(link.rotation.toMatrix3x3().transpose(), Vector3<double>(0.0, 0.0, 0.0)) * tree;
+    }
+}
+
+// 1 단계 (기저 → 끝): 변환, 링크 속도, 월드 자세
+void ArticulatedBody::updateKinematics() {
+    Matrix3x3<double> baseRotation = baseOrientation.toMatrix3x3();
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        const Link& link = links[i];
+        parentToLink[i] = jointTransform(link);
+        const SpatialTransform& x = parentToLink[i];
+
+        SpatialVector jointVelocity;
+        const SpatialVector* s = &motionSubspace[3 * i];
+        for (std::size_t k = 0; k < dofCount(link.joint); ++k) {
+            jointVelocity += s[k] * (k == 0 ? link.velocity.x : (k == 1 ? link.velocity.y : link.velocity.z));
+        }
+
+        Matrix3x3<double> parentRotation = link.parent == BASE ? baseRotation : worldRotations[link.parent];
+        Vector3<double> parentPosition = link.parent == BASE ? basePosition : worldPositions[link.parent];
+        worldRotations[i] = parentRotation * x.rotation.transpose();
+        worldPositions[i] = parentPosition + parentRotation * x.translation;
+
+        SpatialVector parentVelocity = link.parent == BASE ? SpatialVector() : velocities[link.parent];
+        velocities[i] = x.applyMotion(parentVelocity) + jointVelocity;
+        biasAccelerations[i] = velocities[i].crossMotion(jointVelocity);
+    }
+}
+
+void ArticulatedBody::computeForwardDynamics() {
+    updateKinematics();
+    const std::size_t n = links.size();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Link& link = links[i];
+        SpatialMatrix inertia = SpatialMatrix::inertia(link.mass, link.centerOfMass, link.inertia);
+        articulatedInertias[i] = inertia;
+        biasForces[i] = velocities[i].crossForce(inertia * velocities[i]) - externalForces[i];
+    }
+
+    // 2 단계 (끝 → 기저): 관절체 관성과 편향력을 부모로 누적
+    for (std::size_t i = n; i-- > 0;) {
+        const Link& link = links[i];
+        std::size_t dof = dofCount(link.joint);
+        const SpatialVector* s = &motionSubspace[3 * i];
+        SpatialVector* u = &projectedInertia[3 * i];
+        const SpatialMatrix& ia = articulatedInertias[i];
+
+        Vector3<double> tau = link.torque - link.velocity * link.damping;
+        double jointInertia[3][3] = {};
+        double jointForce[3] = {};
+        for (std::size_t k = 0; k < dof; ++k) {
+            u[k] = ia * s[k];
+            jointForce[k] = (k == 0 ? tau.x : (k == 1 ? tau.y : tau.z)) - s[k].dot(biasForces[i]);
+        }
+        for (std::size_t j = 0; j < dof; ++j) {
+            for (std::size_t k = 0; k < dof; ++k) {
+                jointInertia[j][k] = s[j].dot(u[k]);
+            }
+        }
+
+        Matrix3x3<double>& dInverse = inverseJointInertias[i];
+        if (dof == 1) {
+            dInverse = Matrix3x3<double>();
+            dInverse.e11 = 1.0 / jointInertia[0][0];
+        }
+        else {
+            dInverse = Matrix3x3<double>(
+                jointInertia[0][0], jointInertia[0][1], jointInertia[0][2],
+                jointInertia[1][0], jointInertia[1][1], jointInertia[1][2],
+                jointInertia[2][0], jointInertia[2][1], jointInertia[2][2]).inverse();
+        }
+        jointForces[i] = Vector3<double>(jointForce[0], jointForce[1], jointForce[2]);
+
+        if (link.parent == BASE) {
+            continue;
+        }
+
+        const double dInv[3][3] = {
+            { dInverse.e11, dInverse.e12, dInverse.e13 },
+            { dInverse.e21, dInverse.e22, dInverse.e23 },
+            { dInverse.e31, dInverse.e32, dInverse.e33 }
+        };
+        SpatialMatrix reduced = ia;
+        SpatialVector correction;
+        for (std::size_t j = 0; j < dof; ++j) {
+            for (std::size_t k = 0; k < dof; ++k) {
+                reduced -= SpatialMatrix::outerProduct(u[j], u[k]) * dInv[j][k];
+                correction += u[j] * (dInv[j][k] * jointForce[k]);
+            }
+        }
+        SpatialVector reducedBias = biasForces[i] + reduced * biasAccelerations[i] + correction;
+
+        const SpatialTransform& x = parentToLink[i];
+        articulatedInertias[link.parent] += x.transformInertia(reduced);
+        biasForces[link.parent] += x.applyTransposeForce(reducedBias);
+    }
+
+    // 3 단계 (기저 → 끝): 관절 가속도. 중력은 기저의 가상 상향 가속도로 넣는다.
+    Matrix3x3<double> baseRotation = baseOrientation.toMatrix3x3();
+    SpatialVector baseAcceleration(Vector3<double>(0.0, 0.0, 0.0), -(baseRotation.transpose() * gravity));
+    for (std::size_t i = 0; i < n; ++i) {
+        Link& link = links[i];
+        std::size_t dof = dofCount(link.joint);
+        const SpatialVector* s = &motionSubspace[3 * i];
+        const SpatialVector* u = &projectedInertia[3 * i];
+
+        SpatialVector parentAcceleration = link.parent == BASE ? baseAcceleration : spatialAccelerations[link.parent];
+        SpatialVector a = parentToLink[i].applyMotion(parentAcceleration) + biasAccelerations[i];
+
+        Vector3<double> rhs = jointForces[i];
+        rhs.x -= u[0].dot(a);
+        if (dof == 3) {
+            rhs.y -= u[1].dot(a);
+            rhs.z -= u[2].dot(a);
+        }
+        link.acceleration = inverseJointInertias[i] * rhs;
+
+        for (std::size_t k = 0; k < dof; ++k) {
+            a += s[k] * (k == 0 ? link.acceleration.x : (k == 1 ? link.acceleration.y : link.acceleration.z));
+        }
+        spatialAccelerations[i] = a;
+    }
+
+    for (auto& f : externalForces) {
+        f = SpatialVector();
+    }
+}
+
+void ArticulatedBody::step(double deltaTime) {
+    computeForwardDynamics();
+    for (auto& link : links) {
+        link.velocity += link.acceleration * deltaTime;
+        if (link.joint == JointType::Spherical) {
+            // 자식 좌표계 각속도로 회전 갱신
+            link.rotation = link.rotation * Quaternion<double>::fromAngularVelocity(link.velocity, deltaTime);
+            link.rotation.normalize();
+        }
+        else {
+            link.position += link.velocity.x * deltaTime;
+        }
+    }
+}
+
+double ArticulatedBody::computeEnergy() {
+    updateKinematics();
+    double energy = 0.0;
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        const Link& link = links[i];
+        SpatialMatrix inertia = SpatialMatrix::inertia(link.mass, link.centerOfMass, link.inertia);
+        energy += 0.5 * velocities[i].dot(inertia * velocities[i]);
+        Vector3<double> worldCenter = worldPositions[i] + worldRotations[i] * link.centerOfMass;
+        energy -= link.mass * (gravity * worldCenter);
+    }
+    return energy;
+}
+
+#endif // ARTICULATEDBODY_CPP
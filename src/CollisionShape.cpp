@@ -0,0 +1,216 @@
+﻿#ifndef COLLISIONSHAPE_CPP
+#define COLLISIONSHAPE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "CollisionShape.h"
+#include "Constants.h"
+
+namespace {
+
+    // 2차 모멘트(공분산) 행렬 C 로부터 관성 텐서 I = tr(C) E - C
+    Matrix3x3<double> inertiaFromCovariance(const Matrix3x3<double>& c) {
+        return Matrix3x3<double>::identity() * c.trace() - c;
+    }
+
+} // namespace
+
+CollisionShape::CollisionShape(ShapeType type)
+    : type(type), volume(0.0), centerOfMass(0.0, 0.0, 0.0),
+    unitInertia(Matrix3x3<double>::identity()), unitInverseInertia(Matrix3x3<double>::identity()),
+    boundingRadius(0.0) {}
+
+void CollisionShape::setDiagonalInertia(double ix, double iy, double iz) {
+    unitInertia = Matrix3x3<double>(
+        ix, 0.0, 0.0,
+        0.0, iy, 0.0,
+        0.0, 0.0, iz
+    );
+    unitInverseInertia = Matrix3x3<double>(
+        1.0 / ix, 0.0, 0.0,
+        0.0, 1.0 / iy, 0.0,
+        0.0, 0.0, 1.0 / iz
+    );
+}
+
+void CollisionShape::setInertia(const Matrix3x3<double>& inertia) {
+    unitInertia = inertia;
+    unitInverseInertia = inertia.inverse();
+}
+
+// 구: I = (2/5) r^2
+SphereShape::SphereShape(double radius)
+    : CollisionShape(ShapeType::Sphere), radius(radius)
+{
+    volume = 4.0 / 3.0 * Constants<double>::PI * radius * radius * radius;
+    double i = 0.4 * radius * radius;
+    setDiagonalInertia(i, i, i);
+    boundingRadius = radius;
+}
+
+// 직육면체: I_x = (b^2 + c^2) / 3 (반 크기 a, b, c 기준)
+BoxShape::BoxShape(const Vector3<double>& halfExtents)
+    : CollisionShape(ShapeType::Box), halfExtents(halfExtents)
+{
+    double a2 = halfExtents.x * halfExtents.x;
+    double b2 = halfExtents.y * halfExtents.y;
+    double c2 = halfExtents.z * halfExtents.z;
+    volume = 8.0 * halfExtents.x * halfExtents.y * halfExtents.z;
+    setDiagonalInertia((b2 + c2) / 3.0, (a2 + c2) / 3.0, (a2 + b2) / 3.0);
+    boundingRadius = halfExtents.magnitude();
+}
+
+// 캡슐: 원통 + 양 끝 반구 (반구는 평행축 정리로 이동)
+CapsuleShape::CapsuleShape(double radius, double halfHeight)
+    : CollisionShape(ShapeType::Capsule), radius(radius), halfHeight(halfHeight)
+{
+    const double pi = Constants<double>::PI;
+    double r2 = radius * radius;
+    double height = 2.0 * halfHeight;
+    double cylinderVolume = pi * r2 * height;
+    double sphereVolume = 4.0 / 3.0 * pi * r2 * radius;
+    volume = cylinderVolume + sphereVolume;
+
+    double mc = cylinderVolume / volume;
+    double ms = sphereVolume / volume;
+    double iy = mc * (r2 / 2.0) + ms * (0.4 * r2);
+    double ix = mc * (height * height / 12.0 + r2 / 4.0)
+        + ms * (0.4 * r2 + height * height / 4.0 + 3.0 * height * radius / 8.0);
+    setDiagonalInertia(ix, iy, ix);
+    boundingRadius = radius + halfHeight;
+}
+
+// 원기둥: I_y = r^2 / 2, I_x = (3 r^2 + h^2) / 12
+CylinderShape::CylinderShape(double radius, double halfHeight)
+    : CollisionShape(ShapeType::Cylinder), radius(radius), halfHeight(halfHeight)
+{
+    double r2 = radius * radius;
+    double height = 2.0 * halfHeight;
+    volume = Constants<double>::PI * r2 * height;
+    double ix = (3.0 * r2 + height * height) / 12.0;
+    setDiagonalInertia(ix, r2 / 2.0, ix);
+    boundingRadius = std::sqrt(r2 + halfHeight * halfHeight);
+}
+
+// 볼록 껍질: 원점과 각 면으로 이루어진 사면체의 부호 있는 부피/공분산을 합산
+ConvexHullShape::ConvexHullShape(const std::vector<Vector3<double>>& vertices, const std::vector<unsigned int>& triangles)
+    : CollisionShape(ShapeType::ConvexHull), vertices(vertices), triangles(triangles)
+{
+    if (triangles.size() < 12 || triangles.size() % 3 != 0) {
+        throw std::invalid_argument("ConvexHullShape requires at least four triangles");
+    }
+
+    // 표준 사면체 (0, e1, e2, e3) 의 공분산 (밀도 1, 부피 1/6 기준 120 배)
+    const Matrix3x3<double> canonical(
+        2.0, 1.0, 1.0,
+        1.0, 2.0, 1.0,
+        1.0, 1.0, 2.0
+    );
+
+    double totalVolume = 0.0;
+    Vector3<double> weightedCenter;
+    Matrix3x3<double> covariance;
+    for (std::size_t t = 0; t < triangles.size(); t += 3) {
+        const Vector3<double>& a = vertices.at(triangles[t]);
+        const Vector3<double>& b = vertices.at(triangles[t + 1]);
+        const Vector3<double>& c = vertices.at(triangles[t + 2]);
+
+        // 열 벡터가 a, b, c 인 행렬
+        Matrix3x3<double> columns(
+            a.x, b.x, c.x,
+            a.y, b.y, c.y,
+            a.z, b.z, c.z
+        );
+        double determinant = columns.determinant();
+        double tetraVolume = determinant / 6.0;
+
+        totalVolume += tetraVolume;
+        weightedCenter += (a + b + c) * (tetraVolume / 4.0);
+        covariance += columns * canonical * columns.transpose() * (determinant / 120.0);
+    }
+
+    if (totalVolume <= Constants<double>::TOLERANCE) {
+        throw std::invalid_argument("ConvexHullShape has non-positive volume (check triangle winding)");
+    }
+
+    volume = totalVolume;
+    centerOfMass = weightedCenter / totalVolume;
+
+    // 질량 중심으로 이동한 뒤 단위 질량으로 정규화
+    covariance -= Matrix3x3<double>::outerProduct(centerOfMass, centerOfMass) * totalVolume;
+    setInertia(inertiaFromCovariance(covariance) / totalVolume);
+
+    for (const auto& v : vertices) {
+        boundingRadius = std::max(boundingRadius, v.magnitude());
+    }
+}
+
+// 복합 형상: 자식 관성을 회전 R I Rᵀ 후 평행축 정리로 합산
+CompoundShape::CompoundShape(const std::vector<Child>& children)
+    : CollisionShape(ShapeType::Compound), children(children)
+{
+    if (children.empty()) {
+        throw std::invalid_argument("CompoundShape requires at least one child");
+    }
+
+    Vector3<double> weightedCenter;
+    for (const auto& child : children) {
+        Vector3<double> childCenter = child.position + child.orientation.qRotate(child.shape->getCenterOfMass());
+        volume += child.shape->getVolume();
+        weightedCenter += childCenter * child.shape->getVolume();
+    }
+    centerOfMass = weightedCenter / volume;
+
+    Matrix3x3<double> inertia;
+    for (const auto& child : children) {
+        double childVolume = child.shape->getVolume();
+        Matrix3x3<double> rotation = child.orientation.toMatrix3x3();
+        Vector3<double> d = child.position + child.orientation.qRotate(child.shape->getCenterOfMass()) - centerOfMass;
+
+        inertia += rotation * child.shape->getUnitInertia() * rotation.transpose() * childVolume;
+        inertia += (Matrix3x3<double>::identity() * (d * d) - Matrix3x3<double>::outerProduct(d, d)) * childVolume;
+
+        boundingRadius = std::max(boundingRadius, child.position.magnitude() + child.shape->getBoundingRadius());
+    }
+    setInertia(inertia / volume);
+}
+
+std::mutex ShapeCache::mutex;
+std::map<ShapeCache::Key, std::weak_ptr<const CollisionShape>> ShapeCache::shapes;
+
+template<typename Factory>
+std::shared_ptr<const CollisionShape> ShapeCache::findOrCreate(const Key& key, Factory create) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = shapes.find(key);
+    if (it != shapes.end()) {
+        if (auto shape = it->second.lock()) {
+            return shape;
+        }
+    }
+    std::shared_ptr<const CollisionShape> shape = create();
+    shapes[key] = shape;
+    return shape;
+}
+
+std::shared_ptr<const CollisionShape> ShapeCache::sphere(double radius) {
+    return findOrCreate(Key(static_cast<int>(ShapeType::Sphere), radius, 0.0, 0.0),
+        [&] { return std::make_shared<const SphereShape>(radius); });
+}
+
+std::shared_ptr<const CollisionShape> ShapeCache::box(const Vector3<double>& halfExtents) {
+    return findOrCreate(Key(static_cast<int>(ShapeType::Box), halfExtents.x, halfExtents.y, halfExtents.z),
+        [&] { return std::make_shared<const BoxShape>(halfExtents); });
+}
+
+std::shared_ptr<const CollisionShape> ShapeCache::capsule(double radius, double halfHeight) {
+    return findOrCreate(Key(static_cast<int>(ShapeType::Capsule), radius, halfHeight, 0.0),
+        [&] { return std::make_shared<const CapsuleShape>(radius, halfHeight); });
+}
+
+std::shared_ptr<const CollisionShape> ShapeCache::cylinder(double radius, double halfHeight) {
+    return findOrCreate(Key(static_cast<int>(ShapeType::Cylinder), radius, halfHeight, 0.0),
+        [&] { return std::make_shared<const CylinderShape>(radius, halfHeight); });
+}
+
+#endif // COLLISIONSHAPE_CPP
@@ -0,0 +1,145 @@
+﻿#ifndef COMMANDQUEUE_CPP
+#define COMMANDQUEUE_CPP
+
+#include <algorithm>
+#include <cstdint>
+#include "CommandQueue.h"
+#include "PhysicsObject.h"
+
+CommandQueue::CommandQueue(std::size_t capacity)
+    : mask(0), enqueuePosition(0), dequeuePosition(0)
+{
+    std::size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool CommandQueue::push(const BodyCommand& command) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[position & mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0) {
+            // 빈 셀: 쓰기 위치를 예약 (실패하면 position 이 최신 값으로 바뀜)
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            return false;   // 한 바퀴 앞의 명령이 아직 소비되지 않음
+        }
+        else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    cell->command = command;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool CommandQueue::pushVector(BodyCommandType type, BodyHandle body, const Vector3<double>& v) {
+    BodyCommand command{};
+    command.type = type;
+    command.body = body;
+    command.vector = v;
+    return push(command);
+}
+
+bool CommandQueue::setOrientation(BodyHandle body, const Quaternion<double>& q) {
+    BodyCommand command{};
+    command.type = BodyCommandType::SetOrientation;
+    command.body = body;
+    command.orientation = q;
+    return push(command);
+}
+
+std::size_t CommandQueue::drain(std::vector<BodyCommand>& out) {
+    std::size_t count = 0;
+    for (;;) {
+        Cell& cell = cells[dequeuePosition & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            break;  // 비었거나 예약만 되고 아직 채워지지 않은 셀
+        }
+        out.push_back(cell.command);
+        cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        ++dequeuePosition;
+        ++count;
+    }
+    return count;
+}
+
+namespace {
+    // 한 물체에 대해 합쳐진 명령
+    struct CoalescedCommand {
+        Vector3<double> force;
+        Vector3<double> torque;
+        Vector3<double> impulse;
+        Vector3<double> position;
+        Quaternion<double> orientation;
+        Vector3<double> velocity;
+        Vector3<double> angularVelocity;
+        bool hasForce, hasTorque, hasImpulse;
+        bool hasPosition, hasOrientation, hasVelocity, hasAngularVelocity;
+
+        void add(const BodyCommand& c) {
+            switch (c.type) {
+            case BodyCommandType::ApplyForce: force += c.vector; hasForce = true; break;
+            case BodyCommandType::ApplyTorque: torque += c.vector; hasTorque = true; break;
+            case BodyCommandType::ApplyImpulse: impulse += c.vector; hasImpulse = true; break;
+            case BodyCommandType::SetPosition: position = c.vector; hasPosition = true; break;
+            case BodyCommandType::SetOrientation: orientation = c.orientation; hasOrientation = true; break;
+            case BodyCommandType::SetVelocity:
+                velocity = c.vector;
+                hasVelocity = true;
+                impulse = Vector3<double>(0.0, 0.0, 0.0);
+                hasImpulse = false;
+                break;
+            case BodyCommandType::SetAngularVelocity: angularVelocity = c.vector; hasAngularVelocity = true; break;
+            }
+        }
+
+        void applyTo(PhysicsObject& body) const {
+            body.setSleeping(false);
+            if (hasPosition) body.setPosition(position);
+            if (hasOrientation) body.setOrientation(orientation);
+            if (hasVelocity) body.setVelocity(velocity);
+            if (hasAngularVelocity) body.setAngularVelocity(angularVelocity);
+            if (hasImpulse) body.applyImpulse(impulse, Vector3<double>(0.0, 0.0, 0.0));
+            if (hasForce) body.applyForce(force);
+            if (hasTorque) body.applyTorque(torque);
+        }
+    };
+}
+
+std::size_t applyBodyCommands(std::vector<BodyCommand>& commands, const HandlePool& handles, PhysicsObject* bodies) {
+    // 오래된 핸들은 NO_SLOT 이므로 끝으로 모인다
+    std::stable_sort(commands.begin(), commands.end(), [&handles](const BodyCommand& a, const BodyCommand& b) {
+        return handles.getSlot(a.body) < handles.getSlot(b.body);
+    });
+
+    std::size_t applied = 0;
+    std::size_t i = 0;
+    while (i < commands.size()) {
+        std::size_t slot = handles.getSlot(commands[i].body);
+        if (slot == HandlePool::NO_SLOT) {
+            break;
+        }
+        CoalescedCommand merged{};
+        for (; i < commands.size() && handles.getSlot(commands[i].body) == slot; ++i) {
+            merged.add(commands[i]);
+        }
+        merged.applyTo(bodies[slot]);
+        ++applied;
+    }
+    return applied;
+}
+
+#endif // COMMANDQUEUE_CPP
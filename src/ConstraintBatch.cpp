@@ -0,0 +1,81 @@
+﻿#ifndef CONSTRAINTBATCH_CPP
+#define CONSTRAINTBATCH_CPP
+
+#include "ConstraintBatch.h"
+
+void ConstraintBatcher::build(const std::vector<PhysicsObject>& bodies,
+    const std::vector<Contact>& contacts,
+    const std::vector<std::size_t>& islandContacts)
+{
+    bodyColors.assign(bodies.size(), 0);
+    for (auto& list : colorContacts) {
+        list.clear();
+    }
+    overflow.clear();
+
+    auto colorMask = [&](std::size_t body) -> std::uint64_t {
+        // 정적 물체는 속도가 바뀌지 않으므로 충돌을 일으키지 않는다
+        if (body == Contact::STATIC_BODY || bodies[body].isStatic()) {
+            return 0;
+        }
+        return bodyColors[body];
+    };
+
+    // 탐욕적 색칠: 두 물체 모두에서 사용하지 않은 가장 작은 색
+    std::size_t colorCount = 0;
+    for (std::size_t c : islandContacts) {
+        const Contact& contact = contacts[c];
+        std::uint64_t used = colorMask(contact.bodyA) | colorMask(contact.bodyB);
+        if (used == ~static_cast<std::uint64_t>(0)) {
+            overflow.push_back(c);
+            continue;
+        }
+
+        std::size_t color = 0;
+        while (used & (static_cast<std::uint64_t>(1) << color)) {
+            ++color;
+        }
+        std::uint64_t bit = static_cast<std::uint64_t>(1) << color;
+        if (contact.bodyA != Contact::STATIC_BODY && !bodies[contact.bodyA].isStatic()) {
+            bodyColors[contact.bodyA] |= bit;
+        }
+        if (contact.bodyB != Contact::STATIC_BODY && !bodies[contact.bodyB].isStatic()) {
+            bodyColors[contact.bodyB] |= bit;
+        }
+
+        if (color >= colorContacts.size()) {
+            colorContacts.resize(color + 1);
+        }
+        colorContacts[color].push_back(c);
+        if (color + 1 > colorCount) {
+            colorCount = color + 1;
+        }
+    }
+
+    // 색마다 LANES 개씩 배치로 묶기 (남는 레인은 EMPTY_LANE)
+    batches.clear();
+    colorOffsets.assign(1, 0);
+    for (std::size_t color = 0; color < colorCount; ++color) {
+        const auto& list = colorContacts[color];
+        for (std::size_t first = 0; first < list.size(); first += ContactBatch::LANES) {
+            ContactBatch batch;
+            for (std::size_t lane = 0; lane < ContactBatch::LANES; ++lane) {
+                std::size_t index = first + lane;
+                if (index < list.size()) {
+                    batch.contact[lane] = list[index];
+                    batch.bodyA[lane] = contacts[list[index]].bodyA;
+                    batch.bodyB[lane] = contacts[list[index]].bodyB;
+                }
+                else {
+                    batch.contact[lane] = ContactBatch::EMPTY_LANE;
+                    batch.bodyA[lane] = Contact::STATIC_BODY;
+                    batch.bodyB[lane] = Contact::STATIC_BODY;
+                }
+            }
+            batches.push_back(batch);
+        }
+        colorOffsets.push_back(batches.size());
+    }
+}
+
+#endif // CONSTRAINTBATCH_CPP
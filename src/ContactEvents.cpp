@@ -0,0 +1,60 @@
+﻿#ifndef CONTACTEVENTS_CPP
+#define CONTACTEVENTS_CPP
+
+#include <algorithm>
+#include "ContactEvents.h"
+
+void ContactEventBuffer::update(const std::vector<Contact>& contacts, const std::vector<BodyHandle>& bodyHandles) {
+    auto toHandle = [&bodyHandles](std::size_t body) {
+        return body != Contact::STATIC_BODY ? bodyHandles[body] : getStaticHandle();
+    };
+
+    // 이번 스텝의 접촉 쌍을 (작은 핸들, 큰 핸들) 순으로 정규화하여 정렬
+    currentPairs.clear();
+    for (const auto& c : contacts) {
+        PairRecord record{ toHandle(c.bodyA), toHandle(c.bodyB), c.point, c.normal, c.normalImpulse, c.tangentImpulse };
+        if (record.bodyB < record.bodyA) {
+            std::swap(record.bodyA, record.bodyB);
+            record.normal = -record.normal;
+        }
+        currentPairs.push_back(record);
+    }
+    std::sort(currentPairs.begin(), currentPairs.end());
+
+    // 정렬된 두 목록을 병합하며 이벤트 생성
+    events.clear();
+    auto emit = [this](ContactEventType type, const PairRecord& r, bool keepImpulse) {
+        events.push_back(ContactEvent{ type, r.bodyA, r.bodyB, r.point, r.normal,
+            keepImpulse ? r.normalImpulse : 0.0, keepImpulse ? r.tangentImpulse : 0.0 });
+    };
+
+    std::size_t p = 0;
+    std::size_t c = 0;
+    while (p < previousPairs.size() || c < currentPairs.size()) {
+        if (c == currentPairs.size() || (p < previousPairs.size() && previousPairs[p] < currentPairs[c])) {
+            emit(ContactEventType::End, previousPairs[p++], false);
+        }
+        else if (p == previousPairs.size() || currentPairs[c] < previousPairs[p]) {
+            emit(ContactEventType::Begin, currentPairs[c++], true);
+        }
+        else {
+            emit(ContactEventType::Persist, currentPairs[c++], true);
+            ++p;
+        }
+    }
+
+    previousPairs.swap(currentPairs);
+}
+
+void ContactEventBuffer::clear() {
+    events.clear();
+    previousPairs.clear();
+    currentPairs.clear();
+}
+
+void ContactEventBuffer::restorePreviousPairs(const PairRecord* pairs, std::size_t count) {
+    events.clear();
+    previousPairs.assign(pairs, pairs + count);
+}
+
+#endif // CONTACTEVENTS_CPP
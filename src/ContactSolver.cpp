@@ -0,0 +1,333 @@
+﻿#ifndef CONTACTSOLVER_CPP
+#define CONTACTSOLVER_CPP
+
+#include <algorithm>
+#include <cmath>
+#include "ContactSolver.h"
+#include "Constants.h"
+
+namespace {
+
+    // 고정 환경(STATIC_BODY)을 포함해 물체의 질량/속도 정보를 한 번에 읽기 위한 보조 구조체
+    struct BodyView {
+        PhysicsObject* body;
+        double inverseMass;
+        Matrix3x3<double> inverseInertia;
+        Vector3<double> position;
+
+        BodyView(std::vector<PhysicsObject>& bodies, std::size_t index)
+            : body(index == Contact::STATIC_BODY ? nullptr : &bodies[index]),
+            inverseMass(body ? body->getInverseMass() : 0.0),
+            inverseInertia(body ? body->getInverseInertiaWorld() : Matrix3x3<double>()),
+            position(body ? body->getPosition() : Vector3<double>())
+        {}
+
+        Vector3<double> velocityAt(const Vector3<double>& r) const {
+            if (!body) {
+                return Vector3<double>();
+            }
+            return body->getVelocity() + (body->getAngularVelocity() ^ r);
+        }
+
+        void applyImpulse(const Vector3<double>& impulse, const Vector3<double>& r) const {
+            if (body && inverseMass > 0.0) {
+                body->applyImpulse(impulse, r);
+            }
+        }
+
+        // 방향 d 에 대한 유효 역질량 기여분
+        double effectiveMass(const Vector3<double>& r, const Vector3<double>& d) const {
+            return inverseMass + ((inverseInertia * (r ^ d)) ^ r) * d;
+        }
+    };
+
+} // namespace
+
+ContactSolver::ContactSolver()
+    : velocityIterations(8), restitution(0.3), friction(0.5), baumgarte(0.2), penetrationSlop(0.005) {}
+
+void ContactSolver::solveIsland(std::vector<PhysicsObject>& bodies,
+    std::vector<Contact>& contacts,
+    const std::vector<DistanceJoint>& joints,
+    const Island& island,
+    double deltaTime) const
+{
+    for (std::size_t c : island.contacts) {
+        prepareContact(bodies, contacts[c]);
+    }
+
+    for (int it = 0; it < velocityIterations; ++it) {
+        for (std::size_t j : island.joints) {
+            solveJoint(bodies, joints[j], deltaTime);
+        }
+        for (std::size_t c : island.contacts) {
+            solveContact(bodies, contacts[c], deltaTime);
+        }
+    }
+}
+
+void ContactSolver::solveIslandBatched(std::vector<PhysicsObject>& bodies,
+    std::vector<Contact>& contacts,
+    const std::vector<DistanceJoint>& joints,
+    const Island& island,
+    ConstraintBatcher& batcher,
+    ThreadPool& threadPool,
+    double deltaTime) const
+{
+    batcher.build(bodies, contacts, island.contacts);
+    std::vector<ContactBatch>& batches = batcher.getBatches();
+    const std::vector<std::size_t>& overflow = batcher.getOverflow();
+
+    threadPool.parallelFor(batches.size(), [&](std::size_t b) {
+        prepareBatch(bodies, contacts, batches[b], deltaTime);
+    });
+    for (std::size_t c : overflow) {
+        prepareContact(bodies, contacts[c]);
+    }
+
+    // 색 단위로 순차 진행하고, 같은 색의 배치는 동시에 처리
+    for (int it = 0; it < velocityIterations; ++it) {
+        for (std::size_t j : island.joints) {
+            solveJoint(bodies, joints[j], deltaTime);
+        }
+        for (std::size_t color = 0; color < batcher.getColorCount(); ++color) {
+            std::size_t begin = batcher.getColorBegin(color);
+            threadPool.parallelFor(batcher.getColorEnd(color) - begin, [&](std::size_t b) {
+                solveBatch(bodies, batches[begin + b]);
+            });
+        }
+        for (std::size_t c : overflow) {
+            solveContact(bodies, contacts[c], deltaTime);
+        }
+    }
+
+    // 누적 충격량을 원본 접촉에 기록
+    for (const auto& batch : batches) {
+        for (std::size_t lane = 0; lane < ContactBatch::LANES; ++lane) {
+            if (batch.contact[lane] != ContactBatch::EMPTY_LANE) {
+                contacts[batch.contact[lane]].normalImpulse = batch.normalImpulse[lane];
+                contacts[batch.contact[lane]].tangentImpulse = batch.tangentImpulse[lane];
+            }
+        }
+    }
+}
+
+void ContactSolver::prepareBatch(std::vector<PhysicsObject>& bodies, std::vector<Contact>& contacts, ContactBatch& batch, double deltaTime) const {
+    for (std::size_t lane = 0; lane < ContactBatch::LANES; ++lane) {
+        batch.normalImpulse[lane] = 0.0;
+        batch.tangentImpulse[lane] = 0.0;
+
+        if (batch.contact[lane] == ContactBatch::EMPTY_LANE) {
+            // 빈 레인은 모든 계수를 0으로 두어 결과에 영향을 주지 않게 한다
+            Vector3<double> zero;
+            batch.normal.set(lane, zero);
+            batch.tangent.set(lane, zero);
+            batch.rAxN.set(lane, zero);
+            batch.rBxN.set(lane, zero);
+            batch.angularAN.set(lane, zero);
+            batch.angularBN.set(lane, zero);
+            batch.rAxT.set(lane, zero);
+            batch.rBxT.set(lane, zero);
+            batch.angularAT.set(lane, zero);
+            batch.angularBT.set(lane, zero);
+            batch.inverseMassA[lane] = 0.0;
+            batch.inverseMassB[lane] = 0.0;
+            batch.normalMass[lane] = 0.0;
+            batch.tangentMass[lane] = 0.0;
+            batch.targetVelocity[lane] = 0.0;
+            continue;
+        }
+
+        Contact& c = contacts[batch.contact[lane]];
+        prepareContact(bodies, c);
+
+        BodyView a(bodies, c.bodyA);
+        BodyView b(bodies, c.bodyB);
+        Vector3<double> rA = c.point - a.position;
+        Vector3<double> rB = c.point - b.position;
+
+        Vector3<double> rAxN = rA ^ c.normal;
+        Vector3<double> rBxN = rB ^ c.normal;
+        Vector3<double> rAxT = rA ^ c.tangent;
+        Vector3<double> rBxT = rB ^ c.tangent;
+
+        batch.normal.set(lane, c.normal);
+        batch.tangent.set(lane, c.tangent);
+        batch.rAxN.set(lane, rAxN);
+        batch.rBxN.set(lane, rBxN);
+        batch.angularAN.set(lane, a.inverseInertia * rAxN);
+        batch.angularBN.set(lane, b.inverseInertia * rBxN);
+        batch.rAxT.set(lane, rAxT);
+        batch.rBxT.set(lane, rBxT);
+        batch.angularAT.set(lane, a.inverseInertia * rAxT);
+        batch.angularBT.set(lane, b.inverseInertia * rBxT);
+        batch.inverseMassA[lane] = a.inverseMass;
+        batch.inverseMassB[lane] = b.inverseMass;
+
+        double kNormal = a.effectiveMass(rA, c.normal) + b.effectiveMass(rB, c.normal);
+        double kTangent = a.effectiveMass(rA, c.tangent) + b.effectiveMass(rB, c.tangent);
+        batch.normalMass[lane] = kNormal > 0.0 ? 1.0 / kNormal : 0.0;
+        batch.tangentMass[lane] = kTangent > 0.0 ? 1.0 / kTangent : 0.0;
+
+        double positionBias = baumgarte / deltaTime * std::max(c.penetration - penetrationSlop, 0.0);
+        batch.targetVelocity[lane] = std::max(c.velocityBias, positionBias);
+    }
+}
+
+void ContactSolver::solveBatch(std::vector<PhysicsObject>& bodies, ContactBatch& batch) const {
+    constexpr std::size_t N = ContactBatch::LANES;
+    LaneVector3<N> vA, wA, vB, wB;
+
+    // 모으기: 정적 물체와 빈 레인은 속도 0
+    for (std::size_t lane = 0; lane < N; ++lane) {
+        std::size_t a = batch.bodyA[lane];
+        std::size_t b = batch.bodyB[lane];
+        Vector3<double> zero;
+        vA.set(lane, a != Contact::STATIC_BODY ? bodies[a].getVelocity() : zero);
+        wA.set(lane, a != Contact::STATIC_BODY ? bodies[a].getAngularVelocity() : zero);
+        vB.set(lane, b != Contact::STATIC_BODY ? bodies[b].getVelocity() : zero);
+        wB.set(lane, b != Contact::STATIC_BODY ? bodies[b].getAngularVelocity() : zero);
+    }
+
+    // 법선 충격량 (레인 단위 연산: 분기 없는 루프로 벡터화)
+    const LaneVector3<N>& n = batch.normal;
+    for (std::size_t l = 0; l < N; ++l) {
+        double vn = n.x[l] * (vB.x[l] - vA.x[l]) + n.y[l] * (vB.y[l] - vA.y[l]) + n.z[l] * (vB.z[l] - vA.z[l])
+            + batch.rBxN.x[l] * wB.x[l] + batch.rBxN.y[l] * wB.y[l] + batch.rBxN.z[l] * wB.z[l]
+            - batch.rAxN.x[l] * wA.x[l] - batch.rAxN.y[l] * wA.y[l] - batch.rAxN.z[l] * wA.z[l];
+        double lambda = (batch.targetVelocity[l] - vn) * batch.normalMass[l];
+        double accumulated = std::max(batch.normalImpulse[l] + lambda, 0.0);
+        lambda = accumulated - batch.normalImpulse[l];
+        batch.normalImpulse[l] = accumulated;
+
+        double la = lambda * batch.inverseMassA[l];
+        double lb = lambda * batch.inverseMassB[l];
+        vA.x[l] -= n.x[l] * la; vA.y[l] -= n.y[l] * la; vA.z[l] -= n.z[l] * la;
+        vB.x[l] += n.x[l] * lb; vB.y[l] += n.y[l] * lb; vB.z[l] += n.z[l] * lb;
+        wA.x[l] -= batch.angularAN.x[l] * lambda; wA.y[l] -= batch.angularAN.y[l] * lambda; wA.z[l] -= batch.angularAN.z[l] * lambda;
+        wB.x[l] += batch.angularBN.x[l] * lambda; wB.y[l] += batch.angularBN.y[l] * lambda; wB.z[l] += batch.angularBN.z[l] * lambda;
+    }
+
+    // 마찰 충격량
+    const LaneVector3<N>& t = batch.tangent;
+    for (std::size_t l = 0; l < N; ++l) {
+        double vt = t.x[l] * (vB.x[l] - vA.x[l]) + t.y[l] * (vB.y[l] - vA.y[l]) + t.z[l] * (vB.z[l] - vA.z[l])
+            + batch.rBxT.x[l] * wB.x[l] + batch.rBxT.y[l] * wB.y[l] + batch.rBxT.z[l] * wB.z[l]
+            - batch.rAxT.x[l] * wA.x[l] - batch.rAxT.y[l] * wA.y[l] - batch.rAxT.z[l] * wA.z[l];
+        double maxFriction = friction * batch.normalImpulse[l];
+        double lambda = -vt * batch.tangentMass[l];
+        double accumulated = std::clamp(batch.tangentImpulse[l] + lambda, -maxFriction, maxFriction);
+        lambda = accumulated - batch.tangentImpulse[l];
+        batch.tangentImpulse[l] = accumulated;
+
+        double la = lambda * batch.inverseMassA[l];
+        double lb = lambda * batch.inverseMassB[l];
+        vA.x[l] -= t.x[l] * la; vA.y[l] -= t.y[l] * la; vA.z[l] -= t.z[l] * la;
+        vB.x[l] += t.x[l] * lb; vB.y[l] += t.y[l] * lb; vB.z[l] += t.z[l] * lb;
+        wA.x[l] -= batch.angularAT.x[l] * lambda; wA.y[l] -= batch.angularAT.y[l] * lambda; wA.z[l] -= batch.angularAT.z[l] * lambda;
+        wB.x[l] += batch.angularBT.x[l] * lambda; wB.y[l] += batch.angularBT.y[l] * lambda; wB.z[l] += batch.angularBT.z[l] * lambda;
+    }
+
+    // 흩뿌리기: 같은 배치의 레인은 동적 물체를 공유하지 않는다
+    for (std::size_t lane = 0; lane < N; ++lane) {
+        std::size_t a = batch.bodyA[lane];
+        std::size_t b = batch.bodyB[lane];
+        if (batch.inverseMassA[lane] > 0.0) {
+            bodies[a].setVelocity(vA.get(lane));
+            bodies[a].setAngularVelocity(wA.get(lane));
+        }
+        if (batch.inverseMassB[lane] > 0.0) {
+            bodies[b].setVelocity(vB.get(lane));
+            bodies[b].setAngularVelocity(wB.get(lane));
+        }
+    }
+}
+
+void ContactSolver::prepareContact(std::vector<PhysicsObject>& bodies, Contact& c) const {
+    BodyView a(bodies, c.bodyA);
+    BodyView b(bodies, c.bodyB);
+    Vector3<double> rA = c.point - a.position;
+    Vector3<double> rB = c.point - b.position;
+
+    Vector3<double> relative = b.velocityAt(rB) - a.velocityAt(rA);
+    double vn = relative * c.normal;
+
+    // 충분히 빠르게 접근할 때만 반발을 적용 (정지 접촉의 떨림 방지)
+    c.velocityBias = vn < -1.0 ? -restitution * vn : 0.0;
+    c.normalImpulse = 0.0;
+    c.tangentImpulse = 0.0;
+
+    // 마찰 방향: 상대 속도의 접선 성분
+    c.tangent = relative - c.normal * vn;
+    c.tangent.normalize();
+}
+
+void ContactSolver::solveContact(std::vector<PhysicsObject>& bodies, Contact& c, double deltaTime) const {
+    BodyView a(bodies, c.bodyA);
+    BodyView b(bodies, c.bodyB);
+    Vector3<double> rA = c.point - a.position;
+    Vector3<double> rB = c.point - b.position;
+
+    // 법선 방향 충격량
+    double kNormal = a.effectiveMass(rA, c.normal) + b.effectiveMass(rB, c.normal);
+    if (kNormal <= 0.0) {
+        return;
+    }
+    double vn = (b.velocityAt(rB) - a.velocityAt(rA)) * c.normal;
+    double positionBias = baumgarte / deltaTime * std::max(c.penetration - penetrationSlop, 0.0);
+    double target = std::max(c.velocityBias, positionBias);
+
+    double lambda = (target - vn) / kNormal;
+    double previous = c.normalImpulse;
+    c.normalImpulse = std::max(previous + lambda, 0.0);
+    lambda = c.normalImpulse - previous;
+
+    Vector3<double> impulse = c.normal * lambda;
+    a.applyImpulse(-impulse, rA);
+    b.applyImpulse(impulse, rB);
+
+    // 쿨롱 마찰
+    if (c.tangent.x == 0.0 && c.tangent.y == 0.0 && c.tangent.z == 0.0) {
+        return;
+    }
+    double kTangent = a.effectiveMass(rA, c.tangent) + b.effectiveMass(rB, c.tangent);
+    if (kTangent <= 0.0) {
+        return;
+    }
+    double vt = (b.velocityAt(rB) - a.velocityAt(rA)) * c.tangent;
+    double maxFriction = friction * c.normalImpulse;
+    double lambdaT = -vt / kTangent;
+    double previousT = c.tangentImpulse;
+    c.tangentImpulse = std::clamp(previousT + lambdaT, -maxFriction, maxFriction);
+    lambdaT = c.tangentImpulse - previousT;
+
+    Vector3<double> frictionImpulse = c.tangent * lambdaT;
+    a.applyImpulse(-frictionImpulse, rA);
+    b.applyImpulse(frictionImpulse, rB);
+}
+
+void ContactSolver::solveJoint(std::vector<PhysicsObject>& bodies, const DistanceJoint& j, double deltaTime) const {
+    BodyView a(bodies, j.bodyA);
+    BodyView b(bodies, j.bodyB);
+
+    Vector3<double> axis = b.position - a.position;
+    double length = axis.magnitude();
+    if (length <= Constants<double>::TOLERANCE) {
+        return;
+    }
+    axis /= length;
+
+    double k = a.inverseMass + b.inverseMass;
+    if (k <= 0.0) {
+        return;
+    }
+    double vn = (b.velocityAt(Vector3<double>()) - a.velocityAt(Vector3<double>())) * axis;
+    double error = length - j.restLength;
+    double lambda = -(vn + baumgarte / deltaTime * error) / k;
+
+    Vector3<double> impulse = axis * lambda;
+    a.applyImpulse(-impulse, Vector3<double>());
+    b.applyImpulse(impulse, Vector3<double>());
+}
+
+#endif // CONTACTSOLVER_CPP
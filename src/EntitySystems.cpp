@@ -0,0 +1,145 @@
+﻿#ifndef ENTITYSYSTEMS_CPP
+#define ENTITYSYSTEMS_CPP
+
+#include "EntitySystems.h"
+#include "PhysicsObject.h"
+
+namespace {
+    const ComponentMask INERTIA_COMPONENTS = componentBit(ComponentType::Transform) | componentBit(ComponentType::Mass);
+    const ComponentMask GRAVITY_COMPONENTS = componentBit(ComponentType::Mass) | componentBit(ComponentType::Force);
+    const ComponentMask VELOCITY_COMPONENTS = componentBit(ComponentType::Velocity) | componentBit(ComponentType::Mass)
+        | componentBit(ComponentType::Force);
+    const ComponentMask POSITION_COMPONENTS = componentBit(ComponentType::Transform) | componentBit(ComponentType::Velocity)
+        | componentBit(ComponentType::Mass);
+    const ComponentMask GROUND_COMPONENTS = POSITION_COMPONENTS | componentBit(ComponentType::Shape)
+        | componentBit(ComponentType::Collider);
+}
+
+Mass makeMass(double mass, const Vector3<double>& scale, const CollisionShape* shape, bool isStatic) {
+    Mass result;
+    result.mass = mass;
+    Matrix3x3<double> inertia;
+    PhysicsObject::computeInertia(mass, scale, shape, inertia, result.inverseInertiaLocal);
+    if (isStatic) {
+        result.inverseMass = 0.0;
+        result.inverseInertiaLocal = Matrix3x3<double>();
+    }
+    else {
+        result.inverseMass = 1.0 / mass;
+    }
+    result.inverseInertiaWorld = result.inverseInertiaLocal;
+    return result;
+}
+
+Entity createRigidBody(EntityWorld& world, const PhysicsObject& body, const Collider& collider) {
+    Entity entity = world.create(RIGID_BODY_COMPONENTS);
+    const PhysicsObject::State& state = body.getState();
+    world.get<Transform>(entity) = Transform{ state.position, state.orientation, state.scale };
+    world.get<Velocity>(entity) = Velocity{ state.velocity, state.angularVelocity };
+
+    Mass& mass = world.get<Mass>(entity);
+    mass.mass = state.mass;
+    mass.inverseMass = body.getInverseMass();
+    mass.inverseInertiaLocal = body.getInverseInertiaTensor();
+    mass.inverseInertiaWorld = state.inverseInertiaWorld;
+
+    world.get<ForceAccumulator>(entity) = ForceAccumulator{ state.force, state.torque };
+    world.get<Shape>(entity) = Shape{ body.getShape(), body.getBoundingRadius() };
+    world.get<Collider>(entity) = collider;
+    return entity;
+}
+
+void updateWorldInertiaSystem(EntityWorld& world, ThreadPool& pool) {
+    world.forEachChunk(INERTIA_COMPONENTS, pool, [](EntityChunk& chunk) {
+        const Transform* transforms = chunk.get<Transform>();
+        Mass* masses = chunk.get<Mass>();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (masses[i].inverseMass == 0.0) {
+                continue;
+            }
+            Matrix3x3<double> rotation = transforms[i].orientation.toMatrix3x3();
+            masses[i].inverseInertiaWorld = rotation * masses[i].inverseInertiaLocal * rotation.transpose();
+        }
+    });
+}
+
+void gravitySystem(EntityWorld& world, ThreadPool& pool, const Vector3<double>& gravity) {
+    world.forEachChunk(GRAVITY_COMPONENTS, pool, [&gravity](EntityChunk& chunk) {
+        const Mass* masses = chunk.get<Mass>();
+        ForceAccumulator* forces = chunk.get<ForceAccumulator>();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (masses[i].inverseMass != 0.0) {
+                forces[i].force += gravity * masses[i].mass;
+            }
+        }
+    });
+}
+
+// PhysicsObject::integrateVelocity 와 같은 순서의 연산 (a = F / m 후 속도, 이어서 각속도)
+void integrateVelocitySystem(EntityWorld& world, ThreadPool& pool, double deltaTime) {
+    world.forEachChunk(VELOCITY_COMPONENTS, pool, [deltaTime](EntityChunk& chunk) {
+        Velocity* velocities = chunk.get<Velocity>();
+        const Mass* masses = chunk.get<Mass>();
+        ForceAccumulator* forces = chunk.get<ForceAccumulator>();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (masses[i].inverseMass != 0.0) {
+                Vector3<double> acceleration = forces[i].force / masses[i].mass;
+                velocities[i].linear += acceleration * deltaTime;
+                velocities[i].angular += (masses[i].inverseInertiaWorld * forces[i].torque) * deltaTime;
+            }
+            forces[i].force = Vector3<double>(0.0, 0.0, 0.0);
+            forces[i].torque = Vector3<double>(0.0, 0.0, 0.0);
+        }
+    });
+}
+
+// PhysicsObject::integratePosition 과 같은 순서의 연산 (PhysicsWorld 처럼 정적 물체는 속도가 있어도 움직이지 않음)
+void integratePositionSystem(EntityWorld& world, ThreadPool& pool, double deltaTime) {
+    world.forEachChunk(POSITION_COMPONENTS, pool, [deltaTime](EntityChunk& chunk) {
+        Transform* transforms = chunk.get<Transform>();
+        const Velocity* velocities = chunk.get<Velocity>();
+        const Mass* masses = chunk.get<Mass>();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (masses[i].inverseMass == 0.0) {
+                continue;
+            }
+            transforms[i].position += velocities[i].linear * deltaTime;
+            Quaternion<double> deltaRotation = Quaternion<double>::fromAngularVelocity(velocities[i].angular, deltaTime);
+            transforms[i].orientation = deltaRotation * transforms[i].orientation;
+            transforms[i].orientation.normalize();
+        }
+    });
+}
+
+void groundCollisionSystem(EntityWorld& world, ThreadPool& pool, double groundHeight) {
+    world.forEachChunk(GROUND_COMPONENTS, pool, [groundHeight](EntityChunk& chunk) {
+        Transform* transforms = chunk.get<Transform>();
+        Velocity* velocities = chunk.get<Velocity>();
+        const Mass* masses = chunk.get<Mass>();
+        const Shape* shapes = chunk.get<Shape>();
+        const Collider* colliders = chunk.get<Collider>();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (masses[i].inverseMass == 0.0) {
+                continue;
+            }
+            double bottom = transforms[i].position.y - shapes[i].boundingRadius;
+            if (bottom >= groundHeight) {
+                continue;
+            }
+            transforms[i].position.y += groundHeight - bottom;
+            if (velocities[i].linear.y < 0.0) {
+                velocities[i].linear.y = -velocities[i].linear.y * colliders[i].restitution;
+            }
+        }
+    });
+}
+
+void stepRigidBodySystems(EntityWorld& world, ThreadPool& pool, double deltaTime, const Vector3<double>& gravity, double groundHeight) {
+    updateWorldInertiaSystem(world, pool);
+    gravitySystem(world, pool, gravity);
+    integrateVelocitySystem(world, pool, deltaTime);
+    integratePositionSystem(world, pool, deltaTime);
+    groundCollisionSystem(world, pool, groundHeight);
+}
+
+#endif // ENTITYSYSTEMS_CPP
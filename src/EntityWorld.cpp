@@ -0,0 +1,194 @@
+﻿#ifndef ENTITYWORLD_CPP
+#define ENTITYWORLD_CPP
+
+#include <type_traits>
+#include "EntityWorld.h"
+#include "PhysicsObject.h"
+
+namespace {
+    // 새 행의 구성 요소 기본값 (PhysicsObject 기본 생성자와 같은 상태)
+    template<typename T> T defaultComponent();
+
+    template<> Transform defaultComponent<Transform>() {
+        return Transform{ Vector3<double>(0.0, 0.0, 0.0), Quaternion<double>(1.0, 0.0, 0.0, 0.0), Vector3<double>(1.0, 1.0, 1.0) };
+    }
+
+    template<> Velocity defaultComponent<Velocity>() {
+        return Velocity{ Vector3<double>(0.0, 0.0, 0.0), Vector3<double>(0.0, 0.0, 0.0) };
+    }
+
+    template<> Mass defaultComponent<Mass>() {
+        Mass mass;
+        mass.mass = 1.0;
+        mass.inverseMass = 1.0;
+        Matrix3x3<double> inertia;
+        PhysicsObject::computeInertia(1.0, Vector3<double>(1.0, 1.0, 1.0), nullptr, inertia, mass.inverseInertiaLocal);
+        mass.inverseInertiaWorld = mass.inverseInertiaLocal;
+        return mass;
+    }
+
+    template<> ForceAccumulator defaultComponent<ForceAccumulator>() {
+        return ForceAccumulator{ Vector3<double>(0.0, 0.0, 0.0), Vector3<double>(0.0, 0.0, 0.0) };
+    }
+
+    template<> Shape defaultComponent<Shape>() {
+        return Shape{ nullptr, 1.0 };
+    }
+
+    template<> Collider defaultComponent<Collider>() {
+        return Collider{ 0.8, 0.5, 0 };
+    }
+}
+
+EntityChunk::EntityChunk(ComponentMask mask) : mask(mask) {
+    entities.reserve(CAPACITY);
+    forEachColumn([](auto& column) { column.reserve(CAPACITY); });
+}
+
+std::size_t EntityChunk::pushRow(Entity entity) {
+    entities.push_back(entity);
+    forEachColumn([](auto& column) {
+        typedef typename std::decay<decltype(column)>::type::value_type Component;
+        column.push_back(defaultComponent<Component>());
+    });
+    return entities.size() - 1;
+}
+
+void EntityChunk::moveRow(EntityChunk& from, std::size_t fromRow, std::size_t toRow) {
+    entities[toRow] = from.entities[fromRow];
+    if (has<Transform>()) transforms[toRow] = from.transforms[fromRow];
+    if (has<Velocity>()) velocities[toRow] = from.velocities[fromRow];
+    if (has<Mass>()) masses[toRow] = from.masses[fromRow];
+    if (has<ForceAccumulator>()) forces[toRow] = from.forces[fromRow];
+    if (has<Shape>()) shapes[toRow] = std::move(from.shapes[fromRow]);
+    if (has<Collider>()) colliders[toRow] = from.colliders[fromRow];
+}
+
+void EntityChunk::copyShared(const EntityChunk& from, std::size_t fromRow, std::size_t toRow) {
+    ComponentMask shared = mask & from.mask;
+    if (shared & componentBit<Transform>()) transforms[toRow] = from.transforms[fromRow];
+    if (shared & componentBit<Velocity>()) velocities[toRow] = from.velocities[fromRow];
+    if (shared & componentBit<Mass>()) masses[toRow] = from.masses[fromRow];
+    if (shared & componentBit<ForceAccumulator>()) forces[toRow] = from.forces[fromRow];
+    if (shared & componentBit<Shape>()) shapes[toRow] = from.shapes[fromRow];
+    if (shared & componentBit<Collider>()) colliders[toRow] = from.colliders[fromRow];
+}
+
+void EntityChunk::popRow() {
+    entities.pop_back();
+    forEachColumn([](auto& column) { column.pop_back(); });
+}
+
+EntityWorld::EntityWorld() {}
+
+std::uint32_t EntityWorld::findArchetype(ComponentMask mask) {
+    for (std::size_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i]->mask == mask) {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    std::unique_ptr<Archetype> archetype(new Archetype());
+    archetype->mask = mask;
+    archetype->activeChunks = 0;
+    archetypes.push_back(std::move(archetype));
+    return static_cast<std::uint32_t>(archetypes.size() - 1);
+}
+
+// 원형의 마지막 청크 끝에 행을 잡는다 (가득 찼으면 보관해 둔 빈 청크를 쓰고, 없을 때만 새로 만든다)
+EntityChunk& EntityWorld::allocateRow(std::uint32_t archetypeIndex, Entity entity, Record& record) {
+    Archetype& archetype = *archetypes[archetypeIndex];
+    if (archetype.activeChunks == 0 || archetype.chunks[archetype.activeChunks - 1]->isFull()) {
+        if (archetype.activeChunks == archetype.chunks.size()) {
+            archetype.chunks.push_back(std::unique_ptr<EntityChunk>(new EntityChunk(archetype.mask)));
+        }
+        ++archetype.activeChunks;
+    }
+    EntityChunk& chunk = *archetype.chunks[archetype.activeChunks - 1];
+    record.archetype = archetypeIndex;
+    record.chunk = static_cast<std::uint32_t>(archetype.activeChunks - 1);
+    record.row = static_cast<std::uint32_t>(chunk.pushRow(entity));
+    return chunk;
+}
+
+// 원형의 마지막 엔티티를 record 의 행으로 옮기고 마지막 행을 지운다
+void EntityWorld::releaseRow(const Record& record) {
+    Archetype& archetype = *archetypes[record.archetype];
+    EntityChunk& last = *archetype.chunks[archetype.activeChunks - 1];
+    std::size_t lastRow = last.size() - 1;
+    if (record.chunk != archetype.activeChunks - 1 || record.row != lastRow) {
+        EntityChunk& hole = chunkOf(record);
+        hole.moveRow(last, lastRow, record.row);
+        Record& moved = recordOf(hole.entities[record.row]);
+        moved.chunk = record.chunk;
+        moved.row = record.row;
+    }
+    last.popRow();
+    if (last.size() == 0) {
+        --archetype.activeChunks;
+    }
+}
+
+Entity EntityWorld::create(ComponentMask mask) {
+    Entity entity = handles.create();
+    records.push_back(Record{ 0, 0, 0 });
+    allocateRow(findArchetype(mask), entity, records.back());
+    return entity;
+}
+
+// 청크 행을 비운 뒤 핸들을 해제하고, 위치 기록도 핸들 슬롯과 같이 마지막 것을 빈자리로 옮긴다
+bool EntityWorld::destroy(Entity entity) {
+    if (!isValid(entity)) {
+        return false;
+    }
+    releaseRow(recordOf(entity));
+    swapRemove(records, handles.destroy(entity));
+    return true;
+}
+
+ComponentMask EntityWorld::getMask(Entity entity) const {
+    return isValid(entity) ? archetypes[records[handles.getSlot(entity)].archetype]->mask : 0;
+}
+
+const EntityWorld::Record& EntityWorld::requireRecord(Entity entity) const {
+    if (!isValid(entity)) {
+        throw std::invalid_argument("EntityWorld stale or invalid entity");
+    }
+    return records[handles.getSlot(entity)];
+}
+
+// 새 원형에 행을 잡아 공통 구성 요소를 복사한 뒤 이전 원형의 행을 지운다
+void EntityWorld::changeMask(Entity entity, ComponentMask mask) {
+    Record previous = recordOf(entity);
+    std::uint32_t target = findArchetype(mask);
+    Record& record = recordOf(entity);
+    EntityChunk& chunk = allocateRow(target, entity, record);
+    chunk.copyShared(chunkOf(previous), previous.row, record.row);
+    releaseRow(previous);
+}
+
+void EntityWorld::getChunks(ComponentMask required, std::vector<EntityChunk*>& out) {
+    out.clear();
+    for (const std::unique_ptr<Archetype>& archetype : archetypes) {
+        if ((archetype->mask & required) != required) {
+            continue;
+        }
+        for (std::size_t c = 0; c < archetype->activeChunks; ++c) {
+            out.push_back(archetype->chunks[c].get());
+        }
+    }
+}
+
+void EntityWorld::forEachChunk(ComponentMask required, ThreadPool& pool, const std::function<void(EntityChunk&)>& task) {
+    getChunks(required, chunkScratch);
+    pool.parallelFor(chunkScratch.size(), [this, &task](std::size_t c) {
+        task(*chunkScratch[c]);
+    });
+}
+
+void EntityWorld::clear() {
+    archetypes.clear();
+    handles.clear();
+    records.clear();
+}
+
+#endif // ENTITYWORLD_CPP
@@ -0,0 +1,259 @@
+﻿#ifndef EXPLOSION_CPP
+#define EXPLOSION_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Explosion.h"
+#include "Constants.h"
+
+namespace {
+    const std::uint32_t NO_BUCKET = 0xFFFFFFFFu;
+
+    long long cellOf(double coordinate, double cellSize) {
+        return static_cast<long long>(std::floor(coordinate / cellSize));
+    }
+
+    // 폭심에 가장 가까운 물체 표면(또는 내부)의 점
+    Vector3<double> closestPoint(const PhysicsObject& body, const Vector3<double>& center) {
+        Vector3<double> position = body.getPosition();
+        std::shared_ptr<const CollisionShape> shape = body.getShape();
+
+        bool isBox = false;
+        Vector3<double> half;
+        if (shape && shape->getType() == ShapeType::Box) {
+            half = static_cast<const BoxShape&>(*shape).getHalfExtents();
+            isBox = true;
+        }
+        else if (!shape) {
+            Vector3<double> scale = body.getScale();
+            if (!(scale.x == scale.y && scale.y == scale.z)) {
+                half = scale * 0.5;
+                isBox = true;
+            }
+        }
+
+        if (isBox) {
+            Matrix3x3<double> rotation = body.getOrientation().toMatrix3x3();
+            Vector3<double> local = rotation.transpose() * (center - position);
+            local.x = std::max(-half.x, std::min(half.x, local.x));
+            local.y = std::max(-half.y, std::min(half.y, local.y));
+            local.z = std::max(-half.z, std::min(half.z, local.z));
+            return position + rotation * local;
+        }
+
+        Vector3<double> delta = center - position;
+        double distance = delta.magnitude();
+        double radius = body.getBoundingRadius();
+        return distance > radius ? position + delta * (radius / distance) : center;
+    }
+}
+
+ExplosionSystem::ExplosionSystem()
+    : cellSize(0.0), occlusion(false), gridCellSize(1.0), maxBodyRadius(0.0) {}
+
+void ExplosionSystem::setOccluder(std::shared_ptr<const TriangleMesh> mesh, const Vector3<double>& origin) {
+    occluder = mesh;
+    occluderOrigin = origin;
+}
+
+void ExplosionSystem::queue(const Explosion& explosion) {
+    if (!(explosion.radius > 0.0)) {
+        throw std::invalid_argument("Explosion radius must be positive");
+    }
+    pending.push_back(explosion);
+}
+
+std::uint32_t ExplosionSystem::bucketOf(long long x, long long y, long long z) const {
+    unsigned long long h = static_cast<unsigned long long>(x) * 73856093ull
+        ^ static_cast<unsigned long long>(y) * 19349663ull
+        ^ static_cast<unsigned long long>(z) * 83492791ull;
+    return static_cast<std::uint32_t>(h & (bucketStart.size() - 2));
+}
+
+// 동적 물체 중심을 버킷 순으로 계수 정렬 (버킷 안은 물체 번호 순)
+void ExplosionSystem::buildGrid(const std::vector<PhysicsObject>& bodies) {
+    maxBodyRadius = 0.0;
+    std::size_t dynamicCount = 0;
+    for (const PhysicsObject& body : bodies) {
+        if (!body.isStatic()) {
+            maxBodyRadius = std::max(maxBodyRadius, body.getBoundingRadius());
+            ++dynamicCount;
+        }
+    }
+
+    gridCellSize = cellSize;
+    if (!(gridCellSize > 0.0)) {
+        double radiusSum = 0.0;
+        for (const Explosion& e : pending) {
+            radiusSum += e.radius;
+        }
+        gridCellSize = std::max(radiusSum / static_cast<double>(pending.size()), 2.0 * maxBodyRadius);
+    }
+
+    std::size_t bucketCount = 1;
+    while (bucketCount < 2 * dynamicCount) {
+        bucketCount <<= 1;
+    }
+    bucketStart.assign(bucketCount + 1, 0);
+    bodyBucket.assign(bodies.size(), NO_BUCKET);
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i].isStatic()) {
+            continue;
+        }
+        Vector3<double> p = bodies[i].getPosition();
+        bodyBucket[i] = bucketOf(cellOf(p.x, gridCellSize), cellOf(p.y, gridCellSize), cellOf(p.z, gridCellSize));
+        ++bucketStart[bodyBucket[i] + 1];
+    }
+    for (std::size_t b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    bucketBodies.resize(dynamicCount);
+    std::vector<std::uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (bodyBucket[i] != NO_BUCKET) {
+            bucketBodies[cursor[bodyBucket[i]]++] = i;
+        }
+    }
+}
+
+bool ExplosionSystem::isOccluded(const Vector3<double>& from, const Vector3<double>& to, const HeightField* terrain) const {
+    Vector3<double> delta = to - from;
+    double length = delta.magnitude();
+    if (length <= Constants<double>::TOLERANCE) {
+        return false;
+    }
+    // 작용점이 가림 표면에 닿아 있어도 가려지지 않도록 끝을 조금 줄인다
+    double reach = length - 1e-6;
+    Vector3<double> direction = delta / length;
+
+    if (terrain) {
+        HeightFieldHit hit;
+        if (terrain->raycast(HeightFieldRay{ from, direction, reach }, hit) && hit.hit) {
+            return true;
+        }
+    }
+    if (occluder) {
+        Vector3<double> start = from - occluderOrigin;
+        if (occluder->intersectsSegment(start, start + direction * reach)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ExplosionSystem::gather(std::size_t index, const std::vector<PhysicsObject>& bodies, const HeightField* terrain) {
+    const Explosion& e = pending[index];
+    std::vector<ExplosionHit>& out = hits[index];
+    std::vector<std::uint32_t>& buckets = visitedBuckets[index];
+    out.clear();
+    buckets.clear();
+
+    // 반경 + 최대 물체 반지름을 덮는 칸의 버킷 (칸이 버킷보다 많으면 모든 버킷)
+    const std::size_t bucketCount = bucketStart.size() - 1;
+    double reach = e.radius + maxBodyRadius;
+    long long lo[3] = { cellOf(e.center.x - reach, gridCellSize), cellOf(e.center.y - reach, gridCellSize), cellOf(e.center.z - reach, gridCellSize) };
+    long long hi[3] = { cellOf(e.center.x + reach, gridCellSize), cellOf(e.center.y + reach, gridCellSize), cellOf(e.center.z + reach, gridCellSize) };
+    double cells = static_cast<double>(hi[0] - lo[0] + 1) * static_cast<double>(hi[1] - lo[1] + 1) * static_cast<double>(hi[2] - lo[2] + 1);
+    if (cells >= static_cast<double>(bucketCount)) {
+        for (std::size_t b = 0; b < bucketCount; ++b) {
+            buckets.push_back(static_cast<std::uint32_t>(b));
+        }
+    }
+    else {
+        for (long long x = lo[0]; x <= hi[0]; ++x) {
+            for (long long y = lo[1]; y <= hi[1]; ++y) {
+                for (long long z = lo[2]; z <= hi[2]; ++z) {
+                    buckets.push_back(bucketOf(x, y, z));
+                }
+            }
+        }
+        // 해시 충돌로 같은 버킷을 두 번 훑지 않도록 정렬 후 중복 제거
+        std::sort(buckets.begin(), buckets.end());
+        buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    }
+
+    for (std::uint32_t b : buckets) {
+        for (std::uint32_t k = bucketStart[b]; k < bucketStart[b + 1]; ++k) {
+            std::size_t i = bucketBodies[k];
+            const PhysicsObject& body = bodies[i];
+            Vector3<double> position = body.getPosition();
+
+            Vector3<double> point = closestPoint(body, e.center);
+            Vector3<double> offset = point - e.center;
+            double distance = offset.magnitude();
+            if (distance >= e.radius) {
+                continue;
+            }
+
+            Vector3<double> direction;
+            if (distance > Constants<double>::TOLERANCE) {
+                direction = offset / distance;
+            }
+            else {
+                // 폭심이 물체 안: 질량 중심 쪽으로 민다
+                Vector3<double> toCenter = position - e.center;
+                double length = toCenter.magnitude();
+                direction = length > Constants<double>::TOLERANCE ? toCenter / length : Vector3<double>(0.0, 1.0, 0.0);
+            }
+
+            if (occlusion && isOccluded(e.center, point, terrain)) {
+                continue;
+            }
+
+            double weight = e.falloffExponent > 0.0 ? std::pow(1.0 - distance / e.radius, e.falloffExponent) : 1.0;
+            Vector3<double> impulse = direction * (e.impulse * weight);
+            ExplosionHit hit;
+            hit.body = i;
+            hit.linearImpulse = impulse;
+            hit.angularImpulse = (point - position) ^ impulse;
+            out.push_back(hit);
+        }
+    }
+
+    // 버킷 순서가 아닌 물체 순서로 정리해 결과를 결정적으로 만든다
+    std::sort(out.begin(), out.end(), [](const ExplosionHit& a, const ExplosionHit& b) { return a.body < b.body; });
+}
+
+std::size_t ExplosionSystem::apply(std::vector<PhysicsObject>& bodies, const HeightField* terrain, ThreadPool& threadPool) {
+    hits.resize(pending.size());
+    if (pending.empty()) {
+        return 0;
+    }
+
+    buildGrid(bodies);
+    visitedBuckets.resize(pending.size());
+    threadPool.parallelFor(pending.size(), [&](std::size_t i) {
+        gather(i, bodies, terrain);
+    });
+
+    // 폭발 순서대로 물체별 합산 후 물체마다 한 번 적용
+    linearSum.resize(bodies.size());
+    angularSum.resize(bodies.size());
+    touchedFlags.assign(bodies.size(), 0);
+    touched.clear();
+    for (const std::vector<ExplosionHit>& list : hits) {
+        for (const ExplosionHit& hit : list) {
+            if (!touchedFlags[hit.body]) {
+                touchedFlags[hit.body] = 1;
+                touched.push_back(hit.body);
+                linearSum[hit.body] = Vector3<double>(0.0, 0.0, 0.0);
+                angularSum[hit.body] = Vector3<double>(0.0, 0.0, 0.0);
+            }
+            linearSum[hit.body] += hit.linearImpulse;
+            angularSum[hit.body] += hit.angularImpulse;
+        }
+    }
+    for (std::size_t i : touched) {
+        PhysicsObject& body = bodies[i];
+        body.setSleeping(false);
+        body.applyImpulse(linearSum[i], Vector3<double>(0.0, 0.0, 0.0));
+        body.applyAngularImpulse(angularSum[i]);
+    }
+
+    pending.clear();
+    return touched.size();
+}
+
+#endif // EXPLOSION_CPP
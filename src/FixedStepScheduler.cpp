@@ -0,0 +1,68 @@
+﻿#ifndef FIXEDSTEPSCHEDULER_CPP
+#define FIXEDSTEPSCHEDULER_CPP
+
+#include <cmath>
+#include <stdexcept>
+#include "FixedStepScheduler.h"
+
+FixedStepScheduler::FixedStepScheduler(double stepRate, int substeps, int maxStepsPerFrame)
+    : fixedDeltaTime(0.0), substeps(substeps > 0 ? substeps : 1), maxStepsPerFrame(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1),
+    accumulator(0.0), droppedTime(0.0)
+{
+    setStepRate(stepRate);
+}
+
+void FixedStepScheduler::setStepRate(double stepRate) {
+    if (stepRate <= 0.0) {
+        throw std::invalid_argument("Step rate must be positive in FixedStepScheduler::setStepRate");
+    }
+    fixedDeltaTime = 1.0 / stepRate;
+}
+
+int FixedStepScheduler::advance(double frameTime, const std::function<void(double)>& step) {
+    return advance(frameTime, std::function<void()>(), step);
+}
+
+int FixedStepScheduler::advance(double frameTime, const std::function<void()>& beginStep, const std::function<void(double)>& step) {
+    if (frameTime > 0.0) {
+        accumulator += frameTime;
+    }
+
+    double substepDeltaTime = getSubstepDeltaTime();
+    int steps = 0;
+    while (accumulator >= fixedDeltaTime && steps < maxStepsPerFrame) {
+        if (beginStep) {
+            beginStep();
+        }
+        for (int s = 0; s < substeps; ++s) {
+            step(substepDeltaTime);
+        }
+        accumulator -= fixedDeltaTime;
+        ++steps;
+    }
+
+    // 처리하지 못한 시간은 버려서 다음 프레임의 비용이 계속 불어나지 않게 한다
+    if (accumulator >= fixedDeltaTime) {
+        double keep = std::fmod(accumulator, fixedDeltaTime);
+        droppedTime += accumulator - keep;
+        accumulator = keep;
+    }
+    return steps;
+}
+
+Quaternion<double> FixedStepScheduler::interpolate(const Quaternion<double>& previous, const Quaternion<double>& current, double alpha) {
+    // 반대 부호의 사원수는 같은 회전이므로 최단 경로를 선택
+    double dot = previous.n * current.n + previous.v.x * current.v.x + previous.v.y * current.v.y + previous.v.z * current.v.z;
+    double sign = dot < 0.0 ? -1.0 : 1.0;
+
+    Quaternion<double> result(
+        previous.n + (sign * current.n - previous.n) * alpha,
+        previous.v.x + (sign * current.v.x - previous.v.x) * alpha,
+        previous.v.y + (sign * current.v.y - previous.v.y) * alpha,
+        previous.v.z + (sign * current.v.z - previous.v.z) * alpha
+    );
+    result.normalize();
+    return result;
+}
+
+#endif // FIXEDSTEPSCHEDULER_CPP
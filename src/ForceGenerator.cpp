@@ -0,0 +1,179 @@
+﻿#ifndef FORCEGENERATOR_CPP
+#define FORCEGENERATOR_CPP
+
+#include <algorithm>
+#include <cmath>
+#include "ForceGenerator.h"
+#include "PhysicsObject.h"
+#include "Constants.h"
+
+GravityField::GravityField(const Vector3<double>& gravity)
+    : gravity(gravity) {}
+
+void GravityField::accumulate(const ForceBatch& batch) const {
+    for (std::size_t i = 0; i < batch.count; ++i) {
+        batch.forces[i] += gravity * batch.masses[i];
+    }
+}
+
+DragField::DragField(double linear, double quadratic)
+    : linear(linear), quadratic(quadratic), airVelocity(0.0, 0.0, 0.0) {}
+
+void DragField::accumulate(const ForceBatch& batch) const {
+    for (std::size_t i = 0; i < batch.count; ++i) {
+        Vector3<double> relative = batch.velocities[i] - airVelocity;
+        double speed = std::sqrt(relative * relative);
+        batch.forces[i] -= relative * (linear + quadratic * speed);
+    }
+}
+
+WindField::WindField(const Vector3<double>& windVelocity, double linear, double quadratic)
+    : DragField(linear, quadratic)
+{
+    airVelocity = windVelocity;
+}
+
+std::size_t ForceRegistry::addField(std::shared_ptr<ForceField> field) {
+    fields.push_back(std::move(field));
+    return fields.size() - 1;
+}
+
+void ForceRegistry::removeField(const std::shared_ptr<ForceField>& field) {
+    fields.erase(std::remove(fields.begin(), fields.end(), field), fields.end());
+}
+
+std::size_t ForceRegistry::addSpring(const SpringForce& spring) {
+    springs.push_back(spring);
+    return springs.size() - 1;
+}
+
+void ForceRegistry::remapBodies(const std::vector<std::size_t>& newIndexOf) {
+    for (SpringForce& spring : springs) {
+        spring.bodyA = newIndexOf[spring.bodyA];
+        spring.bodyB = newIndexOf[spring.bodyB];
+    }
+}
+
+void ForceRegistry::removeBody(std::size_t index, std::size_t movedFrom) {
+    springs.erase(std::remove_if(springs.begin(), springs.end(), [index](const SpringForce& spring) {
+        return spring.bodyA == index || spring.bodyB == index;
+    }), springs.end());
+    for (SpringForce& spring : springs) {
+        if (spring.bodyA == movedFrom) spring.bodyA = index;
+        if (spring.bodyB == movedFrom) spring.bodyB = index;
+    }
+}
+
+void ForceRegistry::clear() {
+    fields.clear();
+    springs.clear();
+}
+
+bool ForceRegistry::getUniformAcceleration(Vector3<double>& acceleration) const {
+    if (!springs.empty()) {
+        return false;
+    }
+    acceleration = Vector3<double>(0.0, 0.0, 0.0);
+    for (const auto& field : fields) {
+        Vector3<double> fieldAcceleration;
+        if (!field->getUniformAcceleration(fieldAcceleration)) {
+            return false;
+        }
+        acceleration += fieldAcceleration;
+    }
+    return true;
+}
+
+void ForceRegistry::apply(PhysicsObject* bodies, std::size_t count) {
+    // 깨어 있는 동적 물체만 SoA 버퍼로 모은다
+    bodyIndices.clear();
+    positions.clear();
+    velocities.clear();
+    masses.clear();
+    slotOfBody.assign(count, NO_SLOT);
+    for (std::size_t i = 0; i < count; ++i) {
+        const PhysicsObject& body = bodies[i];
+        if (body.isStatic() || body.isSleeping()) {
+            continue;
+        }
+        slotOfBody[i] = bodyIndices.size();
+        bodyIndices.push_back(i);
+        positions.push_back(body.getPosition());
+        velocities.push_back(body.getVelocity());
+        masses.push_back(body.getMass());
+    }
+    forces.assign(bodyIndices.size(), Vector3<double>(0.0, 0.0, 0.0));
+    if (bodyIndices.empty()) {
+        return;
+    }
+
+    ForceBatch batch{ bodyIndices.size(), positions.data(), velocities.data(), masses.data(), forces.data() };
+    for (const auto& field : fields) {
+        field->accumulate(batch);
+    }
+    accumulateSprings(bodies);
+
+    for (std::size_t s = 0; s < bodyIndices.size(); ++s) {
+        bodies[bodyIndices[s]].accumulateForce(forces[s]);
+    }
+}
+
+Vector3<double> ForceRegistry::evaluateAcceleration(const PhysicsObject* bodies, std::size_t index,
+    const Vector3<double>& position, const Vector3<double>& velocity) const {
+    const PhysicsObject& body = bodies[index];
+    double mass = body.getMass();
+    Vector3<double> force(0.0, 0.0, 0.0);
+    ForceBatch batch{ 1, &position, &velocity, &mass, &force };
+    for (const auto& field : fields) {
+        field->accumulate(batch);
+    }
+
+    for (const auto& spring : springs) {
+        if (spring.bodyA != index && spring.bodyB != index) {
+            continue;
+        }
+        // 이 물체 쪽을 A 로 두고 상대 물체는 현재 상태를 쓴다
+        const PhysicsObject& other = bodies[spring.bodyA == index ? spring.bodyB : spring.bodyA];
+        Vector3<double> delta = other.getPosition() - position;
+        double length = std::sqrt(delta * delta);
+        if (length <= Constants<double>::TOLERANCE) {
+            continue;
+        }
+        Vector3<double> axis = delta / length;
+        double relativeSpeed = (other.getVelocity() - velocity) * axis;
+        force += axis * (spring.stiffness * (length - spring.restLength) + spring.damping * relativeSpeed);
+    }
+    return force / mass;
+}
+
+// 후크 스프링 + 축 방향 댐퍼 (잠든 물체나 정적 물체 쪽에는 힘을 쓰지 않음)
+void ForceRegistry::accumulateSprings(const PhysicsObject* bodies) {
+    for (const auto& spring : springs) {
+        std::size_t slotA = slotOfBody[spring.bodyA];
+        std::size_t slotB = slotOfBody[spring.bodyB];
+        if (slotA == NO_SLOT && slotB == NO_SLOT) {
+            continue;
+        }
+
+        const PhysicsObject& bodyA = bodies[spring.bodyA];
+        const PhysicsObject& bodyB = bodies[spring.bodyB];
+        Vector3<double> delta = bodyB.getPosition() - bodyA.getPosition();
+        double length = std::sqrt(delta * delta);
+        if (length <= Constants<double>::TOLERANCE) {
+            continue;
+        }
+        Vector3<double> axis = delta / length;
+        double relativeSpeed = (bodyB.getVelocity() - bodyA.getVelocity()) * axis;
+
+        // A 에 작용하는 힘 (B 쪽으로 당김), B 에는 반대 방향
+        Vector3<double> force = axis * (spring.stiffness * (length - spring.restLength) + spring.damping * relativeSpeed);
+        if (slotA != NO_SLOT) {
+            forces[slotA] += force;
+        }
+        if (slotB != NO_SLOT) {
+            forces[slotB] -= force;
+        }
+    }
+}
+
+#endif // FORCEGENERATOR_CPP
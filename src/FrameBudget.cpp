@@ -0,0 +1,122 @@
+﻿#ifndef FRAMEBUDGET_CPP
+#define FRAMEBUDGET_CPP
+
+#include <algorithm>
+#include <cstdio>
+#include "FrameBudget.h"
+
+const char* getStepPhaseName(StepPhase phase) {
+    switch (phase) {
+    case StepPhase::Reorder: return "Reorder";
+    case StepPhase::Commands: return "Commands";
+    case StepPhase::Forces: return "Forces";
+    case StepPhase::Contacts: return "Contacts";
+    case StepPhase::Islands: return "Islands";
+    case StepPhase::Solve: return "Solve";
+    case StepPhase::SoftBodies: return "SoftBodies";
+    case StepPhase::Events: return "Events";
+    default: return "Unknown";
+    }
+}
+
+const char* getDegradationLevelName(DegradationLevel level) {
+    switch (level) {
+    case DegradationLevel::None: return "None";
+    case DegradationLevel::ReducedIterations: return "ReducedIterations";
+    case DegradationLevel::CoarseDistantBodies: return "CoarseDistantBodies";
+    case DegradationLevel::DeferredSleep: return "DeferredSleep";
+    default: return "Unknown";
+    }
+}
+
+FrameBudgetController::FrameBudgetController()
+    : level(DegradationLevel::None), underBudgetSteps(0), sleepCheckCounter(0), sleepElapsed(0.0) {}
+
+void FrameBudgetController::setBudget(const FrameBudget& b) {
+    budget = b;
+    if (budget.budget <= 0.0) {
+        level = DegradationLevel::None;
+    }
+}
+
+void FrameBudgetController::reset() {
+    level = DegradationLevel::None;
+    underBudgetSteps = 0;
+    sleepCheckCounter = 0;
+    sleepElapsed = 0.0;
+}
+
+int FrameBudgetController::getVelocityIterations(int baseIterations) const {
+    int minimum = std::min(baseIterations, std::max(budget.minVelocityIterations, 1));
+    switch (level) {
+    case DegradationLevel::None:
+        return baseIterations;
+    case DegradationLevel::ReducedIterations:
+        return std::max(baseIterations / 2, minimum);
+    default:
+        return minimum;
+    }
+}
+
+bool FrameBudgetController::takeSleepCheck(double deltaTime, double& elapsed) {
+    sleepElapsed += deltaTime;
+    ++sleepCheckCounter;
+    if (defersSleep() && sleepCheckCounter < std::max(budget.sleepCheckInterval, 1u)) {
+        return false;
+    }
+    // 지연이 풀린 첫 스텝에는 그동안 쌓인 시간까지 한꺼번에 반영
+    elapsed = sleepElapsed;
+    sleepElapsed = 0.0;
+    sleepCheckCounter = 0;
+    return true;
+}
+
+void FrameBudgetController::update(StepReport& report) {
+    report.slowestPhase = StepPhase::Reorder;
+    for (std::size_t p = 1; p < static_cast<std::size_t>(StepPhase::Count); ++p) {
+        if (report.phaseTimes[p] > report.phaseTimes[static_cast<std::size_t>(report.slowestPhase)]) {
+            report.slowestPhase = static_cast<StepPhase>(p);
+        }
+    }
+    report.reason.clear();
+
+    DegradationLevel previous = level;
+    if (budget.budget <= 0.0) {
+        level = DegradationLevel::None;
+        underBudgetSteps = 0;
+    }
+    else if (report.total > budget.budget) {
+        underBudgetSteps = 0;
+        if (level < DegradationLevel::DeferredSleep) {
+            level = static_cast<DegradationLevel>(static_cast<int>(level) + 1);
+        }
+    }
+    else if (report.total < budget.budget * budget.recoverFraction) {
+        if (++underBudgetSteps >= budget.recoverSteps && level > DegradationLevel::None) {
+            level = static_cast<DegradationLevel>(static_cast<int>(level) - 1);
+            underBudgetSteps = 0;
+        }
+    }
+    else {
+        underBudgetSteps = 0;
+    }
+    report.nextLevel = level;
+
+    if (level != previous) {
+        char text[256];
+        std::size_t slowest = static_cast<std::size_t>(report.slowestPhase);
+        if (level > previous) {
+            std::snprintf(text, sizeof(text), "step %.3f ms > budget %.3f ms (slowest %s %.3f ms): %s -> %s",
+                report.total * 1e3, budget.budget * 1e3, getStepPhaseName(report.slowestPhase), report.phaseTimes[slowest] * 1e3,
+                getDegradationLevelName(previous), getDegradationLevelName(level));
+        }
+        else {
+            std::snprintf(text, sizeof(text), "step under %.0f%% of budget %.3f ms for %u steps: %s -> %s",
+                budget.recoverFraction * 100.0, budget.budget * 1e3, budget.recoverSteps,
+                getDegradationLevelName(previous), getDegradationLevelName(level));
+        }
+        report.reason = text;
+    }
+}
+
+#endif // FRAMEBUDGET_CPP
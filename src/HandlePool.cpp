@@ -0,0 +1,72 @@
+﻿#ifndef HANDLEPOOL_CPP
+#define HANDLEPOOL_CPP
+
+#include "HandlePool.h"
+
+HandlePool::HandlePool() : freeHead(NO_INDEX) {}
+
+GenerationalHandle HandlePool::create() {
+    std::uint32_t slot = static_cast<std::uint32_t>(handleOfSlot.size());
+    std::uint32_t index;
+    if (freeHead != NO_INDEX) {
+        index = freeHead;
+        freeHead = entries[index].slot;
+        entries[index].slot = slot;
+    }
+    else {
+        index = static_cast<std::uint32_t>(entries.size());
+        entries.push_back(Entry{ slot, 1 });
+    }
+    GenerationalHandle handle(index, entries[index].generation);
+    handleOfSlot.push_back(handle);
+    return handle;
+}
+
+std::size_t HandlePool::destroy(GenerationalHandle handle) {
+    if (!isValid(handle)) {
+        return NO_SLOT;
+    }
+    Entry& entry = entries[handle.index];
+    std::size_t slot = entry.slot;
+
+    // 마지막 슬롯의 핸들을 비워진 슬롯으로 옮긴다
+    GenerationalHandle moved = handleOfSlot.back();
+    handleOfSlot[slot] = moved;
+    entries[moved.index].slot = static_cast<std::uint32_t>(slot);
+    handleOfSlot.pop_back();
+
+    // 세대를 올려 기존 핸들을 무효화하고 번호를 자유 목록에 넣는다 (0 은 null 핸들이므로 건너뜀)
+    if (++entry.generation == 0) {
+        entry.generation = 1;
+    }
+    entry.slot = freeHead;
+    freeHead = handle.index;
+    return slot;
+}
+
+GenerationalHandle HandlePool::getHandleAtIndex(std::size_t index) const {
+    const Entry& entry = entries[index];
+    if (entry.slot < handleOfSlot.size() && handleOfSlot[entry.slot].index == index) {
+        return handleOfSlot[entry.slot];
+    }
+    return GenerationalHandle();
+}
+
+void HandlePool::reserve(std::size_t capacity) {
+    entries.reserve(capacity);
+    handleOfSlot.reserve(capacity);
+}
+
+void HandlePool::clear() {
+    entries.clear();
+    handleOfSlot.clear();
+    freeHead = NO_INDEX;
+}
+
+void HandlePool::permute(const std::vector<std::size_t>& order, std::vector<std::size_t>& newSlotOf) {
+    permuteHandleSlots(handleOfSlot, order, newSlotOf,
+        [this](GenerationalHandle handle) { return static_cast<std::size_t>(entries[handle.index].slot); },
+        [this](GenerationalHandle handle, std::size_t slot) { entries[handle.index].slot = static_cast<std::uint32_t>(slot); });
+}
+
+#endif // HANDLEPOOL_CPP
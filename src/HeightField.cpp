@@ -0,0 +1,304 @@
+﻿#ifndef HEIGHTFIELD_CPP
+#define HEIGHTFIELD_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include "HeightField.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+HeightField::HeightField(std::size_t columns, std::size_t rows, double cellSize, double heightScale, const Vector3<double>& origin)
+    : columns(columns), rows(rows), cellSize(cellSize), inverseCellSize(1.0 / cellSize), heightScale(heightScale), origin(origin),
+    heights(nullptr), mappedView(nullptr), mappedSize(0),
+#ifdef _WIN32
+    fileHandle(nullptr), mappingHandle(nullptr)
+#else
+    fileDescriptor(-1)
+#endif
+{
+    if (columns < 2 || rows < 2) {
+        throw std::invalid_argument("HeightField requires at least 2 x 2 samples");
+    }
+    if (cellSize <= 0.0) {
+        throw std::invalid_argument("HeightField cell size must be positive");
+    }
+}
+
+HeightField::HeightField(std::size_t columns, std::size_t rows, const std::vector<float>& heights,
+    double cellSize, double heightScale, const Vector3<double>& origin)
+    : HeightField(columns, rows, cellSize, heightScale, origin)
+{
+    if (heights.size() < columns * rows) {
+        throw std::invalid_argument("HeightField height array is smaller than columns * rows");
+    }
+    ownedHeights.assign(heights.begin(), heights.begin() + columns * rows);
+    this->heights = ownedHeights.data();
+}
+
+HeightField::~HeightField() {
+#ifdef _WIN32
+    if (mappedView) {
+        UnmapViewOfFile(mappedView);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+#else
+    if (mappedView) {
+        munmap(mappedView, mappedSize);
+    }
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+    }
+#endif
+}
+
+std::shared_ptr<HeightField> HeightField::loadRaw(const std::string& path, std::size_t columns, std::size_t rows,
+    RawFormat format, double cellSize, double heightScale, const Vector3<double>& origin)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open height field file: " + path);
+    }
+
+    std::size_t count = columns * rows;
+    std::vector<float> heights(count);
+    if (format == RawFormat::Float32) {
+        file.read(reinterpret_cast<char*>(heights.data()), static_cast<std::streamsize>(count * sizeof(float)));
+    }
+    else {
+        std::vector<std::uint16_t> samples(count);
+        file.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(count * sizeof(std::uint16_t)));
+        for (std::size_t i = 0; i < count; ++i) {
+            heights[i] = samples[i] / 65535.0f;
+        }
+    }
+    if (!file) {
+        throw std::runtime_error("Height field file is smaller than columns * rows: " + path);
+    }
+
+    return std::make_shared<HeightField>(columns, rows, heights, cellSize, heightScale, origin);
+}
+
+std::shared_ptr<HeightField> HeightField::mapRaw(const std::string& path, std::size_t columns, std::size_t rows,
+    double cellSize, double heightScale, const Vector3<double>& origin)
+{
+    std::shared_ptr<HeightField> field(new HeightField(columns, rows, cellSize, heightScale, origin));
+    std::size_t size = columns * rows * sizeof(float);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open height field file: " + path);
+    }
+    field->fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<unsigned long long>(fileSize.QuadPart) < size) {
+        throw std::runtime_error("Height field file is smaller than columns * rows: " + path);
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        throw std::runtime_error("Failed to map height field file: " + path);
+    }
+    field->mappingHandle = mapping;
+    field->mappedView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open height field file: " + path);
+    }
+    field->fileDescriptor = fd;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < size) {
+        throw std::runtime_error("Height field file is smaller than columns * rows: " + path);
+    }
+    void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    field->mappedView = view == MAP_FAILED ? nullptr : view;
+#endif
+
+    if (!field->mappedView) {
+        throw std::runtime_error("Failed to map height field file: " + path);
+    }
+    field->mappedSize = size;
+    field->heights = static_cast<const float*>(field->mappedView);
+    return field;
+}
+
+bool HeightField::contains(double x, double z) const {
+    double u = (x - origin.x) * inverseCellSize;
+    double v = (z - origin.z) * inverseCellSize;
+    return u >= 0.0 && v >= 0.0 && u <= static_cast<double>(columns - 1) && v <= static_cast<double>(rows - 1);
+}
+
+void HeightField::locate(double x, double z, std::size_t& column, std::size_t& row, double& fx, double& fz) const {
+    double u = std::clamp((x - origin.x) * inverseCellSize, 0.0, static_cast<double>(columns - 1));
+    double v = std::clamp((z - origin.z) * inverseCellSize, 0.0, static_cast<double>(rows - 1));
+    column = std::min(static_cast<std::size_t>(u), columns - 2);
+    row = std::min(static_cast<std::size_t>(v), rows - 2);
+    fx = u - static_cast<double>(column);
+    fz = v - static_cast<double>(row);
+}
+
+double HeightField::getHeight(double x, double z) const {
+    std::size_t column, row;
+    double fx, fz;
+    locate(x, z, column, row, fx, fz);
+
+    const float* cell = heights + row * columns + column;
+    double h00 = cell[0];
+    double h10 = cell[1];
+    double h01 = cell[columns];
+    double h11 = cell[columns + 1];
+
+    double h0 = h00 + (h10 - h00) * fx;
+    double h1 = h01 + (h11 - h01) * fx;
+    return origin.y + (h0 + (h1 - h0) * fz) * heightScale;
+}
+
+Vector3<double> HeightField::getNormal(double x, double z) const {
+    Vector3<double> normal;
+    getHeightAndNormal(x, z, normal);
+    return normal;
+}
+
+double HeightField::getHeightAndNormal(double x, double z, Vector3<double>& normal) const {
+    std::size_t column, row;
+    double fx, fz;
+    locate(x, z, column, row, fx, fz);
+
+    const float* cell = heights + row * columns + column;
+    double h00 = cell[0];
+    double h10 = cell[1];
+    double h01 = cell[columns];
+    double h11 = cell[columns + 1];
+
+    // 쌍선형 면의 기울기
+    double scale = heightScale * inverseCellSize;
+    double dhdx = ((h10 - h00) * (1.0 - fz) + (h11 - h01) * fz) * scale;
+    double dhdz = ((h01 - h00) * (1.0 - fx) + (h11 - h10) * fx) * scale;
+    normal = Vector3<double>(-dhdx, 1.0, -dhdz);
+    normal.normalize();
+
+    double h0 = h00 + (h10 - h00) * fx;
+    double h1 = h01 + (h11 - h01) * fx;
+    return origin.y + (h0 + (h1 - h0) * fz) * heightScale;
+}
+
+bool HeightField::raycast(const HeightFieldRay& ray, HeightFieldHit& hit) const {
+    hit.hit = false;
+
+    // 격자의 xz 범위로 레이 구간을 자른다 (슬랩 검사)
+    double tMin = 0.0;
+    double tMax = ray.maxDistance;
+    const double bounds[2][2] = {
+        { origin.x, origin.x + cellSize * static_cast<double>(columns - 1) },
+        { origin.z, origin.z + cellSize * static_cast<double>(rows - 1) }
+    };
+    const double start[2] = { ray.origin.x, ray.origin.z };
+    const double direction[2] = { ray.direction.x, ray.direction.z };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::fabs(direction[axis]) < 1e-12) {
+            if (start[axis] < bounds[axis][0] || start[axis] > bounds[axis][1]) {
+                return false;
+            }
+            continue;
+        }
+        double inverse = 1.0 / direction[axis];
+        double t0 = (bounds[axis][0] - start[axis]) * inverse;
+        double t1 = (bounds[axis][1] - start[axis]) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+
+    auto gap = [&](double t) {
+        Vector3<double> p = ray.origin + ray.direction * t;
+        return p.y - getHeight(p.x, p.z);
+    };
+
+    // 셀 크기 절반 간격으로 지면 아래로 내려가는 구간 탐색
+    double step = 0.5 * cellSize;
+    double previousT = tMin;
+    if (gap(tMin) <= 0.0) {
+        hit.hit = true;
+        hit.distance = tMin;
+    }
+    else {
+        for (double t = std::min(tMin + step, tMax); ; t = std::min(t + step, tMax)) {
+            if (gap(t) <= 0.0) {
+                // 이분법 정밀화
+                double low = previousT;
+                double high = t;
+                for (int i = 0; i < 16; ++i) {
+                    double mid = 0.5 * (low + high);
+                    if (gap(mid) > 0.0) {
+                        low = mid;
+                    }
+                    else {
+                        high = mid;
+                    }
+                }
+                hit.hit = true;
+                hit.distance = high;
+                break;
+            }
+            if (t >= tMax) {
+                break;
+            }
+            previousT = t;
+        }
+    }
+
+    if (hit.hit) {
+        hit.point = ray.origin + ray.direction * hit.distance;
+        hit.point.y = getHeightAndNormal(hit.point.x, hit.point.z, hit.normal);
+    }
+    return hit.hit;
+}
+
+void HeightField::getHeights(const Vector3<double>* points, std::size_t count, double* outHeights) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        outHeights[i] = getHeight(points[i].x, points[i].z);
+    }
+}
+
+void HeightField::getHeightsAndNormals(const Vector3<double>* points, std::size_t count, double* outHeights, Vector3<double>* outNormals) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        outHeights[i] = getHeightAndNormal(points[i].x, points[i].z, outNormals[i]);
+    }
+}
+
+std::size_t HeightField::raycastBatch(const HeightFieldRay* rays, std::size_t count, HeightFieldHit* outHits) const {
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (raycast(rays[i], outHits[i])) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+#endif // HEIGHTFIELD_CPP
@@ -0,0 +1,142 @@
+﻿#ifndef INTEGRATOR_CPP
+#define INTEGRATOR_CPP
+
+#include <algorithm>
+#include <cmath>
+#include "Integrator.h"
+#include "Constants.h"
+
+// 반암시적 오일러
+int SymplecticEulerIntegrator::integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const {
+    state.velocity += acceleration(state.position, state.velocity, time) * deltaTime;
+    state.position += state.velocity * deltaTime;
+    return 1;
+}
+
+// 속도 베를레 (속도 의존 가속도는 예측 속도로 근사)
+int VelocityVerletIntegrator::integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const {
+    Vector3<double> a0 = acceleration(state.position, state.velocity, time);
+    state.position += state.velocity * deltaTime + a0 * (0.5 * deltaTime * deltaTime);
+    Vector3<double> predictedVelocity = state.velocity + a0 * deltaTime;
+    Vector3<double> a1 = acceleration(state.position, predictedVelocity, time + deltaTime);
+    state.velocity += (a0 + a1) * (0.5 * deltaTime);
+    return 2;
+}
+
+// 고전 4차 룽게-쿠타
+int RK4Integrator::integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const {
+    const Vector3<double>& x = state.position;
+    const Vector3<double>& v = state.velocity;
+    double h = deltaTime;
+    double halfH = 0.5 * h;
+
+    Vector3<double> k1x = v;
+    Vector3<double> k1v = acceleration(x, v, time);
+
+    Vector3<double> k2x = v + k1v * halfH;
+    Vector3<double> k2v = acceleration(x + k1x * halfH, k2x, time + halfH);
+
+    Vector3<double> k3x = v + k2v * halfH;
+    Vector3<double> k3v = acceleration(x + k2x * halfH, k3x, time + halfH);
+
+    Vector3<double> k4x = v + k3v * h;
+    Vector3<double> k4v = acceleration(x + k3x * h, k4x, time + h);
+
+    double sixth = h / 6.0;
+    state.position += (k1x + k2x * 2.0 + k3x * 2.0 + k4x) * sixth;
+    state.velocity += (k1v + k2v * 2.0 + k3v * 2.0 + k4v) * sixth;
+    return 4;
+}
+
+AdaptiveRK45Integrator::AdaptiveRK45Integrator(double absoluteTolerance, double relativeTolerance, double minStep, double maxStep)
+    : absoluteTolerance(absoluteTolerance), relativeTolerance(relativeTolerance), minStep(minStep), maxStep(maxStep) {}
+
+int AdaptiveRK45Integrator::integrate(IntegrationState& state, const AccelerationFunction& acceleration, double time, double deltaTime) const {
+    int evaluations = 0;
+    double remaining = deltaTime;
+    double step = state.stepHint > 0.0 ? state.stepHint : std::min(deltaTime, maxStep);
+
+    while (remaining > Constants<double>::TOLERANCE * deltaTime) {
+        // 구간 끝을 넘지 않도록 자르되, 잘린 스텝은 다음 권장값에 반영하지 않는다
+        bool clipped = step >= remaining;
+        double trial = clipped ? remaining : step;
+        double next = step;
+        double taken = adaptiveStep(state, acceleration, time, trial, next, evaluations);
+        time += taken;
+        remaining -= taken;
+        if (!clipped || taken < trial) {
+            step = next;
+        }
+    }
+
+    state.stepHint = step;
+    return evaluations;
+}
+
+double AdaptiveRK45Integrator::adaptiveStep(IntegrationState& state, const AccelerationFunction& acceleration, double time,
+    double trialStep, double& nextStep, int& evaluations) const
+{
+    // 도르만-프린스 계수
+    static const double c[7] = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+    static const double a[7][6] = {
+        { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+        { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+        { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0 },
+        { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0 },
+        { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0 },
+        { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0 },
+        { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 }
+    };
+    static const double b5[7] = { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 };
+    static const double b4[7] = { 5179.0 / 57600.0, 0.0, 7571.0 / 16695.0, 393.0 / 640.0, -92097.0 / 339200.0, 187.0 / 2100.0, 1.0 / 40.0 };
+
+    double h = trialStep;
+    while (true) {
+        Vector3<double> kx[7];
+        Vector3<double> kv[7];
+        for (int s = 0; s < 7; ++s) {
+            Vector3<double> x = state.position;
+            Vector3<double> v = state.velocity;
+            for (int j = 0; j < s; ++j) {
+                x += kx[j] * (a[s][j] * h);
+                v += kv[j] * (a[s][j] * h);
+            }
+            kx[s] = v;
+            kv[s] = acceleration(x, v, time + c[s] * h);
+        }
+        evaluations += 7;
+
+        Vector3<double> x5 = state.position;
+        Vector3<double> v5 = state.velocity;
+        Vector3<double> errorX;
+        Vector3<double> errorV;
+        for (int s = 0; s < 7; ++s) {
+            x5 += kx[s] * (b5[s] * h);
+            v5 += kv[s] * (b5[s] * h);
+            errorX += kx[s] * ((b5[s] - b4[s]) * h);
+            errorV += kv[s] * ((b5[s] - b4[s]) * h);
+        }
+
+        // 성분별 허용치로 정규화한 오차의 최대값
+        auto scaled = [&](double err, double y0, double y1) {
+            return std::fabs(err) / (absoluteTolerance + relativeTolerance * std::max(std::fabs(y0), std::fabs(y1)));
+        };
+        double error = std::max({
+            scaled(errorX.x, state.position.x, x5.x), scaled(errorX.y, state.position.y, x5.y), scaled(errorX.z, state.position.z, x5.z),
+            scaled(errorV.x, state.velocity.x, v5.x), scaled(errorV.y, state.velocity.y, v5.y), scaled(errorV.z, state.velocity.z, v5.z)
+        });
+
+        double factor = error > 0.0 ? 0.9 * std::pow(error, -0.2) : 5.0;
+        factor = std::clamp(factor, 0.2, 5.0);
+
+        if (error <= 1.0 || h <= minStep) {
+            state.position = x5;
+            state.velocity = v5;
+            nextStep = std::clamp(h * factor, minStep, maxStep);
+            return h;
+        }
+        h = std::max(h * factor, minStep);
+    }
+}
+
+#endif // INTEGRATOR_CPP
@@ -0,0 +1,119 @@
+﻿#ifndef ISLAND_CPP
+#define ISLAND_CPP
+
+#include "Island.h"
+#include "PhysicsObject.h"
+
+void UnionFind::reset(std::size_t count) {
+    parent.resize(count);
+    rank.assign(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        parent[i] = i;
+    }
+}
+
+std::size_t UnionFind::find(std::size_t i) {
+    // 경로 절반 압축
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void UnionFind::unite(std::size_t a, std::size_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    if (rank[a] < rank[b]) {
+        parent[a] = b;
+    }
+    else if (rank[a] > rank[b]) {
+        parent[b] = a;
+    }
+    else {
+        parent[b] = a;
+        ++rank[a];
+    }
+}
+
+void IslandBuilder::build(std::vector<PhysicsObject>& bodies,
+    const std::vector<Contact>& contacts,
+    const std::vector<DistanceJoint>& joints,
+    const std::vector<SpringForce>& springs,
+    std::vector<Island>& islands)
+{
+    const std::size_t bodyCount = bodies.size();
+    sets.reset(bodyCount);
+
+    auto isDynamic = [&](std::size_t i) {
+        return i != Contact::STATIC_BODY && !bodies[i].isStatic();
+    };
+
+    // 두 동적 물체를 잇는 간선만 합친다
+    for (const auto& c : contacts) {
+        if (isDynamic(c.bodyA) && isDynamic(c.bodyB)) {
+            sets.unite(c.bodyA, c.bodyB);
+        }
+    }
+    for (const auto& j : joints) {
+        if (isDynamic(j.bodyA) && isDynamic(j.bodyB)) {
+            sets.unite(j.bodyA, j.bodyB);
+        }
+    }
+    for (const auto& s : springs) {
+        if (isDynamic(s.bodyA) && isDynamic(s.bodyB)) {
+            sets.unite(s.bodyA, s.bodyB);
+        }
+    }
+
+    // 루트마다 섬 번호를 부여
+    islands.clear();
+    islandOfRoot.assign(bodyCount, Contact::STATIC_BODY);
+    for (std::size_t i = 0; i < bodyCount; ++i) {
+        if (!isDynamic(i)) {
+            continue;
+        }
+        std::size_t root = sets.find(i);
+        if (islandOfRoot[root] == Contact::STATIC_BODY) {
+            islandOfRoot[root] = islands.size();
+            islands.push_back(Island{ {}, {}, {}, true, 0 });
+        }
+        Island& island = islands[islandOfRoot[root]];
+        island.bodies.push_back(i);
+        if (!bodies[i].isSleeping()) {
+            island.sleeping = false;
+        }
+    }
+
+    // 접촉과 제약을 동적 물체 쪽 섬에 배정
+    auto islandOf = [&](std::size_t a, std::size_t b) {
+        return islandOfRoot[sets.find(isDynamic(a) ? a : b)];
+    };
+    for (std::size_t c = 0; c < contacts.size(); ++c) {
+        if (isDynamic(contacts[c].bodyA) || isDynamic(contacts[c].bodyB)) {
+            islands[islandOf(contacts[c].bodyA, contacts[c].bodyB)].contacts.push_back(c);
+        }
+    }
+    for (std::size_t j = 0; j < joints.size(); ++j) {
+        if (isDynamic(joints[j].bodyA) || isDynamic(joints[j].bodyB)) {
+            islands[islandOf(joints[j].bodyA, joints[j].bodyB)].joints.push_back(j);
+        }
+    }
+
+    // 깨어 있는 물체와 연결된 섬은 전체를 깨운다
+    for (auto& island : islands) {
+        if (island.sleeping) {
+            continue;
+        }
+        for (std::size_t i : island.bodies) {
+            if (bodies[i].isSleeping()) {
+                bodies[i].setSleeping(false);
+            }
+        }
+    }
+}
+
+#endif // ISLAND_CPP
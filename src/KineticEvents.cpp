@@ -0,0 +1,131 @@
+﻿#ifndef KINETICEVENTS_CPP
+#define KINETICEVENTS_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "KineticEvents.h"
+
+namespace {
+    const double NEVER = std::numeric_limits<double>::infinity();
+
+    double component(const Vector3<double>& v, int axis) {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    // ½ a t² + v t + c = 0 의 (0, horizon] 안 근을 roots 에 추가
+    void appendRoots(double a, double v, double c, double horizon, std::vector<double>& roots) {
+        const double halfA = 0.5 * a;
+        if (std::fabs(halfA) < 1e-15) {
+            if (v != 0.0) {
+                double t = -c / v;
+                if (t > 0.0 && t <= horizon) roots.push_back(t);
+            }
+            return;
+        }
+        double discriminant = v * v - 4.0 * halfA * c;
+        if (discriminant < 0.0) {
+            return;
+        }
+        // 상쇄 오차를 피하는 근의 공식
+        double q = -0.5 * (v + std::copysign(std::sqrt(discriminant), v));
+        double t0 = q / halfA;
+        double t1 = q != 0.0 ? c / q : t0;
+        if (t0 > 0.0 && t0 <= horizon) roots.push_back(t0);
+        if (t1 > 0.0 && t1 <= horizon) roots.push_back(t1);
+    }
+
+    bool inside(const BallisticPath& path, double t, const Vector3<double>& boxMin, const Vector3<double>& boxMax) {
+        Vector3<double> p = path.positionAt(t);
+        return p.x >= boxMin.x && p.x <= boxMax.x && p.y >= boxMin.y && p.y <= boxMax.y && p.z >= boxMin.z && p.z <= boxMax.z;
+    }
+
+    // 각 축의 경계면 통과 시각으로 [0, horizon] 을 나누고, 구간 중점의 포함 여부가 바뀌는 첫 경계를 찾는다
+    double firstTransition(const BallisticPath& path, const Vector3<double>& boxMin, const Vector3<double>& boxMax,
+        double horizon, bool wantInside)
+    {
+        if (inside(path, 0.0, boxMin, boxMax) == wantInside) {
+            return 0.0;
+        }
+        std::vector<double> roots;
+        for (int axis = 0; axis < 3; ++axis) {
+            double p = component(path.position, axis);
+            double v = component(path.velocity, axis);
+            double a = component(path.acceleration, axis);
+            appendRoots(a, v, p - component(boxMin, axis), horizon, roots);
+            appendRoots(a, v, p - component(boxMax, axis), horizon, roots);
+        }
+        std::sort(roots.begin(), roots.end());
+        for (std::size_t i = 0; i < roots.size(); ++i) {
+            double end = i + 1 < roots.size() ? roots[i + 1] : horizon;
+            if (end <= roots[i]) {
+                continue;
+            }
+            if (inside(path, 0.5 * (roots[i] + end), boxMin, boxMax) == wantInside) {
+                return roots[i];
+            }
+        }
+        return NEVER;
+    }
+}
+
+double BallisticPath::predictPlaneCrossing(double height) const {
+    double c = position.y - height;
+    if (c <= 0.0) {
+        return 0.0;
+    }
+    std::vector<double> roots;
+    appendRoots(acceleration.y, velocity.y, c, NEVER, roots);
+    return roots.empty() ? NEVER : *std::min_element(roots.begin(), roots.end());
+}
+
+double BallisticPath::predictBoxEntry(const Vector3<double>& boxMin, const Vector3<double>& boxMax, double horizon) const {
+    return firstTransition(*this, boxMin, boxMax, horizon, true);
+}
+
+double BallisticPath::predictBoxExit(const Vector3<double>& boxMin, const Vector3<double>& boxMax, double horizon) const {
+    return firstTransition(*this, boxMin, boxMax, horizon, false);
+}
+
+void KineticEventQueue::schedule(std::size_t body, KineticEventType type, double time) {
+    if (!(time < NEVER)) {
+        return;
+    }
+    if (body >= versions.size()) {
+        versions.resize(body + 1, 0);
+    }
+    events.push(KineticEvent{ time, body, type, versions[body] });
+}
+
+void KineticEventQueue::invalidate(std::size_t body) {
+    if (body < versions.size()) {
+        ++versions[body];
+    }
+}
+
+bool KineticEventQueue::isStale(const KineticEvent& event) const {
+    return event.version != versions[event.body];
+}
+
+const KineticEvent* KineticEventQueue::peek() {
+    while (!events.empty() && isStale(events.top())) {
+        events.pop();
+    }
+    return events.empty() ? nullptr : &events.top();
+}
+
+bool KineticEventQueue::pop(KineticEvent& out) {
+    if (!peek()) {
+        return false;
+    }
+    out = events.top();
+    events.pop();
+    return true;
+}
+
+void KineticEventQueue::clear() {
+    events = std::priority_queue<KineticEvent, std::vector<KineticEvent>, Later>();
+    versions.clear();
+}
+
+#endif // KINETICEVENTS_CPP
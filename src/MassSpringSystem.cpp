@@ -0,0 +1,258 @@
+﻿#ifndef MASSSPRINGSYSTEM_CPP
+#define MASSSPRINGSYSTEM_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "MassSpringSystem.h"
+#include "Constants.h"
+
+MassSpringSystem::MassSpringSystem()
+    : gravity(0.0, -Constants<double>::GRAVITY, 0.0),
+    maxIterations(50),
+    tolerance(1e-6),
+    springsSorted(true),
+    lastIterationCount(0) {}
+
+std::size_t MassSpringSystem::addParticle(const Vector3<double>& position, double mass) {
+    positions.push_back(position);
+    velocities.push_back(Vector3<double>(0.0, 0.0, 0.0));
+    externalForces.push_back(Vector3<double>(0.0, 0.0, 0.0));
+    restMasses.push_back(mass > 0.0 ? mass : 1.0);
+    masses.push_back(mass > 0.0 ? mass : 1.0);
+    inverseMasses.push_back(mass > 0.0 ? 1.0 / mass : 0.0);
+    return positions.size() - 1;
+}
+
+void MassSpringSystem::addSpring(std::size_t a, std::size_t b, double stiffness, double damping, double restLength) {
+    if (a == b || a >= positions.size() || b >= positions.size()) {
+        throw std::invalid_argument("MassSpringSystem::addSpring requires two distinct existing particles");
+    }
+    if (restLength < 0.0) {
+        restLength = (positions[b] - positions[a]).magnitude();
+    }
+    springs.push_back(Spring{ static_cast<std::uint32_t>(std::min(a, b)), static_cast<std::uint32_t>(std::max(a, b)),
+        restLength, stiffness, damping });
+    springsSorted = false;
+}
+
+std::size_t MassSpringSystem::addCloth(const Vector3<double>& origin, const Vector3<double>& uAxis, const Vector3<double>& vAxis,
+    std::size_t columns, std::size_t rows, double totalMass,
+    double stretchStiffness, double shearStiffness, double bendStiffness, double damping)
+{
+    if (columns < 2 || rows < 2) {
+        throw std::invalid_argument("MassSpringSystem::addCloth requires at least 2 x 2 particles");
+    }
+
+    std::size_t first = positions.size();
+    double particleMass = totalMass / static_cast<double>(columns * rows);
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < columns; ++c) {
+            double u = static_cast<double>(c) / static_cast<double>(columns - 1);
+            double v = static_cast<double>(r) / static_cast<double>(rows - 1);
+            addParticle(origin + uAxis * u + vAxis * v, particleMass);
+        }
+    }
+
+    auto at = [&](std::size_t c, std::size_t r) { return first + r * columns + c; };
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < columns; ++c) {
+            // 인장
+            if (c + 1 < columns) addSpring(at(c, r), at(c + 1, r), stretchStiffness, damping);
+            if (r + 1 < rows) addSpring(at(c, r), at(c, r + 1), stretchStiffness, damping);
+            // 전단
+            if (c + 1 < columns && r + 1 < rows) {
+                addSpring(at(c, r), at(c + 1, r + 1), shearStiffness, damping);
+                addSpring(at(c + 1, r), at(c, r + 1), shearStiffness, damping);
+            }
+            // 굽힘
+            if (c + 2 < columns) addSpring(at(c, r), at(c + 2, r), bendStiffness, damping);
+            if (r + 2 < rows) addSpring(at(c, r), at(c, r + 2), bendStiffness, damping);
+        }
+    }
+    return first;
+}
+
+std::size_t MassSpringSystem::addRope(const Vector3<double>& start, const Vector3<double>& end, std::size_t segments,
+    double totalMass, double stiffness, double damping)
+{
+    if (segments == 0) {
+        throw std::invalid_argument("MassSpringSystem::addRope requires at least one segment");
+    }
+
+    std::size_t first = positions.size();
+    double particleMass = totalMass / static_cast<double>(segments + 1);
+    for (std::size_t i = 0; i <= segments; ++i) {
+        double t = static_cast<double>(i) / static_cast<double>(segments);
+        addParticle(start + (end - start) * t, particleMass);
+    }
+    for (std::size_t i = 0; i < segments; ++i) {
+        addSpring(first + i, first + i + 1, stiffness, damping);
+    }
+    return first;
+}
+
+void MassSpringSystem::setPinned(std::size_t index, bool pinned) {
+    inverseMasses[index] = pinned ? 0.0 : 1.0 / restMasses[index];
+    if (pinned) {
+        velocities[index] = Vector3<double>(0.0, 0.0, 0.0);
+    }
+}
+
+// 스프링을 (a, b) 사전순으로 정렬하여 질점 배열을 앞에서부터 훑도록 한다
+void MassSpringSystem::sortSprings() {
+    std::sort(springs.begin(), springs.end(), [](const Spring& lhs, const Spring& rhs) {
+        return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+    });
+    springsSorted = true;
+}
+
+// 힘 f 와 우변 h (f + h ∂f/∂x v), 스프링별 블록 J = h² K + h C 를 한 번의 스프링 순회로 계산
+// K = k [n nᵀ + max(0, 1 - L/l) (I - n nᵀ)], C = c n nᵀ (압축 시 횡방향 항을 버려 양의 준정부호 유지)
+void MassSpringSystem::computeForcesAndJacobians(double deltaTime) {
+    const std::size_t count = positions.size();
+    const double h = deltaTime;
+    const Matrix3x3<double> identity = Matrix3x3<double>::identity();
+
+    forces.resize(count);
+    rhs.resize(count);
+    preconditioner.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        forces[i] = gravity * masses[i] + externalForces[i];
+        preconditioner[i] = masses[i];
+        rhs[i] = Vector3<double>(0.0, 0.0, 0.0);
+    }
+
+    stiffnessBlocks.resize(springs.size());
+    for (std::size_t s = 0; s < springs.size(); ++s) {
+        const Spring& spring = springs[s];
+        Vector3<double> delta = positions[spring.b] - positions[spring.a];
+        double length = delta.magnitude();
+        if (length <= Constants<double>::TOLERANCE) {
+            stiffnessBlocks[s] = Matrix3x3<double>();
+            continue;
+        }
+        Vector3<double> n = delta / length;
+        Vector3<double> relativeVelocity = velocities[spring.b] - velocities[spring.a];
+
+        Vector3<double> force = n * (spring.stiffness * (length - spring.restLength) + spring.damping * (relativeVelocity * n));
+        forces[spring.a] += force;
+        forces[spring.b] -= force;
+
+        Matrix3x3<double> nn = Matrix3x3<double>::outerProduct(n, n);
+        double lateral = std::max(0.0, 1.0 - spring.restLength / length);
+        Matrix3x3<double> k = (nn + (identity - nn) * lateral) * spring.stiffness;
+
+        // h² ∂f/∂x v 항: ∂f_a/∂x_a = -K, ∂f_a/∂x_b = K
+        Vector3<double> kv = k * relativeVelocity * (h * h);
+        rhs[spring.a] += kv;
+        rhs[spring.b] -= kv;
+
+        Matrix3x3<double> block = k * (h * h) + nn * (spring.damping * h);
+        stiffnessBlocks[s] = block;
+        double diagonal = block.trace() / 3.0;
+        preconditioner[spring.a] += diagonal;
+        preconditioner[spring.b] += diagonal;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        rhs[i] += forces[i] * h;
+        preconditioner[i] = 1.0 / preconditioner[i];
+    }
+}
+
+// out = A x, A = M + Σ J (스프링 블록을 끝점 쌍에 흩뿌림)
+void MassSpringSystem::multiply(const std::vector<Vector3<double>>& x, std::vector<Vector3<double>>& out) const {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        out[i] = x[i] * masses[i];
+    }
+    for (std::size_t s = 0; s < springs.size(); ++s) {
+        const Spring& spring = springs[s];
+        Vector3<double> v = stiffnessBlocks[s] * (x[spring.a] - x[spring.b]);
+        out[spring.a] += v;
+        out[spring.b] -= v;
+    }
+    filter(out);
+}
+
+// 고정점 성분 제거
+void MassSpringSystem::filter(std::vector<Vector3<double>>& v) const {
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (inverseMasses[i] == 0.0) {
+            v[i] = Vector3<double>(0.0, 0.0, 0.0);
+        }
+    }
+}
+
+// 야코비 전처리 켤레 기울기법으로 A Δv = rhs 풀이
+void MassSpringSystem::solve() {
+    const std::size_t count = positions.size();
+    deltaVelocity.assign(count, Vector3<double>(0.0, 0.0, 0.0));
+    residual = rhs;
+    filter(residual);
+    direction.resize(count);
+    product.resize(count);
+    preconditioned.resize(count);
+
+    auto dot = [count](const std::vector<Vector3<double>>& u, const std::vector<Vector3<double>>& v) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += u[i] * v[i];
+        }
+        return sum;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        preconditioned[i] = residual[i] * preconditioner[i];
+        direction[i] = preconditioned[i];
+    }
+    double rz = dot(residual, preconditioned);
+    double threshold = tolerance * tolerance * dot(residual, residual);
+
+    lastIterationCount = 0;
+    while (lastIterationCount < maxIterations && dot(residual, residual) > threshold) {
+        multiply(direction, product);
+        double pAp = dot(direction, product);
+        if (pAp <= 0.0) {
+            break;
+        }
+        double alpha = rz / pAp;
+        for (std::size_t i = 0; i < count; ++i) {
+            deltaVelocity[i] += direction[i] * alpha;
+            residual[i] -= product[i] * alpha;
+            preconditioned[i] = residual[i] * preconditioner[i];
+        }
+        double rzNext = dot(residual, preconditioned);
+        double beta = rzNext / rz;
+        rz = rzNext;
+        for (std::size_t i = 0; i < count; ++i) {
+            direction[i] = preconditioned[i] + direction[i] * beta;
+        }
+        ++lastIterationCount;
+    }
+}
+
+void MassSpringSystem::step(double deltaTime) {
+    if (positions.empty()) {
+        return;
+    }
+    if (!springsSorted) {
+        sortSprings();
+    }
+
+    computeForcesAndJacobians(deltaTime);
+    solve();
+
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        if (inverseMasses[i] == 0.0) {
+            velocities[i] = Vector3<double>(0.0, 0.0, 0.0);
+        }
+        else {
+            velocities[i] += deltaVelocity[i];
+        }
+        positions[i] += velocities[i] * deltaTime;
+        externalForces[i] = Vector3<double>(0.0, 0.0, 0.0);
+    }
+}
+
+#endif // MASSSPRINGSYSTEM_CPP
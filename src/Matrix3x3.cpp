@@ -23,6 +23,26 @@ Matrix3x3<T> Matrix3x3<T>::identity() {
     );
 }
 
+// 외적 행렬 u vᵀ
+template<typename T>
+Matrix3x3<T> Matrix3x3<T>::outerProduct(const Vector3<T>& u, const Vector3<T>& v) {
+    return Matrix3x3(
+        u.x * v.x, u.x * v.y, u.x * v.z,
+        u.y * v.x, u.y * v.y, u.y * v.z,
+        u.z * v.x, u.z * v.y, u.z * v.z
+    );
+}
+
+// 외적 행렬 [v]×
+template<typename T>
+Matrix3x3<T> Matrix3x3<T>::skew(const Vector3<T>& v) {
+    return Matrix3x3(
+        0, -v.z, v.y,
+        v.z, 0, -v.x,
+        -v.y, v.x, 0
+    );
+}
+
 // 행렬 대각합
 template<typename T>
 T Matrix3x3<T>::trace() const {
@@ -0,0 +1,76 @@
+﻿#ifndef MORTONORDER_CPP
+#define MORTONORDER_CPP
+
+#include <algorithm>
+#include "MortonOrder.h"
+
+namespace {
+    // 하위 21 비트 사이에 0 두 개씩을 끼워 넣는다
+    std::uint64_t spreadBits(std::uint32_t value) {
+        std::uint64_t v = value & 0x1FFFFFu;
+        v = (v | (v << 32)) & 0x1F00000000FFFFull;
+        v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+        v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+        v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+        v = (v | (v << 2)) & 0x1249249249249249ull;
+        return v;
+    }
+
+    const double GRID_MAX = static_cast<double>(0x1FFFFFu);
+}
+
+std::uint64_t encodeMorton3(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+    return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+void computeMortonOrder(const Vector3<double>* points, std::size_t count, std::vector<std::size_t>& order) {
+    order.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    Vector3<double> lo = points[0];
+    Vector3<double> hi = points[0];
+    for (std::size_t i = 1; i < count; ++i) {
+        const Vector3<double>& p = points[i];
+        lo.x = std::min(lo.x, p.x); lo.y = std::min(lo.y, p.y); lo.z = std::min(lo.z, p.z);
+        hi.x = std::max(hi.x, p.x); hi.y = std::max(hi.y, p.y); hi.z = std::max(hi.z, p.z);
+    }
+
+    // 축마다 같은 척도를 써서 Z 곡선 칸이 정육면체가 되도록 한다
+    double extent = std::max(hi.x - lo.x, std::max(hi.y - lo.y, hi.z - lo.z));
+    double scale = extent > 0.0 ? GRID_MAX / extent : 0.0;
+    auto quantize = [&](double value, double origin) {
+        return static_cast<std::uint32_t>(std::min(GRID_MAX, std::max(0.0, (value - origin) * scale)));
+    };
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> keys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector3<double>& p = points[i];
+        keys[i] = std::make_pair(encodeMorton3(quantize(p.x, lo.x), quantize(p.y, lo.y), quantize(p.z, lo.z)), i);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (std::size_t i = 0; i < count; ++i) {
+        order[i] = keys[i].second;
+    }
+}
+
+std::size_t SlotRemap::add() {
+    std::size_t handle = slotOfHandle.size();
+    slotOfHandle.push_back(handleOfSlot.size());
+    handleOfSlot.push_back(handle);
+    return handle;
+}
+
+void SlotRemap::clear() {
+    slotOfHandle.clear();
+    handleOfSlot.clear();
+}
+
+void SlotRemap::permute(const std::vector<std::size_t>& order, std::vector<std::size_t>& newSlotOf) {
+    permuteHandleSlots(handleOfSlot, order, newSlotOf,
+        [this](std::size_t handle) { return slotOfHandle[handle]; },
+        [this](std::size_t handle, std::size_t slot) { slotOfHandle[handle] = slot; });
+}
+
+#endif // MORTONORDER_CPP
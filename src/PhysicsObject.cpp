@@ -6,76 +6,239 @@
 
 // 기본 생성자
 PhysicsObject::PhysicsObject()
-    : position(0.0, 0.0, 0.0),
-    orientation(1.0, 0.0, 0.0, 0.0),
-    scale(1.0, 1.0, 1.0),
-    mass(1.0),
-    velocity(0.0, 0.0, 0.0),
-    acceleration(0.0, 0.0, 0.0),
-    force(0.0, 0.0, 0.0),
-    inertiaTensor(Matrix3x3<double>::identity()),
-    inverseInertiaTensor(Matrix3x3<double>::identity()),
-    angularVelocity(0.0, 0.0, 0.0),
-    groundHeight(0.0)
+    : shape(nullptr),
+    integrator(nullptr)
 {
+    state.position = Vector3<double>(0.0, 0.0, 0.0);
+    state.orientation = Quaternion<double>(1.0, 0.0, 0.0, 0.0);
+    state.scale = Vector3<double>(1.0, 1.0, 1.0);
+    state.mass = 1.0;
+    state.velocity = Vector3<double>(0.0, 0.0, 0.0);
+    state.acceleration = Vector3<double>(0.0, 0.0, 0.0);
+    state.force = Vector3<double>(0.0, 0.0, 0.0);
+    state.torque = Vector3<double>(0.0, 0.0, 0.0);
+    state.inertiaTensor = Matrix3x3<double>::identity();
+    state.inverseInertiaTensor = Matrix3x3<double>::identity();
+    state.inverseInertiaWorld = Matrix3x3<double>::identity();
+    state.angularVelocity = Vector3<double>(0.0, 0.0, 0.0);
+    state.groundHeight = 0.0;
+    state.isStaticBody = false;
+    state.sleeping = false;
+    state.sleepTimer = 0.0;
+    state.integratorStepHint = 0.0;
     calculateInertiaTensor();
 }
 
 // 힘을 적용하는 함수
 void PhysicsObject::applyForce(const Vector3<double>& newForce) {
-    force += newForce;
+    state.force += newForce;
+    setSleeping(false);
 }
 
-// 토크를 적용하는 함수
-void PhysicsObject::applyTorque(const Vector3<double>& torque) {
-    // 각가속도 = 역관성 텐서 * 토크
-    Vector3<double> angularAcceleration = inverseInertiaTensor * torque;
-    angularVelocity += angularAcceleration; // 각속도 업데이트
+// 충격량을 적용하는 함수 (relativePoint: 질량 중심 기준 작용점)
+void PhysicsObject::applyImpulse(const Vector3<double>& impulse, const Vector3<double>& relativePoint) {
+    if (state.isStaticBody) {
+        return;
+    }
+    state.velocity += impulse * (1.0 / state.mass);
+    state.angularVelocity += state.inverseInertiaWorld * (relativePoint ^ impulse);
+}
+
+// 각충격량을 적용하는 함수
+void PhysicsObject::applyAngularImpulse(const Vector3<double>& angularImpulse) {
+    if (state.isStaticBody) {
+        return;
+    }
+    state.angularVelocity += state.inverseInertiaWorld * angularImpulse;
+}
+
+// 월드 좌표계 역관성 텐서 갱신: R I⁻¹ Rᵀ
+void PhysicsObject::updateWorldInertia() {
+    if (state.isStaticBody) {
+        state.inverseInertiaWorld = Matrix3x3<double>();
+        return;
+    }
+    Matrix3x3<double> rotation = state.orientation.toMatrix3x3();
+    state.inverseInertiaWorld = rotation * state.inverseInertiaTensor * rotation.transpose();
+}
+
+// 수면 상태 설정 (잠들 때 속도를 0으로, 깨어날 때 타이머를 초기화)
+void PhysicsObject::setSleeping(bool s) {
+    if (s) {
+        state.velocity = Vector3<double>(0.0, 0.0, 0.0);
+        state.angularVelocity = Vector3<double>(0.0, 0.0, 0.0);
+    }
+    else {
+        state.sleepTimer = 0.0;
+    }
+    state.sleeping = s;
+}
+
+// 경계 구의 반지름 (형상이 있으면 형상 기준, 없으면 구형: scale.x, 박스형: 대각선의 절반)
+double PhysicsObject::getBoundingRadius() const {
+    return computeBoundingRadius(state.scale, shape.get());
+}
+
+double PhysicsObject::computeBoundingRadius(const Vector3<double>& scale, const CollisionShape* shape) {
+    if (shape) {
+        return shape->getBoundingRadius();
+    }
+    if (scale.x == scale.y && scale.y == scale.z) {
+        return scale.x;
+    }
+    return 0.5 * scale.magnitude();
+}
+
+// 토크를 적용하는 함수 (스텝 동안 누적되어 적분 시 dt 와 함께 반영)
+void PhysicsObject::applyTorque(const Vector3<double>& newTorque) {
+    state.torque += newTorque;
+    setSleeping(false);
+}
+
+// 각속도 적분 함수
+void PhysicsObject::integrateAngularVelocity(double deltaTime) {
+    // 각가속도 = 월드 역관성 텐서 * 토크
+    Vector3<double> angularAcceleration = state.inverseInertiaWorld * state.torque;
+    state.angularVelocity += angularAcceleration * deltaTime; // 각속도 업데이트
+
+    // 토크 초기화
+    state.torque = Vector3<double>(0.0, 0.0, 0.0);
+}
+
+// 속도 적분 함수 (중력 등 전역 힘은 ForceRegistry 가 적분 전에 force 로 누적)
+// clearForces 가 false 이면 누적 외력과 토크를 남겨 다음 부분 스텝에서 같은 힘으로 다시 적분한다.
+void PhysicsObject::integrateVelocity(double deltaTime, bool clearForces) {
+    state.acceleration = state.force / state.mass;
+
+    state.velocity += state.acceleration * deltaTime;
+
+    if (!clearForces) {
+        state.angularVelocity += (state.inverseInertiaWorld * state.torque) * deltaTime;
+        return;
+    }
+
+    // 외력 초기화
+    state.force = Vector3<double>(0.0, 0.0, 0.0);
+
+    integrateAngularVelocity(deltaTime);
+}
+
+// 위치 및 회전 적분 함수
+void PhysicsObject::integratePosition(double deltaTime) {
+    state.position += state.velocity * deltaTime;
+    updateRotation(deltaTime);
 }
 
 // 위치 업데이트 함수
 void PhysicsObject::updatePosition(double deltaTime) {
-    // 중력 가속도 적용
-    Vector3<double> gravityForce(0.0, -mass * Constants<double>::GRAVITY, 0.0);
-    acceleration = (force + gravityForce) / mass;
+    updatePosition(deltaTime, AccelerationFunction());
+}
+
+// 위치 업데이트 함수 (acceleration 이 비어 있으면 누적 외력만 사용)
+void PhysicsObject::updatePosition(double deltaTime, const AccelerationFunction& acceleration) {
+    if (!integrator) {
+        // 시작 상태에서 평가한 가속도를 외력에 더한 뒤 속도와 위치 업데이트
+        if (acceleration) {
+            state.force += acceleration(state.position, state.velocity, 0.0) * state.mass;
+        }
+        integrateVelocity(deltaTime);
+        state.position += state.velocity * deltaTime;
+        return;
+    }
+
+    // 누적 외력은 스텝 동안 일정하다고 보고, 힘 원천의 가속도는 적분기가 요구하는 상태마다 다시 평가한다
+    const Vector3<double> constantAcceleration = state.force / state.mass;
+    state.acceleration = constantAcceleration;
+    if (acceleration) {
+        state.acceleration += acceleration(state.position, state.velocity, 0.0);
+    }
 
-    // 속도와 위치 업데이트
-    velocity += acceleration * deltaTime;
-    position += velocity * deltaTime;
+    IntegrationState integration{ state.position, state.velocity, state.integratorStepHint };
+    if (acceleration) {
+        integrator->integrate(integration,
+            [&constantAcceleration, &acceleration](const Vector3<double>& x, const Vector3<double>& v, double t) {
+                return constantAcceleration + acceleration(x, v, t);
+            },
+            0.0, deltaTime);
+    }
+    else {
+        integrator->integrate(integration,
+            [&constantAcceleration](const Vector3<double>&, const Vector3<double>&, double) { return constantAcceleration; },
+            0.0, deltaTime);
+    }
+    state.position = integration.position;
+    state.velocity = integration.velocity;
+    state.integratorStepHint = integration.stepHint;
 
     // 외력 초기화
-    force = Vector3<double>(0.0, 0.0, 0.0);
+    state.force = Vector3<double>(0.0, 0.0, 0.0);
+
+    integrateAngularVelocity(deltaTime);
 }
 
 // 회전 업데이트 함수
 void PhysicsObject::updateRotation(double deltaTime) {
-    Quaternion<double> deltaRotation = Quaternion<double>::fromAngularVelocity(angularVelocity, deltaTime);
-    orientation = deltaRotation * orientation;
-    orientation.normalize();
+    Quaternion<double> deltaRotation = Quaternion<double>::fromAngularVelocity(state.angularVelocity, deltaTime);
+    state.orientation = deltaRotation * state.orientation;
+    state.orientation.normalize();
 }
 
 // 전체 상태 업데이트 함수
 void PhysicsObject::update(double deltaTime) {
-    updatePosition(deltaTime);
+    update(deltaTime, AccelerationFunction());
+}
+
+void PhysicsObject::update(double deltaTime, const AccelerationFunction& acceleration) {
+    updateWorldInertia();
+    updatePosition(deltaTime, acceleration);
     updateRotation(deltaTime);
 }
 
+// 탄도 구간 해석적 진행 (회전은 같은 각속도의 회전을 steps 번 합성한 것과 같음)
+void PhysicsObject::advanceBallistic(const Vector3<double>& acceleration, double deltaTime, std::size_t steps) {
+    if (steps == 0 || state.isStaticBody) {
+        return;
+    }
+    double t = deltaTime * static_cast<double>(steps);
+    state.position += (state.velocity + acceleration * (getBallisticBias() * deltaTime)) * t + acceleration * (0.5 * t * t);
+    state.velocity += acceleration * t;
+    state.acceleration = acceleration;
+    state.force = Vector3<double>(0.0, 0.0, 0.0);
+    state.torque = Vector3<double>(0.0, 0.0, 0.0);
+    updateRotation(t);
+    updateWorldInertia();
+}
+
 // 충돌 처리 함수 (단순화된 예시)
 void PhysicsObject::onCollision(PhysicsObject& other) {
     double restitution = 0.8;
-    velocity = -velocity * restitution;
-    other.velocity = -other.velocity * restitution;
+    state.velocity = -state.velocity * restitution;
+    other.state.velocity = -other.state.velocity * restitution;
 }
 
-// 관성 텐서 계산 함수 (구형 또는 박스형 객체에 대한 관성 텐서 계산)
+// 관성 텐서 계산 함수
 void PhysicsObject::calculateInertiaTensor() {
+    computeInertia(state.mass, state.scale, shape.get(), state.inertiaTensor, state.inverseInertiaTensor);
+    updateWorldInertia();
+}
+
+// 관성 텐서 계산 (형상이 없으면 구형 또는 박스형 객체로 근사)
+void PhysicsObject::computeInertia(double mass, const Vector3<double>& scale, const CollisionShape* shape,
+    Matrix3x3<double>& inertia, Matrix3x3<double>& inverseInertia) {
+    if (shape) {
+        // 형상의 단위 질량 관성을 질량으로 스케일 (역행렬 계산 불필요)
+        inertia = shape->getUnitInertia() * mass;
+        inverseInertia = shape->getUnitInverseInertia() * (1.0 / mass);
+        return;
+    }
+
     if (scale.x == scale.y && scale.y == scale.z) {
         // 구형 객체에 대한 관성 모멘트 공식: I = (2/5) * m * r^2
         double radius = scale.x; // 구형 객체의 반지름
-        double inertia = (2.0 / 5.0) * mass * radius * radius;
+        double moment = (2.0 / 5.0) * mass * radius * radius;
 
         // 관성 텐서를 대각 행렬로 설정 (구형 객체의 경우)
-        inertiaTensor = Matrix3x3<double>::identity() * inertia;
+        inertia = Matrix3x3<double>::identity() * moment;
     }
     else {
         // 박스형 객체에 대한 관성 모멘트 공식: I = (1/12) * m * (w^2 + h^2)
@@ -84,7 +247,7 @@ void PhysicsObject::calculateInertiaTensor() {
         double I_z = (1.0 / 12.0) * mass * (scale.x * scale.x + scale.y * scale.y);
 
         // 관성 텐서를 대각 행렬로 설정 (박스형 객체의 경우)
-        inertiaTensor = Matrix3x3<double>(
+        inertia = Matrix3x3<double>(
             I_x, 0.0, 0.0,
             0.0, I_y, 0.0,
             0.0, 0.0, I_z
@@ -92,14 +255,14 @@ void PhysicsObject::calculateInertiaTensor() {
     }
 
     // 역관성 텐서 계산
-    inverseInertiaTensor = inertiaTensor.inverse();
+    inverseInertia = inertia.inverse();
 }
 
 // 바닥 충돌 처리 함수
 void PhysicsObject::onGroundCollision() {
-    if (position.y <= groundHeight) {
-        position.y = groundHeight; // 바닥에 붙임
-        velocity.y = -velocity.y * 0.8; // 반발 계수를 사용한 속도 반전
+    if (state.position.y <= state.groundHeight) {
+        state.position.y = state.groundHeight; // 바닥에 붙임
+        state.velocity.y = -state.velocity.y * 0.8; // 반발 계수를 사용한 속도 반전
     }
 }
 
@@ -0,0 +1,668 @@
+﻿#ifndef PHYSICSWORLD_CPP
+#define PHYSICSWORLD_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "PhysicsWorld.h"
+#include "Constants.h"
+
+PhysicsWorld::PhysicsWorld(std::size_t threadCount)
+    : reorderInterval(0),
+    sleepLinearThreshold(0.05),
+    sleepAngularThreshold(0.05),
+    timeToSleep(0.5),
+    batchedIslandThreshold(256),
+    maxSubstepLevel(3),
+    substepMotionFraction(0.5),
+    substepTolerance(1e-3),
+    lastReport(),
+    sleepCheckThisStep(true),
+    sleepCheckTime(0.0),
+    gravity(std::make_shared<GravityField>(Vector3<double>(0.0, -Constants<double>::GRAVITY, 0.0))),
+    threadPool(new ThreadPool(threadCount)),
+    groundHeight(0.0),
+    stepCount(0)
+{
+    forces.addField(gravity);
+}
+
+BodyHandle PhysicsWorld::addBody(const PhysicsObject& body) {
+    bodies.push_back(body);
+    return bodyHandles.create();
+}
+
+bool PhysicsWorld::removeBody(BodyHandle handle) {
+    std::size_t slot = bodyHandles.getSlot(handle);
+    if (slot == HandlePool::NO_SLOT) {
+        return false;
+    }
+    const std::size_t last = bodies.size() - 1;
+
+    // 받침이 사라진 채 잠들어 있지 않도록 닿아 있거나 연결된 물체를 깨운다
+    auto wakeOther = [&](std::size_t a, std::size_t b) {
+        if (a == slot && b != Contact::STATIC_BODY) {
+            bodies[b].setSleeping(false);
+        }
+        else if (b == slot && a != Contact::STATIC_BODY) {
+            bodies[a].setSleeping(false);
+        }
+    };
+    for (const Contact& contact : contacts) {
+        wakeOther(contact.bodyA, contact.bodyB);
+    }
+    for (const DistanceJoint& joint : joints) {
+        wakeOther(joint.bodyA, joint.bodyB);
+    }
+
+    // 걸린 관절을 지우고 마지막 슬롯을 가리키던 관절은 빈자리로 옮긴다
+    joints.erase(std::remove_if(joints.begin(), joints.end(), [slot](const DistanceJoint& joint) {
+        return joint.bodyA == slot || joint.bodyB == slot;
+    }), joints.end());
+    for (DistanceJoint& joint : joints) {
+        if (joint.bodyA == last) joint.bodyA = slot;
+        if (joint.bodyB == last) joint.bodyB = slot;
+    }
+    forces.removeBody(slot, last);
+
+    bodyHandles.destroy(handle);
+    swapRemove(bodies, slot);
+
+    // 스텝 내부 목록은 슬롯 기준이므로 다음 스텝에서 다시 만든다
+    contacts.clear();
+    islands.clear();
+    return true;
+}
+
+void PhysicsWorld::reserveBodies(std::size_t capacity) {
+    bodies.reserve(capacity);
+    bodyHandles.reserve(capacity);
+}
+
+std::size_t PhysicsWorld::requireSlot(BodyHandle handle) const {
+    std::size_t slot = bodyHandles.getSlot(handle);
+    if (slot == HandlePool::NO_SLOT) {
+        throw std::invalid_argument("PhysicsWorld stale or invalid body handle");
+    }
+    return slot;
+}
+
+PhysicsObject& PhysicsWorld::getBody(BodyHandle handle) {
+    return bodies[requireSlot(handle)];
+}
+
+const PhysicsObject& PhysicsWorld::getBody(BodyHandle handle) const {
+    return bodies[requireSlot(handle)];
+}
+
+PhysicsObject* PhysicsWorld::findBody(BodyHandle handle) {
+    std::size_t slot = bodyHandles.getSlot(handle);
+    return slot != HandlePool::NO_SLOT ? &bodies[slot] : nullptr;
+}
+
+std::size_t PhysicsWorld::addDistanceJoint(BodyHandle bodyA, BodyHandle bodyB, double restLength) {
+    joints.push_back(DistanceJoint{ requireSlot(bodyA), requireSlot(bodyB), restLength });
+    return joints.size() - 1;
+}
+
+std::size_t PhysicsWorld::addSpring(BodyHandle bodyA, BodyHandle bodyB, double restLength, double stiffness, double damping) {
+    return forces.addSpring(SpringForce{ requireSlot(bodyA), requireSlot(bodyB), restLength, stiffness, damping });
+}
+
+// 물체를 위치의 모턴 순서로 다시 저장하고, 슬롯을 들고 있는 목록(관절, 스프링, 접촉, 섬)을 새 슬롯으로 옮긴다
+// 접촉 이벤트의 이전 쌍은 핸들 기준이므로 그대로 이어진다.
+void PhysicsWorld::reorderBodies() {
+    softBodies.reorderParticles();
+    if (bodies.size() < 2) {
+        return;
+    }
+
+    reorderPoints.resize(bodies.size());
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        reorderPoints[i] = bodies[i].getPosition();
+    }
+    computeMortonOrder(reorderPoints.data(), reorderPoints.size(), reorderOrder);
+    permuteBodies();
+}
+
+// reorderOrder 순열로 물체를 옮기고 슬롯을 들고 있는 목록을 새 슬롯으로 바꾼다
+void PhysicsWorld::permuteBodies() {
+    bodyHandles.permute(reorderOrder, reorderSlots);
+    applyOrder(bodies, reorderOrder, reorderPlaced);
+
+    auto remap = [this](std::size_t& body) {
+        if (body != Contact::STATIC_BODY) {
+            body = reorderSlots[body];
+        }
+    };
+    for (DistanceJoint& joint : joints) {
+        remap(joint.bodyA);
+        remap(joint.bodyB);
+    }
+    for (Contact& contact : contacts) {
+        remap(contact.bodyA);
+        remap(contact.bodyB);
+    }
+    for (Island& island : islands) {
+        for (std::size_t& b : island.bodies) {
+            remap(b);
+        }
+    }
+    forces.remapBodies(reorderSlots);
+}
+
+void PhysicsWorld::step(double deltaTime) {
+    typedef std::chrono::steady_clock Clock;
+    StepReport& report = lastReport;
+    report.frame = stepCount;
+    report.level = budgetController.getLevel();
+    report.budget = budgetController.getBudget().budget;
+
+    // 저하 단계에 따라 이번 스텝의 반복 횟수와 수면 판정 여부 결정 (반복 횟수는 스텝이 끝나면 되돌림)
+    const int baseIterations = solver.velocityIterations;
+    solver.velocityIterations = budgetController.getVelocityIterations(baseIterations);
+    report.velocityIterations = solver.velocityIterations;
+    sleepCheckThisStep = budgetController.takeSleepCheck(deltaTime, sleepCheckTime);
+    report.sleepCheckDeferred = !sleepCheckThisStep;
+
+    const Clock::time_point start = Clock::now();
+    Clock::time_point mark = start;
+    auto endPhase = [&](StepPhase phase) {
+        Clock::time_point now = Clock::now();
+        report.phaseTimes[static_cast<std::size_t>(phase)] = std::chrono::duration<double>(now - mark).count();
+        mark = now;
+    };
+
+    if (reorderInterval > 0 && stepCount > 0 && stepCount % reorderInterval == 0) {
+        reorderBodies();
+    }
+    endPhase(StepPhase::Reorder);
+    updateWorldInertias();
+    applyCommands();
+    explosions.apply(bodies, terrain.get(), *threadPool);
+    endPhase(StepPhase::Commands);
+    applyForces();
+    endPhase(StepPhase::Forces);
+    detectContacts();
+    endPhase(StepPhase::Contacts);
+    islandBuilder.build(bodies, contacts, joints, forces.getSprings(), islands);
+    chooseSubstepLevels(deltaTime);
+    endPhase(StepPhase::Islands);
+    solveIslands(deltaTime);
+    endPhase(StepPhase::Solve);
+    stepSoftBodies(deltaTime);
+    endPhase(StepPhase::SoftBodies);
+    contactEvents.update(contacts, bodyHandles.getHandles());
+    ++stepCount;
+    publisher.publish(*this);
+    endPhase(StepPhase::Events);
+
+    solver.velocityIterations = baseIterations;
+    report.total = std::chrono::duration<double>(mark - start).count();
+    budgetController.update(report);
+}
+
+void PhysicsWorld::saveSnapshot(WorldSnapshot& out) const {
+    const std::vector<ContactEventBuffer::PairRecord>& pairs = contactEvents.getPreviousPairs();
+    std::size_t particleCount = softBodies.getParticleCount();
+    out.layout(stepCount, bodies.size(), particleCount, pairs.size());
+
+    // 물체와 입자 상태는 핸들 (번호) 순서로, 저장 순서는 슬롯 → 핸들 표로, 접촉 쌍(핸들 기준)은 배열째 복사
+    // 물체 상태는 값 바이트만 복사하므로 layout 이 0 으로 채운 끝 패딩이 그대로 남는다
+    unsigned char* states = static_cast<unsigned char*>(out.getBodies());
+    for (std::size_t index = 0; index < bodyHandles.getIndexCount(); ++index) {
+        BodyHandle handle = bodyHandles.getHandleAtIndex(index);
+        if (!handle.isNull()) {
+            std::memcpy(states, &bodies[bodyHandles.getSlot(handle)].getState(), PHYSICS_STATE_VALUE_BYTES);
+            states += sizeof(PhysicsObject::State);
+        }
+    }
+    Vector3<double>* positions = static_cast<Vector3<double>*>(out.getPositions());
+    Vector3<double>* velocities = static_cast<Vector3<double>*>(out.getVelocities());
+    for (std::size_t h = 0; h < particleCount; ++h) {
+        positions[h] = softBodies.getPosition(h);
+        velocities[h] = softBodies.getVelocity(h);
+    }
+    const std::vector<BodyHandle>& bodyOrder = bodyHandles.getHandles();
+    if (!bodyOrder.empty()) {
+        std::memcpy(out.getBodyOrder(), bodyOrder.data(), bodyOrder.size() * sizeof(BodyHandle));
+    }
+    std::uint64_t* particleOrder = static_cast<std::uint64_t*>(out.getParticleOrder());
+    const std::vector<std::size_t>& particleHandles = softBodies.getParticleHandles();
+    for (std::size_t slot = 0; slot < particleCount; ++slot) {
+        particleOrder[slot] = particleHandles[slot];
+    }
+    if (!pairs.empty()) {
+        std::memcpy(out.getPairs(), pairs.data(), pairs.size() * sizeof(ContactEventBuffer::PairRecord));
+    }
+}
+
+void PhysicsWorld::restoreSnapshot(const WorldSnapshot& snapshot) {
+    WorldSnapshot::Header header = snapshot.getHeader();
+    if (header.bodyCount != bodies.size() || header.particleCount != softBodies.getParticleCount()) {
+        throw std::invalid_argument("PhysicsWorld::restoreSnapshot body or particle count mismatch");
+    }
+
+    // 저장 순서를 스냅샷 때로 되돌린다 (그 뒤의 재배치로 달라진 풀이 순서까지 재현)
+    const BodyHandle* bodyOrder = static_cast<const BodyHandle*>(snapshot.getBodyOrder());
+    reorderOrder.resize(bodies.size());
+    reorderPlaced.assign(bodies.size(), 0);
+    for (std::size_t slot = 0; slot < bodies.size(); ++slot) {
+        std::size_t current = bodyHandles.getSlot(bodyOrder[slot]);
+        if (current == HandlePool::NO_SLOT || reorderPlaced[current]) {
+            throw std::invalid_argument("PhysicsWorld::restoreSnapshot body handles do not match this world");
+        }
+        reorderPlaced[current] = 1;
+        reorderOrder[slot] = current;
+    }
+    permuteBodies();
+    softBodies.setParticleOrder(static_cast<const std::uint64_t*>(snapshot.getParticleOrder()));
+
+    const PhysicsObject::State* states = static_cast<const PhysicsObject::State*>(snapshot.getBodies());
+    for (std::size_t index = 0; index < bodyHandles.getIndexCount(); ++index) {
+        BodyHandle handle = bodyHandles.getHandleAtIndex(index);
+        if (!handle.isNull()) {
+            bodies[bodyHandles.getSlot(handle)].setState(*states++);
+        }
+    }
+    std::size_t particleCount = static_cast<std::size_t>(header.particleCount);
+    const Vector3<double>* positions = static_cast<const Vector3<double>*>(snapshot.getPositions());
+    const Vector3<double>* velocities = static_cast<const Vector3<double>*>(snapshot.getVelocities());
+    for (std::size_t h = 0; h < particleCount; ++h) {
+        softBodies.setPosition(h, positions[h]);
+        softBodies.setVelocity(h, velocities[h]);
+    }
+    contactEvents.restorePreviousPairs(static_cast<const ContactEventBuffer::PairRecord*>(snapshot.getPairs()),
+        static_cast<std::size_t>(header.pairCount));
+    stepCount = header.frame;
+    publisher.publish(*this);
+}
+
+// 스텝 시작 때 큐에 쌓인 명령을 꺼내 물체별로 합쳐 적용 (스텝 도중 들어온 명령은 다음 스텝)
+// 명령의 물체 핸들은 여기서 슬롯으로 바꾸므로, 명령을 보낸 뒤에 재배치가 있어도 같은 물체에 적용되고
+// 그 사이 제거된 물체의 명령은 버려진다.
+void PhysicsWorld::applyCommands() {
+    pendingCommands.clear();
+    if (commands.drain(pendingCommands) > 0) {
+        applyBodyCommands(pendingCommands, bodyHandles, bodies.data());
+    }
+}
+
+// 회전 행렬로부터 월드 역관성 텐서를 스텝당 한 번 일괄 갱신 (이후 명령/폭발/토크/충격량 적용은 캐시를 읽음)
+// 명령이 회전을 바꾸면 setOrientation 이 그 물체만 다시 갱신한다. 잠든 물체는 잠들 때 갱신해 두므로 건너뛴다.
+void PhysicsWorld::updateWorldInertias() {
+    threadPool->parallelFor(bodies.size(), [&](std::size_t i) {
+        PhysicsObject& body = bodies[i];
+        if (!body.isStatic() && !body.isSleeping()) {
+            body.updateWorldInertia();
+        }
+    });
+}
+
+// 등록된 힘 생성기를 일괄 평가하여 깨어 있는 동적 물체의 외력에 누적
+void PhysicsWorld::applyForces() {
+    forces.apply(bodies.data(), bodies.size());
+}
+
+// 바닥 평면 또는 지형과의 접촉 생성
+// 지형은 깨어 있는 동적 물체의 위치를 모아 높이/법선을 한 번에 질의하고, 접촉점 부근을 국소 평면으로 근사한다.
+void PhysicsWorld::detectGroundContacts() {
+    if (!terrain) {
+        Contact c{};
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            if (!bodies[i].isStatic() && makeGroundContact(i, c)) {
+                contacts.push_back(c);
+            }
+        }
+        return;
+    }
+
+    groundQueryBodies.clear();
+    groundQueryPoints.clear();
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (!bodies[i].isStatic()) {
+            groundQueryBodies.push_back(i);
+            groundQueryPoints.push_back(bodies[i].getPosition());
+        }
+    }
+    groundQueryHeights.resize(groundQueryPoints.size());
+    groundQueryNormals.resize(groundQueryPoints.size());
+    terrain->getHeightsAndNormals(groundQueryPoints.data(), groundQueryPoints.size(),
+        groundQueryHeights.data(), groundQueryNormals.data());
+
+    for (std::size_t q = 0; q < groundQueryBodies.size(); ++q) {
+        const Vector3<double>& pos = groundQueryPoints[q];
+        const Vector3<double>& normal = groundQueryNormals[q];
+        double radius = bodies[groundQueryBodies[q]].getBoundingRadius();
+
+        // 지면 위 점 (x, h, z) 을 지나는 접평면까지의 거리
+        double distance = (pos.y - groundQueryHeights[q]) * normal.y;
+        if (distance < radius) {
+            Contact c{};
+            c.bodyA = Contact::STATIC_BODY;
+            c.bodyB = groundQueryBodies[q];
+            c.normal = normal;
+            c.point = pos - normal * distance;
+            c.penetration = radius - distance;
+            contacts.push_back(c);
+        }
+    }
+}
+
+// 경계 구 기반 접촉 생성 (x 축 Sweep and Prune + 바닥 평면/지형)
+void PhysicsWorld::detectContacts() {
+    contacts.clear();
+    detectGroundContacts();
+
+    sweepOrder.resize(bodies.size());
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        sweepOrder[i] = i;
+    }
+    std::sort(sweepOrder.begin(), sweepOrder.end(), [&](std::size_t a, std::size_t b) {
+        return bodies[a].getPosition().x - bodies[a].getBoundingRadius()
+            < bodies[b].getPosition().x - bodies[b].getBoundingRadius();
+    });
+
+    for (std::size_t s = 0; s < sweepOrder.size(); ++s) {
+        std::size_t a = sweepOrder[s];
+        const PhysicsObject& bodyA = bodies[a];
+        Vector3<double> posA = bodyA.getPosition();
+        double radiusA = bodyA.getBoundingRadius();
+
+        double maxX = posA.x + radiusA;
+        for (std::size_t t = s + 1; t < sweepOrder.size(); ++t) {
+            std::size_t b = sweepOrder[t];
+            const PhysicsObject& bodyB = bodies[b];
+            Vector3<double> posB = bodyB.getPosition();
+            double radiusB = bodyB.getBoundingRadius();
+            if (posB.x - radiusB > maxX) {
+                break;
+            }
+            if (bodyA.isStatic() && bodyB.isStatic()) {
+                continue;
+            }
+
+            Contact c{};
+            if (makePairContact(a, b, c)) {
+                contacts.push_back(c);
+            }
+        }
+    }
+}
+
+// 물체 하나와 바닥 평면/지형의 접촉 (떨어져 있으면 false)
+bool PhysicsWorld::makeGroundContact(std::size_t index, Contact& out) const {
+    const PhysicsObject& body = bodies[index];
+    Vector3<double> pos = body.getPosition();
+    double radius = body.getBoundingRadius();
+
+    if (!terrain) {
+        if (pos.y - radius >= groundHeight) {
+            return false;
+        }
+        out = Contact{};
+        out.bodyA = Contact::STATIC_BODY;
+        out.bodyB = index;
+        out.normal = Vector3<double>(0.0, 1.0, 0.0);
+        out.point = Vector3<double>(pos.x, groundHeight, pos.z);
+        out.penetration = groundHeight - (pos.y - radius);
+        return true;
+    }
+
+    Vector3<double> normal;
+    double height = terrain->getHeightAndNormal(pos.x, pos.z, normal);
+    double distance = (pos.y - height) * normal.y;
+    if (distance >= radius) {
+        return false;
+    }
+    out = Contact{};
+    out.bodyA = Contact::STATIC_BODY;
+    out.bodyB = index;
+    out.normal = normal;
+    out.point = pos - normal * distance;
+    out.penetration = radius - distance;
+    return true;
+}
+
+// 두 물체의 경계 구 접촉 (겹치지 않으면 false)
+bool PhysicsWorld::makePairContact(std::size_t a, std::size_t b, Contact& out) const {
+    Vector3<double> posA = bodies[a].getPosition();
+    double radiusA = bodies[a].getBoundingRadius();
+    Vector3<double> delta = bodies[b].getPosition() - posA;
+    double distance = delta.magnitude();
+    double radiusSum = radiusA + bodies[b].getBoundingRadius();
+    if (distance >= radiusSum) {
+        return false;
+    }
+
+    out = Contact{};
+    out.bodyA = a;
+    out.bodyB = b;
+    out.normal = distance > Constants<double>::TOLERANCE ? delta / distance : Vector3<double>(0.0, 1.0, 0.0);
+    out.point = posA + out.normal * (radiusA - 0.5 * (radiusSum - distance));
+    out.penetration = radiusSum - distance;
+    return true;
+}
+
+// 섬마다 부분 스텝 단계 선택: 필요한 부분 스텝 수를 세 기준의 최댓값으로 잡고 2 의 거듭제곱으로 올린다.
+// - 접촉 상태: 접촉 중이면서 수면 한계 아래로 느려진 물체는 기준에서 뺀다 (쌓여 쉬는 물체는 한 번에 진행)
+// - 속도: 부분 스텝당 이동 거리(선속도 + 각속도 * 반지름)가 substepMotionFraction * 반지름 이하
+// - 오차: 고정 외력 가정의 위치 오차 ½|a - a_prev| dt² 를 부분 스텝 수로 나눈 값이 substepTolerance 이하
+void PhysicsWorld::chooseSubstepLevels(double deltaTime) {
+    const bool coarsenDistant = budgetController.coarsensDistantBodies();
+    std::atomic<std::size_t> coarsened(0);
+    threadPool->parallelFor(islands.size(), [&](std::size_t i) {
+        Island& island = islands[i];
+        island.substepLevel = 0;
+        if (island.sleeping || maxSubstepLevel == 0 || island.contacts.size() >= batchedIslandThreshold) {
+            return;
+        }
+
+        double required = 1.0;
+        for (std::size_t b : island.bodies) {
+            const PhysicsObject& body = bodies[b];
+            if (!island.contacts.empty() && body.getSleepTimer() > 0.0) {
+                continue;
+            }
+            double radius = std::max(body.getBoundingRadius(), Constants<double>::TOLERANCE);
+            double speed = body.getVelocity().magnitude() + body.getAngularVelocity().magnitude() * radius;
+            required = std::max(required, speed * deltaTime / (substepMotionFraction * radius));
+
+            const PhysicsObject::State& state = body.getState();
+            Vector3<double> change = state.force / state.mass - state.acceleration;
+            required = std::max(required, 0.5 * change.magnitude() * deltaTime * deltaTime / substepTolerance);
+        }
+
+        unsigned level = 0;
+        while (level < maxSubstepLevel && static_cast<double>(1u << level) < required) {
+            ++level;
+        }
+        // 시간 예산 저하: 초점에서 먼 섬은 부분 스텝 없이 진행
+        if (level > 0 && coarsenDistant && isFarIsland(island)) {
+            level = 0;
+            coarsened.fetch_add(1, std::memory_order_relaxed);
+        }
+        island.substepLevel = level;
+    });
+    lastReport.coarsenedIslands = coarsened.load();
+}
+
+// 섬의 모든 물체가 시간 예산의 모든 초점에서 farDistance 보다 멀리 있는지 (초점이 없으면 항상 먼 섬)
+bool PhysicsWorld::isFarIsland(const Island& island) const {
+    const FrameBudget& budget = budgetController.getBudget();
+    double far2 = budget.farDistance * budget.farDistance;
+    for (std::size_t b : island.bodies) {
+        Vector3<double> p = bodies[b].getPosition();
+        for (const Vector3<double>& focus : budget.focusPoints) {
+            Vector3<double> d = p - focus;
+            if (d * d <= far2) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 깨어 있는 섬을 스레드 풀에서 병렬로 풀고, 섬 단위로 위치 적분과 수면 판정을 수행
+// 큰 섬은 섬 하나가 병렬성을 독차지하므로 섬 내부를 색칠된 배치 단위로 나누어 따로 푼다.
+void PhysicsWorld::solveIslands(double deltaTime) {
+    largeIslands.clear();
+    for (std::size_t i = 0; i < islands.size(); ++i) {
+        if (!islands[i].sleeping && islands[i].contacts.size() >= batchedIslandThreshold) {
+            largeIslands.push_back(i);
+        }
+    }
+
+    for (std::size_t i : largeIslands) {
+        integrateIslandVelocities(islands[i], deltaTime);
+        solver.solveIslandBatched(bodies, contacts, joints, islands[i], batcher, *threadPool, deltaTime);
+        finishIsland(islands[i], deltaTime);
+    }
+
+    substepContacts.resize(islands.size());
+    substepIslands.resize(islands.size());
+    substepSources.resize(islands.size());
+    groundContactOf.resize(bodies.size());
+    threadPool->parallelFor(islands.size(), [&](std::size_t i) {
+        Island& island = islands[i];
+        if (island.sleeping || island.contacts.size() >= batchedIslandThreshold) {
+            return;
+        }
+        if (island.substepLevel > 0) {
+            substepIsland(i, deltaTime);
+            return;
+        }
+        integrateIslandVelocities(island, deltaTime);
+        solver.solveIsland(bodies, contacts, joints, island, deltaTime);
+        finishIsland(island, deltaTime);
+    });
+}
+
+// 섬 물체의 누적 외력과 토크로 속도 적분
+void PhysicsWorld::integrateIslandVelocities(const Island& island, double deltaTime) {
+    for (std::size_t b : island.bodies) {
+        bodies[b].integrateVelocity(deltaTime);
+    }
+}
+
+// 섬을 2^substepLevel 개의 부분 스텝으로 진행 (접촉은 섬 전용 버퍼에 부분 스텝마다 다시 만든다)
+// 부분 스텝 접촉의 충격량은 같은 물체 쌍의 프레임 접촉에 합산하여 접촉 이벤트가 한 스텝 전체의 충격량을 보고하게 한다.
+void PhysicsWorld::substepIsland(std::size_t index, double deltaTime) {
+    Island& island = islands[index];
+    std::vector<Contact>& local = substepContacts[index];
+    std::vector<std::size_t>& sources = substepSources[index];
+    Island& localIsland = substepIslands[index];
+
+    // 섬의 물체 슬롯만 건드리므로 다른 섬과 동시에 채워도 된다
+    for (std::size_t b : island.bodies) {
+        groundContactOf[b] = NO_CONTACT;
+    }
+    for (std::size_t k : island.contacts) {
+        Contact& frameContact = contacts[k];
+        frameContact.normalImpulse = 0.0;
+        frameContact.tangentImpulse = 0.0;
+        if (frameContact.bodyA == Contact::STATIC_BODY) {
+            groundContactOf[frameContact.bodyB] = k;
+        }
+    }
+    localIsland.bodies = island.bodies;
+    localIsland.joints = island.joints;
+    localIsland.sleeping = false;
+    localIsland.substepLevel = 0;
+
+    const std::size_t count = std::size_t(1) << island.substepLevel;
+    const double h = deltaTime / static_cast<double>(count);
+    for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t b : island.bodies) {
+            bodies[b].integrateVelocity(h, s + 1 == count);
+        }
+
+        local.clear();
+        sources.clear();
+        Contact c{};
+        for (std::size_t b : island.bodies) {
+            if (makeGroundContact(b, c)) {
+                local.push_back(c);
+                sources.push_back(groundContactOf[b]);
+            }
+        }
+        for (std::size_t k : island.contacts) {
+            const Contact& frameContact = contacts[k];
+            if (frameContact.bodyA != Contact::STATIC_BODY && makePairContact(frameContact.bodyA, frameContact.bodyB, c)) {
+                local.push_back(c);
+                sources.push_back(k);
+            }
+        }
+        localIsland.contacts.resize(local.size());
+        for (std::size_t k = 0; k < local.size(); ++k) {
+            localIsland.contacts[k] = k;
+        }
+
+        solver.solveIsland(bodies, local, joints, localIsland, h);
+        for (std::size_t k = 0; k < local.size(); ++k) {
+            if (sources[k] != NO_CONTACT) {
+                contacts[sources[k]].normalImpulse += local[k].normalImpulse;
+                contacts[sources[k]].tangentImpulse += local[k].tangentImpulse;
+            }
+        }
+        for (std::size_t b : island.bodies) {
+            bodies[b].integratePosition(h);
+        }
+    }
+    if (sleepCheckThisStep) {
+        updateIslandSleep(island, sleepCheckTime);
+    }
+}
+
+// 연성체 입자를 강체의 새 위치에 대해 진행하고, 입자가 밀어낸 만큼 강체에 반작용 충격량을 준다
+void PhysicsWorld::stepSoftBodies(double deltaTime) {
+    if (softBodies.getParticleCount() == 0) {
+        return;
+    }
+    softBodies.gravity = gravity->getGravity();
+    softBodies.step(deltaTime, *threadPool, bodies, groundHeight, terrain.get());
+}
+
+// 풀이가 끝난 섬의 위치 적분과 수면 판정 (수면 판정이 지연된 스텝에는 건너뜀)
+void PhysicsWorld::finishIsland(Island& island, double deltaTime) {
+    for (std::size_t b : island.bodies) {
+        bodies[b].integratePosition(deltaTime);
+    }
+    if (sleepCheckThisStep) {
+        updateIslandSleep(island, sleepCheckTime);
+    }
+}
+
+// 섬의 모든 물체가 timeToSleep 동안 정지해 있으면 섬 전체를 재운다
+void PhysicsWorld::updateIslandSleep(Island& island, double deltaTime) {
+    double linear2 = sleepLinearThreshold * sleepLinearThreshold;
+    double angular2 = sleepAngularThreshold * sleepAngularThreshold;
+    double minTimer = timeToSleep;
+
+    for (std::size_t b : island.bodies) {
+        PhysicsObject& body = bodies[b];
+        Vector3<double> v = body.getVelocity();
+        Vector3<double> w = body.getAngularVelocity();
+        if (v * v > linear2 || w * w > angular2) {
+            body.setSleepTimer(0.0);
+        }
+        else {
+            body.setSleepTimer(body.getSleepTimer() + deltaTime);
+        }
+        minTimer = std::min(minTimer, body.getSleepTimer());
+    }
+
+    // 잠든 동안 회전이 바뀌지 않으므로, 마지막 적분으로 돈 회전에 맞춰 캐시를 갱신해 두면 깨울 때 바로 쓸 수 있다
+    if (minTimer >= timeToSleep) {
+        for (std::size_t b : island.bodies) {
+            bodies[b].setSleeping(true);
+            bodies[b].updateWorldInertia();
+        }
+        island.sleeping = true;
+    }
+}
+
+#endif // PHYSICSWORLD_CPP
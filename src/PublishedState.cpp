@@ -0,0 +1,74 @@
+﻿#ifndef PUBLISHEDSTATE_CPP
+#define PUBLISHEDSTATE_CPP
+
+#include <algorithm>
+#include "PublishedState.h"
+#include "PhysicsWorld.h"
+
+StateReader::StateReader()
+    : middle(1u), front(0u), back(2u)
+{
+    for (PublishedFrame& buffer : buffers) {
+        buffer.frame = 0;
+    }
+}
+
+const PublishedFrame& StateReader::acquire() {
+    if (middle.load(std::memory_order_relaxed) & FRESH) {
+        // 발행자가 쓴 내용이 보이도록 acquire, 돌려주는 앞 버퍼의 읽기가 끝났음을 알리도록 release
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    return buffers[front];
+}
+
+void StateReader::swapBack() {
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+}
+
+std::shared_ptr<StateReader> StatePublisher::createReader() {
+    readers.push_back(std::make_shared<StateReader>());
+    return readers.back();
+}
+
+void StatePublisher::publish(const PhysicsWorld& world) {
+    // 발행자만 사본을 들고 있는 독자는 더 이상 읽히지 않는다
+    readers.erase(std::remove_if(readers.begin(), readers.end(),
+        [](const std::shared_ptr<StateReader>& r) { return r.use_count() == 1; }), readers.end());
+    if (readers.empty()) {
+        return;
+    }
+
+    staging.frame = world.getStepCount();
+    // 핸들 번호로 바로 찾을 수 있도록 번호 순서로 담고, 비어 있는 번호는 null 핸들로 둔다
+    const std::vector<PhysicsObject>& bodies = world.getBodies();
+    staging.bodies.resize(world.getBodyIndexCount());
+    for (std::size_t index = 0; index < staging.bodies.size(); ++index) {
+        PublishedBody& out = staging.bodies[index];
+        out.handle = world.getBodyHandleAtIndex(index);
+        if (out.handle.isNull()) {
+            continue;
+        }
+        const PhysicsObject::State& state = bodies[world.getBodySlot(out.handle)].getState();
+        out.position = state.position;
+        out.orientation = state.orientation;
+        out.velocity = state.velocity;
+        out.angularVelocity = state.angularVelocity;
+        out.sleeping = state.sleeping;
+    }
+    const XPBDSolver& softBodies = world.getSoftBodies();
+    staging.particles.resize(softBodies.getParticleCount());
+    for (std::size_t i = 0; i < staging.particles.size(); ++i) {
+        staging.particles[i] = softBodies.getPosition(i);
+    }
+
+    // 버퍼 용량은 재사용되므로 물체 수가 그대로면 할당이 없다
+    for (const std::shared_ptr<StateReader>& reader : readers) {
+        PublishedFrame& buffer = reader->getBackBuffer();
+        buffer.frame = staging.frame;
+        buffer.bodies.assign(staging.bodies.begin(), staging.bodies.end());
+        buffer.particles.assign(staging.particles.begin(), staging.particles.end());
+        reader->swapBack();
+    }
+}
+
+#endif // PUBLISHEDSTATE_CPP
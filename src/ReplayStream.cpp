@@ -0,0 +1,645 @@
+﻿#ifndef REPLAYSTREAM_CPP
+#define REPLAYSTREAM_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "ReplayStream.h"
+#include "PhysicsWorld.h"
+
+namespace {
+    const std::uint8_t STREAM_MAGIC[4] = { 'G', 'P', 'R', 'P' };
+    const std::uint8_t INDEX_MAGIC[4] = { 'G', 'P', 'R', 'X' };
+    const std::uint32_t STREAM_VERSION = 1;
+    const std::size_t HEADER_SIZE = 44;
+    const std::size_t FRAME_HEADER_SIZE = 5;
+    const std::size_t TRAILER_SIZE = 12;
+
+    enum FrameKind : std::uint8_t {
+        KEY_FRAME = 0,
+        DELTA_FRAME = 1,
+        INDEX_FRAME = 2
+    };
+
+    const double SQRT2 = 1.41421356237309504880;
+
+    // 리틀 엔디언 고정 길이 정수/실수 읽기/쓰기
+    void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void putU64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void putF64(std::vector<std::uint8_t>& out, double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        putU64(out, bits);
+    }
+
+    std::uint32_t getU32(const std::uint8_t* p) {
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    std::uint64_t getU64(const std::uint8_t* p) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    double getF64(const std::uint8_t* p) {
+        std::uint64_t bits = getU64(p);
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    // 적응형 이진 산술(범위) 부호기: 11 비트 확률, 적응 속도 1/32
+    const std::uint16_t PROBABILITY_ONE = 1 << 11;
+    const int ADAPT_SHIFT = 5;
+    const std::uint32_t RANGE_TOP = 1u << 24;
+
+    class RangeEncoder {
+    public:
+        explicit RangeEncoder(std::vector<std::uint8_t>& out) : out(out), low(0), range(0xFFFFFFFFu), cache(0), cacheSize(1) {}
+
+        void encodeBit(std::uint16_t& probability, int bit) {
+            std::uint32_t bound = (range >> 11) * probability;
+            if (bit == 0) {
+                range = bound;
+                probability += (PROBABILITY_ONE - probability) >> ADAPT_SHIFT;
+            }
+            else {
+                low += bound;
+                range -= bound;
+                probability -= probability >> ADAPT_SHIFT;
+            }
+            normalize();
+        }
+
+        // 확률 1/2 고정 비트
+        void encodeDirect(int bit) {
+            range >>= 1;
+            if (bit) {
+                low += range;
+            }
+            normalize();
+        }
+
+        void flush() {
+            for (int i = 0; i < 5; ++i) {
+                shiftLow();
+            }
+        }
+
+    private:
+        std::vector<std::uint8_t>& out;
+        std::uint64_t low;
+        std::uint32_t range;
+        std::uint8_t cache;
+        std::uint64_t cacheSize;
+
+        void normalize() {
+            while (range < RANGE_TOP) {
+                range <<= 8;
+                shiftLow();
+            }
+        }
+
+        // 자리 올림을 지연 처리하며 상위 바이트 출력
+        void shiftLow() {
+            if (static_cast<std::uint32_t>(low) < 0xFF000000u || (low >> 32) != 0) {
+                std::uint8_t carry = static_cast<std::uint8_t>(low >> 32);
+                std::uint8_t pending = cache;
+                do {
+                    out.push_back(static_cast<std::uint8_t>(pending + carry));
+                    pending = 0xFF;
+                } while (--cacheSize != 0);
+                cache = static_cast<std::uint8_t>(low >> 24);
+            }
+            ++cacheSize;
+            low = (low & 0x00FFFFFFu) << 8;
+        }
+    };
+
+    class RangeDecoder {
+    public:
+        RangeDecoder(const std::uint8_t* data, std::size_t size) : data(data), size(size), position(0), range(0xFFFFFFFFu), code(0) {
+            for (int i = 0; i < 5; ++i) {
+                code = (code << 8) | next();
+            }
+        }
+
+        int decodeBit(std::uint16_t& probability) {
+            std::uint32_t bound = (range >> 11) * probability;
+            int bit;
+            if (code < bound) {
+                range = bound;
+                probability += (PROBABILITY_ONE - probability) >> ADAPT_SHIFT;
+                bit = 0;
+            }
+            else {
+                code -= bound;
+                range -= bound;
+                probability -= probability >> ADAPT_SHIFT;
+                bit = 1;
+            }
+            normalize();
+            return bit;
+        }
+
+        int decodeDirect() {
+            range >>= 1;
+            int bit = code >= range ? 1 : 0;
+            if (bit) {
+                code -= range;
+            }
+            normalize();
+            return bit;
+        }
+
+    private:
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t position;
+        std::uint32_t range;
+        std::uint32_t code;
+
+        std::uint32_t next() { return position < size ? data[position++] : 0; }
+
+        void normalize() {
+            while (range < RANGE_TOP) {
+                range <<= 8;
+                code = (code << 8) | next();
+            }
+        }
+    };
+
+    // 부호 있는 정수: 0 여부 → 부호 → 크기의 비트 길이(단항, 적응형) → 나머지 비트(고정 확률)
+    // 작은 잔차가 대부분인 델타 프레임에서 비트 길이 분포를 학습한다.
+    void encodeInteger(RangeEncoder& encoder, ReplayCodecState::IntegerModel& model, std::int64_t value) {
+        encoder.encodeBit(model.zero, value == 0 ? 0 : 1);
+        if (value == 0) {
+            return;
+        }
+        encoder.encodeBit(model.sign, value < 0 ? 1 : 0);
+        std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+
+        int length = 1;
+        while (length < 64 && (magnitude >> length) != 0) {
+            ++length;
+        }
+        for (int k = 1; k < length; ++k) {
+            encoder.encodeBit(model.length[k], 1);
+        }
+        if (length < 64) {
+            encoder.encodeBit(model.length[length], 0);
+        }
+        for (int k = length - 2; k >= 0; --k) {
+            encoder.encodeDirect(static_cast<int>((magnitude >> k) & 1u));
+        }
+    }
+
+    std::int64_t decodeInteger(RangeDecoder& decoder, ReplayCodecState::IntegerModel& model) {
+        if (decoder.decodeBit(model.zero) == 0) {
+            return 0;
+        }
+        bool negative = decoder.decodeBit(model.sign) != 0;
+
+        int length = 1;
+        while (length < 64 && decoder.decodeBit(model.length[length]) != 0) {
+            ++length;
+        }
+        std::uint64_t magnitude = 1;
+        for (int k = length - 2; k >= 0; --k) {
+            magnitude = (magnitude << 1) | static_cast<std::uint64_t>(decoder.decodeDirect());
+        }
+        return negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+    }
+
+    std::int64_t quantize(double value, double resolution) {
+        return std::llround(value / resolution);
+    }
+
+    // smallest-three: 가장 큰 성분을 양수로 맞추고 버린 뒤, 나머지 세 성분을 [-1/√2, 1/√2] 범위에서 양자화
+    void quantizeOrientation(const Quaternion<double>& q, std::uint32_t bits, std::uint8_t& largest, std::int64_t* components) {
+        double c[4] = { q.n, q.v.x, q.v.y, q.v.z };
+        double norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+        if (norm == 0.0) {
+            c[0] = 1.0;
+            norm = 1.0;
+        }
+        largest = 0;
+        for (std::uint8_t i = 1; i < 4; ++i) {
+            if (std::fabs(c[i]) > std::fabs(c[largest])) {
+                largest = i;
+            }
+        }
+        double sign = c[largest] < 0.0 ? -1.0 : 1.0;
+        std::int64_t maxValue = (std::int64_t(1) << (bits - 1)) - 1;
+        for (int i = 0, k = 0; i < 4; ++i) {
+            if (i == largest) {
+                continue;
+            }
+            std::int64_t v = std::llround(sign * c[i] / norm * SQRT2 * static_cast<double>(maxValue));
+            components[k++] = std::max(-maxValue, std::min(maxValue, v));
+        }
+    }
+
+    Quaternion<double> dequantizeOrientation(std::uint8_t largest, const std::int64_t* components, std::uint32_t bits) {
+        double maxValue = static_cast<double>((std::int64_t(1) << (bits - 1)) - 1);
+        double c[4];
+        double sum = 0.0;
+        for (int i = 0, k = 0; i < 4; ++i) {
+            if (i == largest) {
+                continue;
+            }
+            c[i] = static_cast<double>(components[k++]) / maxValue / SQRT2;
+            sum += c[i] * c[i];
+        }
+        c[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+        Quaternion<double> q(c[0], c[1], c[2], c[3]);
+        q.normalize();
+        return q;
+    }
+
+    void encodeLargest(RangeEncoder& encoder, ReplayCodecState& state, std::uint8_t largest) {
+        int high = largest >> 1;
+        encoder.encodeBit(state.largestBits[0], high);
+        encoder.encodeBit(state.largestBits[1 + high], largest & 1);
+    }
+
+    std::uint8_t decodeLargest(RangeDecoder& decoder, ReplayCodecState& state) {
+        int high = decoder.decodeBit(state.largestBits[0]);
+        int low = decoder.decodeBit(state.largestBits[1 + high]);
+        return static_cast<std::uint8_t>((high << 1) | low);
+    }
+
+    // 직전 위치와 속도로 이번 위치를 예측 (부호기/복호기가 같은 연산으로 같은 값을 얻음)
+    std::int64_t predictPosition(std::int64_t position, std::int64_t velocity, double velocityToPosition) {
+        return position + std::llround(static_cast<double>(velocity) * velocityToPosition);
+    }
+}
+
+void ReplayCodecState::resize(std::size_t bodyCount) {
+    positions.assign(3 * bodyCount, 0);
+    velocities.assign(3 * bodyCount, 0);
+    orientations.assign(3 * bodyCount, 0);
+    largest.assign(bodyCount, 0);
+    resetModels();
+}
+
+void ReplayCodecState::resetModels() {
+    IntegerModel* models[3] = { &positionModel, &velocityModel, &orientationModel };
+    for (IntegerModel* model : models) {
+        model->zero = PROBABILITY_ONE / 2;
+        model->sign = PROBABILITY_ONE / 2;
+        std::fill(model->length, model->length + 64, static_cast<std::uint16_t>(PROBABILITY_ONE / 2));
+    }
+    largestChanged = PROBABILITY_ONE / 2;
+    std::fill(largestBits, largestBits + 3, static_cast<std::uint16_t>(PROBABILITY_ONE / 2));
+}
+
+ReplayWriter::ReplayWriter(std::ostream& out, std::size_t bodyCount, double frameInterval, const ReplaySettings& settings)
+    : out(out), bodyCount(bodyCount), frameInterval(frameInterval), settings(settings),
+    frameCount(0), byteCount(0), closed(false)
+{
+    if (bodyCount == 0 || frameInterval <= 0.0) {
+        throw std::invalid_argument("ReplayWriter requires at least one body and a positive frame interval");
+    }
+    if (settings.positionResolution <= 0.0 || settings.velocityResolution <= 0.0 ||
+        settings.orientationBits < 2 || settings.orientationBits > 31 || settings.keyframeInterval == 0) {
+        throw std::invalid_argument("ReplayWriter invalid quantization settings");
+    }
+    state.resize(bodyCount);
+
+    payload.clear();
+    payload.insert(payload.end(), STREAM_MAGIC, STREAM_MAGIC + 4);
+    putU32(payload, STREAM_VERSION);
+    putU32(payload, static_cast<std::uint32_t>(bodyCount));
+    putU32(payload, settings.keyframeInterval);
+    putU32(payload, settings.orientationBits);
+    putF64(payload, frameInterval);
+    putF64(payload, settings.positionResolution);
+    putF64(payload, settings.velocityResolution);
+    writeBytes(payload.data(), payload.size());
+}
+
+ReplayWriter::~ReplayWriter() {
+    if (!closed) {
+        try {
+            close();
+        }
+        catch (...) {
+            // 소멸자에서는 예외를 전파하지 않음 (색인이 없어도 복호기는 프레임을 훑어 탐색)
+        }
+    }
+}
+
+void ReplayWriter::writeBytes(const std::uint8_t* data, std::size_t size) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) {
+        throw std::runtime_error("ReplayWriter failed to write to stream");
+    }
+    byteCount += size;
+}
+
+void ReplayWriter::writeFrame(const ReplayBody* bodies) {
+    if (closed) {
+        throw std::runtime_error("ReplayWriter::writeFrame after close");
+    }
+
+    bool key = frameCount % settings.keyframeInterval == 0;
+    if (key) {
+        state.resetModels();
+        keyframes.emplace_back(frameCount, byteCount);
+    }
+    const double velocityToPosition = settings.velocityResolution * frameInterval / settings.positionResolution;
+
+    payload.clear();
+    RangeEncoder encoder(payload);
+    for (std::size_t b = 0; b < bodyCount; ++b) {
+        const ReplayBody& body = bodies[b];
+        std::int64_t* position = &state.positions[3 * b];
+        std::int64_t* velocity = &state.velocities[3 * b];
+        std::int64_t* orientation = &state.orientations[3 * b];
+
+        std::int64_t p[3] = {
+            quantize(body.position.x, settings.positionResolution),
+            quantize(body.position.y, settings.positionResolution),
+            quantize(body.position.z, settings.positionResolution)
+        };
+        std::int64_t v[3] = {
+            quantize(body.velocity.x, settings.velocityResolution),
+            quantize(body.velocity.y, settings.velocityResolution),
+            quantize(body.velocity.z, settings.velocityResolution)
+        };
+        std::uint8_t largest;
+        std::int64_t o[3];
+        quantizeOrientation(body.orientation, settings.orientationBits, largest, o);
+
+        if (key) {
+            for (int k = 0; k < 3; ++k) encodeInteger(encoder, state.positionModel, p[k]);
+            for (int k = 0; k < 3; ++k) encodeInteger(encoder, state.velocityModel, v[k]);
+            encodeLargest(encoder, state, largest);
+            for (int k = 0; k < 3; ++k) encodeInteger(encoder, state.orientationModel, o[k]);
+        }
+        else {
+            for (int k = 0; k < 3; ++k) {
+                encodeInteger(encoder, state.positionModel, p[k] - predictPosition(position[k], velocity[k], velocityToPosition));
+            }
+            for (int k = 0; k < 3; ++k) encodeInteger(encoder, state.velocityModel, v[k] - velocity[k]);
+            bool changed = largest != state.largest[b];
+            encoder.encodeBit(state.largestChanged, changed ? 1 : 0);
+            if (changed) {
+                encodeLargest(encoder, state, largest);
+            }
+            for (int k = 0; k < 3; ++k) {
+                encodeInteger(encoder, state.orientationModel, changed ? o[k] : o[k] - orientation[k]);
+            }
+        }
+
+        std::copy(p, p + 3, position);
+        std::copy(v, v + 3, velocity);
+        std::copy(o, o + 3, orientation);
+        state.largest[b] = largest;
+    }
+    encoder.flush();
+
+    std::uint8_t frameHeader[FRAME_HEADER_SIZE] = { static_cast<std::uint8_t>(key ? KEY_FRAME : DELTA_FRAME) };
+    for (int i = 0; i < 4; ++i) {
+        frameHeader[1 + i] = static_cast<std::uint8_t>(payload.size() >> (8 * i));
+    }
+    writeBytes(frameHeader, FRAME_HEADER_SIZE);
+    writeBytes(payload.data(), payload.size());
+    ++frameCount;
+}
+
+void ReplayWriter::writeFrame(const PhysicsWorld& world) {
+    if (world.getBodyCount() != bodyCount) {
+        throw std::invalid_argument("ReplayWriter::writeFrame world body count mismatch");
+    }
+    // 살아 있는 물체를 핸들 번호 순서로 기록한다
+    gathered.clear();
+    for (std::size_t index = 0; index < world.getBodyIndexCount(); ++index) {
+        BodyHandle handle = world.getBodyHandleAtIndex(index);
+        if (!handle.isNull()) {
+            const PhysicsObject& body = world.getBodies()[world.getBodySlot(handle)];
+            gathered.push_back(ReplayBody{ body.getPosition(), body.getOrientation(), body.getVelocity() });
+        }
+    }
+    writeFrame(gathered.data());
+}
+
+// 색인 프레임 [개수 | 전체 프레임 수 | (프레임, 위치)...] 과 꼬리 [색인 위치 | 매직] 기록
+void ReplayWriter::close() {
+    if (closed) {
+        return;
+    }
+    closed = true;
+
+    std::uint64_t indexOffset = byteCount;
+    payload.clear();
+    payload.push_back(INDEX_FRAME);
+    putU32(payload, static_cast<std::uint32_t>(16 + 16 * keyframes.size()));
+    putU64(payload, keyframes.size());
+    putU64(payload, frameCount);
+    for (const auto& entry : keyframes) {
+        putU64(payload, entry.first);
+        putU64(payload, entry.second);
+    }
+    putU64(payload, indexOffset);
+    payload.insert(payload.end(), INDEX_MAGIC, INDEX_MAGIC + 4);
+    writeBytes(payload.data(), payload.size());
+    out.flush();
+}
+
+ReplayReader::ReplayReader(std::istream& in)
+    : in(in), origin(in.tellg()), bodyCount(0), frameInterval(0.0),
+    frameIndex(0), byteOffset(HEADER_SIZE), finished(false), totalFrames(0), indexLoaded(false)
+{
+    std::uint8_t header[HEADER_SIZE];
+    if (!readBytes(header, HEADER_SIZE) || std::memcmp(header, STREAM_MAGIC, 4) != 0) {
+        throw std::runtime_error("ReplayReader: not a replay stream");
+    }
+    if (getU32(header + 4) != STREAM_VERSION) {
+        throw std::runtime_error("ReplayReader: unsupported replay stream version");
+    }
+    bodyCount = getU32(header + 8);
+    settings.keyframeInterval = getU32(header + 12);
+    settings.orientationBits = getU32(header + 16);
+    frameInterval = getF64(header + 20);
+    settings.positionResolution = getF64(header + 28);
+    settings.velocityResolution = getF64(header + 36);
+    if (bodyCount == 0 || settings.keyframeInterval == 0 || settings.orientationBits < 2 || settings.orientationBits > 31) {
+        throw std::runtime_error("ReplayReader: corrupt replay stream header");
+    }
+    state.resize(bodyCount);
+}
+
+bool ReplayReader::readBytes(std::uint8_t* data, std::size_t size) {
+    in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(in.gcount()) == size;
+}
+
+bool ReplayReader::readFrame(std::vector<ReplayBody>& bodies) {
+    if (finished) {
+        return false;
+    }
+    std::uint8_t frameHeader[FRAME_HEADER_SIZE];
+    if (!readBytes(frameHeader, FRAME_HEADER_SIZE) || frameHeader[0] == INDEX_FRAME) {
+        // 색인 프레임 또는 (기록 중단으로) 잘린 스트림의 끝
+        finished = true;
+        return false;
+    }
+    if (frameHeader[0] != KEY_FRAME && frameHeader[0] != DELTA_FRAME) {
+        throw std::runtime_error("ReplayReader: corrupt frame header");
+    }
+    bool key = frameHeader[0] == KEY_FRAME;
+    std::size_t size = getU32(frameHeader + 1);
+    payload.resize(size);
+    if (!readBytes(payload.data(), size)) {
+        finished = true;
+        return false;
+    }
+    if (key) {
+        state.resetModels();
+    }
+
+    const double velocityToPosition = settings.velocityResolution * frameInterval / settings.positionResolution;
+    bodies.resize(bodyCount);
+    RangeDecoder decoder(payload.data(), payload.size());
+    for (std::size_t b = 0; b < bodyCount; ++b) {
+        std::int64_t* position = &state.positions[3 * b];
+        std::int64_t* velocity = &state.velocities[3 * b];
+        std::int64_t* orientation = &state.orientations[3 * b];
+
+        if (key) {
+            for (int k = 0; k < 3; ++k) position[k] = decodeInteger(decoder, state.positionModel);
+            for (int k = 0; k < 3; ++k) velocity[k] = decodeInteger(decoder, state.velocityModel);
+            state.largest[b] = decodeLargest(decoder, state);
+            for (int k = 0; k < 3; ++k) orientation[k] = decodeInteger(decoder, state.orientationModel);
+        }
+        else {
+            // 예측에는 직전 프레임 값이 필요하므로 속도를 갱신하기 전에 위치부터 복원
+            for (int k = 0; k < 3; ++k) {
+                position[k] = predictPosition(position[k], velocity[k], velocityToPosition) + decodeInteger(decoder, state.positionModel);
+            }
+            for (int k = 0; k < 3; ++k) velocity[k] += decodeInteger(decoder, state.velocityModel);
+            bool changed = decoder.decodeBit(state.largestChanged) != 0;
+            if (changed) {
+                state.largest[b] = decodeLargest(decoder, state);
+            }
+            for (int k = 0; k < 3; ++k) {
+                std::int64_t value = decodeInteger(decoder, state.orientationModel);
+                orientation[k] = changed ? value : orientation[k] + value;
+            }
+        }
+
+        ReplayBody& body = bodies[b];
+        body.position = Vector3<double>(position[0] * settings.positionResolution,
+            position[1] * settings.positionResolution, position[2] * settings.positionResolution);
+        body.velocity = Vector3<double>(velocity[0] * settings.velocityResolution,
+            velocity[1] * settings.velocityResolution, velocity[2] * settings.velocityResolution);
+        body.orientation = dequantizeOrientation(state.largest[b], orientation, settings.orientationBits);
+    }
+
+    byteOffset += FRAME_HEADER_SIZE + size;
+    ++frameIndex;
+    return true;
+}
+
+// 꼬리의 색인을 읽고, 없으면(기록이 중간에 끊긴 파일) 프레임 머리만 따라가며 키프레임 위치를 모은다
+void ReplayReader::loadIndex() {
+    if (indexLoaded) {
+        return;
+    }
+    in.clear();
+    keyframes.clear();
+
+    in.seekg(0, std::ios::end);
+    std::uint64_t streamSize = static_cast<std::uint64_t>(in.tellg() - origin);
+    std::uint8_t trailer[TRAILER_SIZE];
+    bool found = false;
+    if (streamSize >= HEADER_SIZE + TRAILER_SIZE) {
+        in.seekg(origin + static_cast<std::streamoff>(streamSize - TRAILER_SIZE));
+        if (readBytes(trailer, TRAILER_SIZE) && std::memcmp(trailer + 8, INDEX_MAGIC, 4) == 0) {
+            std::uint64_t indexOffset = getU64(trailer);
+            std::uint8_t head[FRAME_HEADER_SIZE + 16];
+            in.seekg(origin + static_cast<std::streamoff>(indexOffset));
+            if (readBytes(head, sizeof(head)) && head[0] == INDEX_FRAME) {
+                std::uint64_t count = getU64(head + FRAME_HEADER_SIZE);
+                totalFrames = getU64(head + FRAME_HEADER_SIZE + 8);
+                std::vector<std::uint8_t> entries(static_cast<std::size_t>(16 * count));
+                if (readBytes(entries.data(), entries.size())) {
+                    for (std::uint64_t i = 0; i < count; ++i) {
+                        keyframes.emplace_back(getU64(&entries[16 * i]), getU64(&entries[16 * i + 8]));
+                    }
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (!found) {
+        keyframes.clear();
+        totalFrames = 0;
+        std::uint64_t offset = HEADER_SIZE;
+        std::uint8_t frameHeader[FRAME_HEADER_SIZE];
+        in.clear();
+        in.seekg(origin + static_cast<std::streamoff>(offset));
+        while (readBytes(frameHeader, FRAME_HEADER_SIZE) && frameHeader[0] != INDEX_FRAME) {
+            std::uint64_t size = getU32(frameHeader + 1);
+            if (offset + FRAME_HEADER_SIZE + size > streamSize) {
+                break;
+            }
+            if (frameHeader[0] == KEY_FRAME) {
+                keyframes.emplace_back(totalFrames, offset);
+            }
+            ++totalFrames;
+            offset += FRAME_HEADER_SIZE + size;
+            in.seekg(origin + static_cast<std::streamoff>(offset));
+        }
+    }
+
+    in.clear();
+    in.seekg(origin + static_cast<std::streamoff>(byteOffset));
+    indexLoaded = true;
+}
+
+std::uint64_t ReplayReader::getFrameCount() {
+    loadIndex();
+    return totalFrames;
+}
+
+void ReplayReader::seek(std::uint64_t frame) {
+    loadIndex();
+    if (frame >= totalFrames) {
+        throw std::out_of_range("ReplayReader::seek frame out of range");
+    }
+
+    // frame 이하의 마지막 키프레임 (현재 위치에서 앞으로 가는 편이 가까우면 그대로 진행)
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), std::make_pair(frame, ~std::uint64_t(0)));
+    if (it == keyframes.begin()) {
+        throw std::runtime_error("ReplayReader: no keyframe before requested frame");
+    }
+    --it;
+    if (finished || frameIndex > frame || frameIndex < it->first) {
+        in.clear();
+        in.seekg(origin + static_cast<std::streamoff>(it->second));
+        frameIndex = it->first;
+        byteOffset = it->second;
+        finished = false;
+    }
+    while (frameIndex < frame) {
+        if (!readFrame(scratch)) {
+            throw std::runtime_error("ReplayReader: truncated stream while seeking");
+        }
+    }
+}
+
+#endif // REPLAYSTREAM_CPP
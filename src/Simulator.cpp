@@ -1,13 +1,18 @@
 ﻿#ifndef SIMULATOR_CPP
 #define SIMULATOR_CPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include "Simulator.h"
 #include "Constants.h"
 
 Simulator::Simulator(double Vm, double Alpha, double Gamma, double Yb, double X, double Z, double Length, double Width, double Height, double tInc, double floorHeight)
-    : Vm(Vm), Alpha(Alpha), Gamma(Gamma), Yb(Yb), X(X), Z(Z), Length(Length), Width(Width), Height(Height), simulationTime(0.0), tInc(tInc), floorHeight(floorHeight), status(0) {}
+    : Vm(Vm), Alpha(Alpha), Gamma(Gamma), Yb(Yb), X(X), Z(Z), Length(Length), Width(Width), Height(Height), simulationTime(0.0), tInc(tInc), floorHeight(floorHeight), status(0),
+    predicted(false), predictedAcceleration(0.0, 0.0, 0.0), terrainTop(floorHeight) {}
 
 void Simulator::initialize() {
     // 발사체 초기화
@@ -19,6 +24,10 @@ void Simulator::initialize() {
 
     projectile.setVelocity(initialVelocity);
 
+    // 중력장 등록
+    forces.clear();
+    forces.addField(std::make_shared<GravityField>(Vector3<double>(0.0, -Constants<double>::GRAVITY, 0.0)));
+
     // 목표물의 밀도와 부피를 통한 질량 계산
     double targetDensity = 500.0; // kg/m^3
     double targetVolume = Length * Width * Height;
@@ -28,12 +37,65 @@ void Simulator::initialize() {
     target.setPosition(Vector3<double>(X, 0.0, Z));
     target.setMass(targetMass);
     target.setScale(Vector3<double>(Length, Height, Width));
+    target.setShape(ShapeCache::box(Vector3<double>(Length / 2.0, Height / 2.0, Width / 2.0)));
+    invalidatePredictions();
+}
+
+void Simulator::setIntegrator(std::shared_ptr<const Integrator> integrator) {
+    projectile.setIntegrator(integrator);
+    invalidatePredictions();
+}
+
+void Simulator::setTerrain(std::shared_ptr<const HeightField> field) {
+    terrain = field;
+    terrainTop = floorHeight;
+    if (terrain) {
+        terrainTop = -std::numeric_limits<double>::max();
+        for (std::size_t row = 0; row < terrain->getRows(); ++row) {
+            for (std::size_t column = 0; column < terrain->getColumns(); ++column) {
+                terrainTop = std::max(terrainTop, terrain->getSample(column, row));
+            }
+        }
+    }
+    invalidatePredictions();
+}
+
+void Simulator::setReplayWriter(std::shared_ptr<ReplayWriter> writer) {
+    if (writer && writer->getBodyCount() != 2) {
+        throw std::invalid_argument("Simulator replay writer must record exactly 2 bodies");
+    }
+    replay = writer;
+}
+
+void Simulator::saveSnapshot(Snapshot& out) const {
+    // 패딩 바이트까지 같게 하려고 0 으로 채운 뒤 값 구역만 복사 (월드 스냅샷과 같은 방식)
+    std::memset(static_cast<void*>(&out), 0, sizeof(Snapshot));
+    std::memcpy(static_cast<void*>(&out.projectile), &projectile.getState(), PHYSICS_STATE_VALUE_BYTES);
+    std::memcpy(static_cast<void*>(&out.target), &target.getState(), PHYSICS_STATE_VALUE_BYTES);
+    out.simulationTime = simulationTime;
+    out.status = status;
+}
+
+void Simulator::restoreSnapshot(const Snapshot& snapshot) {
+    projectile.setState(snapshot.projectile);
+    target.setState(snapshot.target);
+    simulationTime = snapshot.simulationTime;
+    status = snapshot.status;
+    invalidatePredictions();
 }
 
 int Simulator::runSimulationStep() {
     // 발사체 업데이트
     updateProjectile();
 
+    if (replay) {
+        ReplayBody frame[2] = {
+            { projectile.getPosition(), projectile.getOrientation(), projectile.getVelocity() },
+            { target.getPosition(), target.getOrientation(), target.getVelocity() }
+        };
+        replay->writeFrame(frame);
+    }
+
     // 충돌 확인
     if (checkCollision()) {
         status = 1;  // 충돌 발생
@@ -50,6 +112,122 @@ int Simulator::runSimulationStep() {
     return status;  // 시뮬레이션 계속
 }
 
+int Simulator::advanceToNextEvent() {
+    Vector3<double> acceleration;
+    std::size_t quiet = predictQuietTicks(acceleration);
+    if (quiet > 0) {
+        if (replay) {
+            // 기록 중이면 건너뛴 틱도 해석적 상태로 한 프레임씩 남긴다
+            for (std::size_t k = 0; k < quiet; ++k) {
+                projectile.advanceBallistic(acceleration, tInc, 1);
+                clampToFloor();
+                ReplayBody frame[2] = {
+                    { projectile.getPosition(), projectile.getOrientation(), projectile.getVelocity() },
+                    { target.getPosition(), target.getOrientation(), target.getVelocity() }
+                };
+                replay->writeFrame(frame);
+            }
+        }
+        else {
+            projectile.advanceBallistic(acceleration, tInc, quiet);
+            clampToFloor();
+        }
+        simulationTime += tInc * static_cast<double>(quiet);
+    }
+    return runSimulationStep();
+}
+
+// 사건이 없다고 보장되는 틱 수 (사건이 일어나는 틱과 그 직전 틱은 정상 진행하도록 남김)
+std::size_t Simulator::predictQuietTicks(Vector3<double>& acceleration) {
+    if (!forces.getUniformAcceleration(acceleration) || projectile.isStatic()) {
+        invalidatePredictions();
+        return 0;
+    }
+    if (simulationTime >= TIMEOUT) {
+        return 0;
+    }
+
+    // 가속도가 바뀌었거나 가장 이른 사건 시각이 이미 지났으면 현재 상태에서 다시 예측한다
+    if (predicted && (acceleration - predictedAcceleration).magnitude() != 0.0) {
+        invalidatePredictions();
+    }
+    const KineticEvent* next = predicted ? events.peek() : nullptr;
+    if (next && next->time <= simulationTime) {
+        invalidatePredictions();
+        next = nullptr;
+    }
+    if (!predicted) {
+        schedulePredictions(acceleration);
+        next = events.peek();
+    }
+
+    double eventTime = TIMEOUT;
+    if (next) {
+        eventTime = std::min(eventTime, next->time);
+    }
+    double ticks = std::ceil((eventTime - simulationTime) / tInc);
+    return ticks > 2.0 ? static_cast<std::size_t>(ticks) - 2 : 0;
+}
+
+// 현재 상태에서 출발하는 궤적의 사건을 절대 시각으로 예약
+void Simulator::schedulePredictions(const Vector3<double>& acceleration) {
+    double horizon = TIMEOUT - simulationTime;
+
+    // 틱 k 의 위치가 궤적의 t = k tInc 값과 일치하도록 적분기 보정을 넣는다
+    BallisticPath path{ projectile.getPosition(),
+        projectile.getVelocity() + acceleration * (projectile.getBallisticBias() * tInc), acceleration };
+
+    // 평평한 바닥에 붙어 미끄러지는 중이면 매 틱 바닥으로 고정되므로 수평 성분만 예측한다
+    bool sliding = !terrain && path.position.y <= floorHeight && path.velocity.y <= 0.0 && acceleration.y <= 0.0;
+    if (sliding) {
+        path.position.y = floorHeight;
+        path.velocity.y = 0.0;
+        path.acceleration.y = 0.0;
+    }
+    else {
+        events.schedule(PROJECTILE, KineticEventType::GroundContact,
+            simulationTime + path.predictPlaneCrossing(terrain ? terrainTop : floorHeight));
+    }
+    Vector3<double> targetMin, targetMax;
+    getTargetBounds(targetMin, targetMax);
+    events.schedule(PROJECTILE, KineticEventType::TargetEntry, simulationTime + path.predictBoxEntry(targetMin, targetMax, horizon));
+    if (terrain) {
+        double limit = std::numeric_limits<double>::max();
+        Vector3<double> origin = terrain->getOrigin();
+        Vector3<double> boundsMin(origin.x, -limit, origin.z);
+        Vector3<double> boundsMax(origin.x + terrain->getCellSize() * static_cast<double>(terrain->getColumns() - 1), limit,
+            origin.z + terrain->getCellSize() * static_cast<double>(terrain->getRows() - 1));
+        events.schedule(PROJECTILE, KineticEventType::BoundsExit, simulationTime + path.predictBoxExit(boundsMin, boundsMax, horizon));
+    }
+    predicted = true;
+    predictedAcceleration = acceleration;
+}
+
+// 발사체 궤적이 예측과 달라졌을 때 예약된 사건을 한꺼번에 무효화 (큐에서는 꺼낼 때 버려짐)
+void Simulator::invalidatePredictions() {
+    events.invalidate(PROJECTILE);
+    predicted = false;
+}
+
+void Simulator::getTargetBounds(Vector3<double>& boundsMin, Vector3<double>& boundsMax) const {
+    if (targetMesh) {
+        boundsMin = target.getPosition() + targetMesh->getBoundsMin();
+        boundsMax = target.getPosition() + targetMesh->getBoundsMax();
+        return;
+    }
+    boundsMin = target.getPosition();
+    boundsMax = boundsMin + Vector3<double>(Length, Height, Width);
+}
+
+void Simulator::clampToFloor() {
+    Vector3<double> pos = projectile.getPosition();
+    if (!terrain && pos.y < floorHeight) {
+        pos.y = floorHeight;
+        projectile.setPosition(pos);
+        invalidatePredictions();
+    }
+}
+
 std::string Simulator::getSimulationStatus() const {
     return "Time: " + std::to_string(simulationTime) + "s, Position: (" +
         std::to_string(projectile.getPosition().x) + ", " +
@@ -69,22 +247,39 @@ void Simulator::updateProjectile() {
         std::to_string(projectile.getPosition().z) + ")"
     );
 
-    // 중력 재적용
-    Vector3<double> gravity(0.0, -projectile.getMass() * Constants<double>::GRAVITY, 0.0);
-    projectile.applyForce(gravity);
+    previousPosition = projectile.getPosition();
 
-    // 발사체 업데이트
-    projectile.update(tInc);
+    // 발사체 하나만 평가하므로 다른 물체를 가리키는 스프링은 받을 수 없다
+    if (forces.getSpringCount() != 0) {
+        throw std::invalid_argument("Simulator forces support force fields only, not springs");
+    }
 
-    // 발사체가 바닥을 통과하지 않도록 바닥의 높이를 적용
-    if (projectile.getPosition().y < floorHeight) {
-        Vector3<double> pos = projectile.getPosition();
-        pos.y = floorHeight;
+    // 등록된 힘(중력, 공기 저항 등)을 적분기가 요구하는 상태마다 평가하며 발사체 업데이트
+    projectile.update(tInc, [this](const Vector3<double>& position, const Vector3<double>& velocity, double) {
+        return forces.evaluateAcceleration(&projectile, 0, position, velocity);
+    });
+
+    // 발사체가 바닥(또는 지형)을 통과하지 않도록 바닥의 높이를 적용
+    Vector3<double> pos = projectile.getPosition();
+    double ground = getGroundHeight(pos.x, pos.z);
+    if (pos.y < ground) {
+        pos.y = ground;
         projectile.setPosition(pos);
+        invalidatePredictions();
     }
 }
 
+double Simulator::getGroundHeight(double x, double z) const {
+    return terrain ? terrain->getHeight(x, z) : floorHeight;
+}
+
 bool Simulator::checkCollision() const {
+    if (targetMesh) {
+        // 이번 틱 이동 선분을 목표물 좌표로 옮겨 메시와 교차 검사
+        Vector3<double> origin = target.getPosition();
+        return targetMesh->intersectsSegment(previousPosition - origin, projectile.getPosition() - origin);
+    }
+
     // 목표물의 절반 크기 계산
     double halfLength = Length / 2.0;
     double halfWidth = Width / 2.0;
@@ -95,7 +290,7 @@ bool Simulator::checkCollision() const {
 
     // 발사체 위치와 목표물 범위 내에 있는지 확인
     Vector3<double> projPos = projectile.getPosition();
-    if (projPos.y <= floorHeight) {
+    if (projPos.y <= getGroundHeight(projPos.x, projPos.z)) {
         return (projPos.x >= targetCenter.x - halfLength && projPos.x <= targetCenter.x + halfLength &&
             projPos.y >= targetCenter.y - halfHeight && projPos.y <= targetCenter.y + halfHeight &&
             projPos.z >= targetCenter.z - halfWidth && projPos.z <= targetCenter.z + halfWidth);
@@ -104,7 +299,7 @@ bool Simulator::checkCollision() const {
 }
 
 bool Simulator::isSimulationTimedOut() const {
-    return simulationTime > 60.0;  // 60초 초과 시 타임아웃 처리
+    return simulationTime > TIMEOUT;  // 60초 초과 시 타임아웃 처리
 }
 
 #endif // SIMULATOR_CPP
\ No newline at end of file
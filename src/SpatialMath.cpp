@@ -0,0 +1,109 @@
+﻿#ifndef SPATIALMATH_CPP
+#define SPATIALMATH_CPP
+
+#include "SpatialMath.h"
+
+// [ω; v] ×m [ω'; v'] = [ω × ω'; ω × v' + v × ω']
+SpatialVector SpatialVector::crossMotion(const SpatialVector& m) const {
+    return SpatialVector(angular ^ m.angular, (angular ^ m.linear) + (linear ^ m.angular));
+}
+
+// [ω; v] ×f [n; f] = [ω × n + v × f; ω × f]
+SpatialVector SpatialVector::crossForce(const SpatialVector& f) const {
+    return SpatialVector((angular ^ f.angular) + (linear ^ f.linear), angular ^ f.linear);
+}
+
+// I = [Ic + m [c]× [c]×ᵀ, m [c]×; m [c]×ᵀ, m E]
+SpatialMatrix SpatialMatrix::inertia(double mass, const Vector3<double>& com, const Matrix3x3<double>& inertia) {
+    Matrix3x3<double> cx = Matrix3x3<double>::skew(com);
+    Matrix3x3<double> cxT = cx.transpose();
+    return SpatialMatrix(
+        inertia + cx * cxT * mass, cx * mass,
+        cxT * mass, Matrix3x3<double>::identity() * mass
+    );
+}
+
+SpatialMatrix SpatialMatrix::outerProduct(const SpatialVector& u, const SpatialVector& v) {
+    return SpatialMatrix(
+        Matrix3x3<double>::outerProduct(u.angular, v.angular), Matrix3x3<double>::outerProduct(u.angular, v.linear),
+        Matrix3x3<double>::outerProduct(u.linear, v.angular), Matrix3x3<double>::outerProduct(u.linear, v.linear)
+    );
+}
+
+SpatialMatrix& SpatialMatrix::operator+=(const SpatialMatrix& m) {
+    a += m.a;
+    b += m.b;
+    c += m.c;
+    d += m.d;
+    return *this;
+}
+
+SpatialMatrix& SpatialMatrix::operator-=(const SpatialMatrix& m) {
+    a -= m.a;
+    b -= m.b;
+    c -= m.c;
+    d -= m.d;
+    return *this;
+}
+
+SpatialMatrix SpatialMatrix::operator*(const SpatialMatrix& m) const {
+    return SpatialMatrix(
+        a * m.a + b * m.c, a * m.b + b * m.d,
+        c * m.a + d * m.c, c * m.b + d * m.d
+    );
+}
+
+SpatialMatrix SpatialMatrix::operator*(double s) const {
+    return SpatialMatrix(a * s, b * s, c * s, d * s);
+}
+
+SpatialVector SpatialMatrix::operator*(const SpatialVector& v) const {
+    return SpatialVector(a * v.angular + b * v.linear, c * v.angular + d * v.linear);
+}
+
+SpatialMatrix SpatialMatrix::transpose() const {
+    return SpatialMatrix(a.transpose(), c.transpose(), b.transpose(), d.transpose());
+}
+
+// X_this X_other: 회전은 E1 E2, 이동은 r2 + E2ᵀ r1
+SpatialTransform SpatialTransform::operator*(const SpatialTransform& other) const {
+    return SpatialTransform(rotation * other.rotation, other.translation + other.rotation.transpose() * translation);
+}
+
+// X v = [E ω; E (v - r × ω)]
+SpatialVector SpatialTransform::applyMotion(const SpatialVector& v) const {
+    return SpatialVector(rotation * v.angular, rotation * (v.linear - (translation ^ v.angular)));
+}
+
+// X⁻¹ v = [Eᵀ ω; Eᵀ v + r × Eᵀ ω]
+SpatialVector SpatialTransform::applyInverseMotion(const SpatialVector& v) const {
+    Matrix3x3<double> rotationT = rotation.transpose();
+    Vector3<double> angular = rotationT * v.angular;
+    return SpatialVector(angular, rotationT * v.linear + (translation ^ angular));
+}
+
+// X* f = [E (n - r × f); E f]
+SpatialVector SpatialTransform::applyForce(const SpatialVector& f) const {
+    return SpatialVector(rotation * (f.angular - (translation ^ f.linear)), rotation * f.linear);
+}
+
+// Xᵀ f = [Eᵀ n + r × Eᵀ f; Eᵀ f]
+SpatialVector SpatialTransform::applyTransposeForce(const SpatialVector& f) const {
+    Matrix3x3<double> rotationT = rotation.transpose();
+    Vector3<double> linear = rotationT * f.linear;
+    return SpatialVector(rotationT * f.angular + (translation ^ linear), linear);
+}
+
+SpatialMatrix SpatialTransform::transformInertia(const SpatialMatrix& inertia) const {
+    SpatialMatrix x = toMatrix();
+    return x.transpose() * inertia * x;
+}
+
+SpatialMatrix SpatialTransform::toMatrix() const {
+    return SpatialMatrix(
+        rotation, Matrix3x3<double>(),
+        rotation * Matrix3x3<double>::skew(translation) * -1.0, rotation
+    );
+}
+
+#endif // SPATIALMATH_CPP
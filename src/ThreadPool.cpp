@@ -0,0 +1,97 @@
+﻿#ifndef THREADPOOL_CPP
+#define THREADPOOL_CPP
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : currentTask(nullptr), taskCount(0), nextIndex(0), activeWorkers(0), generation(0), stopping(false)
+{
+    if (threadCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 0;
+    }
+    else {
+        threadCount -= 1; // 호출 스레드가 한 몫을 담당
+    }
+
+    workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    // 작업이 하나뿐이거나 작업 스레드가 없으면 바로 실행
+    if (count == 1 || workers.empty()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        taskCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        activeWorkers = workers.size();
+        ++generation;
+    }
+    wakeCondition.notify_all();
+
+    runTasks(task, count);
+
+    // 모든 작업 스레드가 현재 작업을 끝낼 때까지 대기
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return activeWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long long seenGeneration = 0;
+    while (true) {
+        const std::function<void(std::size_t)>* task = nullptr;
+        std::size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            task = currentTask;
+            count = taskCount;
+        }
+
+        runTasks(*task, count);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks(const std::function<void(std::size_t)>& task, std::size_t count) {
+    std::size_t i;
+    while ((i = nextIndex.fetch_add(1, std::memory_order_relaxed)) < count) {
+        task(i);
+    }
+}
+
+#endif // THREADPOOL_CPP
@@ -0,0 +1,542 @@
+﻿#ifndef TRIANGLEMESH_CPP
+#define TRIANGLEMESH_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "TriangleMesh.h"
+
+namespace {
+    const float INF = std::numeric_limits<float>::infinity();
+    const std::size_t BIN_COUNT = 16;
+    const std::size_t MAX_STACK = 64 * TriangleMesh::LANES;
+
+    struct Bounds {
+        float min[3];
+        float max[3];
+
+        void reset() {
+            for (int a = 0; a < 3; ++a) { min[a] = INF; max[a] = -INF; }
+        }
+        void grow(const Bounds& b) {
+            for (int a = 0; a < 3; ++a) { min[a] = std::min(min[a], b.min[a]); max[a] = std::max(max[a], b.max[a]); }
+        }
+        void grow(const float* p) {
+            for (int a = 0; a < 3; ++a) { min[a] = std::min(min[a], p[a]); max[a] = std::max(max[a], p[a]); }
+        }
+        float area() const {
+            float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+            return dx < 0.0f ? 0.0f : 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+    };
+
+    // SAH 이진 BVH (LANES 갈래로 접기 전 단계)
+    struct BuildNode {
+        Bounds bounds;
+        std::int32_t left;      // -1 이면 잎
+        std::int32_t right;
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    // 아직 만들지 않은 범위와 그 범위를 가리킬 부모 노드의 자식 칸
+    struct BuildTask {
+        std::uint32_t first;
+        std::uint32_t count;
+        std::int32_t parent;    // -1 이면 뿌리
+        bool right;
+    };
+
+    struct Builder {
+        std::vector<Bounds> triangleBounds;
+        std::vector<float> centroids;           // 삼각형당 3 개
+        std::vector<std::uint32_t> order;       // 잎 범위가 가리키는 삼각형 순서
+        std::vector<BuildNode> nodes;
+
+        // 명시적 작업 스택으로 전위 순서 구축 (SAH 분할이 한쪽으로 치우쳐 트리가 깊어져도 호출 스택을 쓰지 않음)
+        void build(std::uint32_t count) {
+            std::vector<BuildTask> tasks;
+            tasks.push_back(BuildTask{ 0, count, -1, false });
+            while (!tasks.empty()) {
+                BuildTask task = tasks.back();
+                tasks.pop_back();
+
+                BuildNode node;
+                node.bounds.reset();
+                Bounds centroidBounds;
+                centroidBounds.reset();
+                for (std::uint32_t i = task.first; i < task.first + task.count; ++i) {
+                    node.bounds.grow(triangleBounds[order[i]]);
+                    centroidBounds.grow(&centroids[3 * order[i]]);
+                }
+                node.left = -1;
+                node.right = -1;
+                node.first = task.first;
+                node.count = task.count;
+
+                std::int32_t index = static_cast<std::int32_t>(nodes.size());
+                nodes.push_back(node);
+                if (task.parent >= 0) {
+                    (task.right ? nodes[task.parent].right : nodes[task.parent].left) = index;
+                }
+                if (task.count <= TriangleMesh::LANES) {
+                    continue;
+                }
+
+                // 왼쪽을 나중에 넣어 먼저 꺼낸다
+                std::uint32_t middle = split(task.first, task.count, centroidBounds);
+                tasks.push_back(BuildTask{ middle, task.first + task.count - middle, index, true });
+                tasks.push_back(BuildTask{ task.first, middle - task.first, index, false });
+            }
+        }
+
+        // 축마다 무게중심을 BIN_COUNT 칸에 나누어 SAH 비용이 가장 작은 경계로 분할 (분할 위치를 돌려줌)
+        std::uint32_t split(std::uint32_t first, std::uint32_t count, const Bounds& centroidBounds) {
+            float bestCost = INF;
+            int bestAxis = -1;
+            std::size_t bestBin = 0;
+
+            for (int axis = 0; axis < 3; ++axis) {
+                float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+                if (!(extent > 0.0f)) {
+                    continue;
+                }
+                float scale = static_cast<float>(BIN_COUNT) / extent;
+
+                Bounds binBounds[BIN_COUNT];
+                std::uint32_t binCount[BIN_COUNT] = {};
+                for (std::size_t b = 0; b < BIN_COUNT; ++b) {
+                    binBounds[b].reset();
+                }
+                for (std::uint32_t i = first; i < first + count; ++i) {
+                    std::size_t b = binOf(order[i], axis, centroidBounds.min[axis], scale);
+                    binBounds[b].grow(triangleBounds[order[i]]);
+                    ++binCount[b];
+                }
+
+                // 오른쪽 누적을 먼저 구한 뒤 왼쪽에서 훑으며 경계 b | b + 1 의 비용 계산
+                float rightArea[BIN_COUNT];
+                std::uint32_t rightCount[BIN_COUNT];
+                Bounds accumulated;
+                accumulated.reset();
+                std::uint32_t accumulatedCount = 0;
+                for (std::size_t b = BIN_COUNT - 1; b > 0; --b) {
+                    accumulated.grow(binBounds[b]);
+                    accumulatedCount += binCount[b];
+                    rightArea[b] = accumulated.area();
+                    rightCount[b] = accumulatedCount;
+                }
+                accumulated.reset();
+                accumulatedCount = 0;
+                for (std::size_t b = 0; b + 1 < BIN_COUNT; ++b) {
+                    accumulated.grow(binBounds[b]);
+                    accumulatedCount += binCount[b];
+                    if (accumulatedCount == 0 || rightCount[b + 1] == 0) {
+                        continue;
+                    }
+                    float cost = accumulated.area() * static_cast<float>(accumulatedCount)
+                        + rightArea[b + 1] * static_cast<float>(rightCount[b + 1]);
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = b;
+                    }
+                }
+            }
+
+            std::uint32_t* begin = order.data() + first;
+            std::uint32_t* end = begin + count;
+            if (bestAxis >= 0) {
+                float minimum = centroidBounds.min[bestAxis];
+                float scale = static_cast<float>(BIN_COUNT) / (centroidBounds.max[bestAxis] - minimum);
+                std::uint32_t* middle = std::partition(begin, end, [&](std::uint32_t t) {
+                    return binOf(t, bestAxis, minimum, scale) <= bestBin;
+                });
+                if (middle != begin && middle != end) {
+                    return first + static_cast<std::uint32_t>(middle - begin);
+                }
+            }
+
+            // 무게중심이 한 점에 모인 경우: 가장 긴 축의 중앙값으로 분할
+            int axis = 0;
+            for (int a = 1; a < 3; ++a) {
+                if (centroidBounds.max[a] - centroidBounds.min[a] > centroidBounds.max[axis] - centroidBounds.min[axis]) {
+                    axis = a;
+                }
+            }
+            std::uint32_t* middle = begin + count / 2;
+            std::nth_element(begin, middle, end, [&](std::uint32_t a, std::uint32_t b) {
+                return centroids[3 * a + axis] < centroids[3 * b + axis];
+            });
+            return first + count / 2;
+        }
+
+        std::size_t binOf(std::uint32_t triangle, int axis, float minimum, float scale) const {
+            float f = (centroids[3 * triangle + axis] - minimum) * scale;
+            std::size_t b = f > 0.0f ? static_cast<std::size_t>(f) : 0;
+            return std::min(b, BIN_COUNT - 1);
+        }
+    };
+}
+
+TriangleMesh::TriangleMesh(const std::vector<Vector3<double>>& vertices, const std::vector<std::uint32_t>& indices)
+    : indices(indices), stackSize(0)
+{
+    if (indices.size() % 3 != 0) {
+        throw std::invalid_argument("TriangleMesh index count must be a multiple of 3");
+    }
+    for (std::uint32_t i : indices) {
+        if (i >= vertices.size()) {
+            throw std::invalid_argument("TriangleMesh index out of range");
+        }
+    }
+    this->vertices.reserve(vertices.size() * 3);
+    for (const Vector3<double>& v : vertices) {
+        this->vertices.push_back(static_cast<float>(v.x));
+        this->vertices.push_back(static_cast<float>(v.y));
+        this->vertices.push_back(static_cast<float>(v.z));
+    }
+    build();
+}
+
+std::shared_ptr<TriangleMesh> TriangleMesh::loadObj(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open mesh file: " + path);
+    }
+
+    std::vector<Vector3<double>> vertices;
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> face;
+    std::string line;
+    std::string token;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        if (!(stream >> token)) {
+            continue;
+        }
+        if (token == "v") {
+            Vector3<double> v;
+            if (!(stream >> v.x >> v.y >> v.z)) {
+                throw std::runtime_error("Invalid vertex in mesh file: " + path);
+            }
+            vertices.push_back(v);
+        }
+        else if (token == "f") {
+            face.clear();
+            while (stream >> token) {
+                // "정점/텍스처/법선" 에서 정점 번호만 사용 (1 부터, 음수는 끝에서부터)
+                long index = std::strtol(token.c_str(), nullptr, 10);
+                long resolved = index < 0 ? static_cast<long>(vertices.size()) + index : index - 1;
+                if (index == 0 || resolved < 0 || resolved >= static_cast<long>(vertices.size())) {
+                    throw std::runtime_error("Invalid face index in mesh file: " + path);
+                }
+                face.push_back(static_cast<std::uint32_t>(resolved));
+            }
+            for (std::size_t k = 2; k < face.size(); ++k) {
+                indices.push_back(face[0]);
+                indices.push_back(face[k - 1]);
+                indices.push_back(face[k]);
+            }
+        }
+    }
+
+    return std::make_shared<TriangleMesh>(vertices, indices);
+}
+
+void TriangleMesh::build() {
+    nodes.clear();
+    packets.clear();
+    boundsMin = Vector3<double>();
+    boundsMax = Vector3<double>();
+    const std::size_t triangleCount = getTriangleCount();
+    if (triangleCount == 0) {
+        return;
+    }
+
+    Builder builder;
+    builder.triangleBounds.resize(triangleCount);
+    builder.centroids.resize(triangleCount * 3);
+    builder.order.resize(triangleCount);
+    builder.nodes.reserve(2 * triangleCount / LANES + 1);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        Bounds& b = builder.triangleBounds[t];
+        b.reset();
+        for (int k = 0; k < 3; ++k) {
+            b.grow(&vertices[3 * indices[3 * t + k]]);
+        }
+        for (int a = 0; a < 3; ++a) {
+            builder.centroids[3 * t + a] = 0.5f * (b.min[a] + b.max[a]);
+        }
+        builder.order[t] = static_cast<std::uint32_t>(t);
+    }
+    builder.build(static_cast<std::uint32_t>(triangleCount));
+
+    const Bounds& root = builder.nodes[0].bounds;
+    boundsMin = Vector3<double>(root.min[0], root.min[1], root.min[2]);
+    boundsMax = Vector3<double>(root.max[0], root.max[1], root.max[2]);
+
+    // 이진 노드를 LANES 갈래 노드로 접는다: 표면적이 가장 큰 내부 자식을 그 두 자식으로 바꾸기를 반복
+    // 이진 잎은 삼각형 묶음이 되어 ~묶음 번호로 가리킨다.
+    struct CollapseTask {
+        std::int32_t binary;    // 접을 이진 노드
+        std::int32_t index;     // 채울 LANES 갈래 노드
+        std::size_t depth;
+    };
+
+    struct Collapse {
+        TriangleMesh& mesh;
+        const Builder& builder;
+
+        std::int32_t packet(const BuildNode& leaf) {
+            TrianglePacket p;
+            for (std::size_t lane = 0; lane < LANES; ++lane) {
+                float v0[3] = { 0.0f, 0.0f, 0.0f }, e1[3] = { 0.0f, 0.0f, 0.0f }, e2[3] = { 0.0f, 0.0f, 0.0f };
+                p.triangle[lane] = 0xFFFFFFFFu;
+                if (lane < leaf.count) {
+                    std::uint32_t t = builder.order[leaf.first + lane];
+                    const float* p0 = &mesh.vertices[3 * mesh.indices[3 * t]];
+                    const float* p1 = &mesh.vertices[3 * mesh.indices[3 * t + 1]];
+                    const float* p2 = &mesh.vertices[3 * mesh.indices[3 * t + 2]];
+                    for (int a = 0; a < 3; ++a) {
+                        v0[a] = p0[a];
+                        e1[a] = p1[a] - p0[a];
+                        e2[a] = p2[a] - p0[a];
+                    }
+                    p.triangle[lane] = t;
+                }
+                p.v0x[lane] = v0[0]; p.v0y[lane] = v0[1]; p.v0z[lane] = v0[2];
+                p.e1x[lane] = e1[0]; p.e1y[lane] = e1[1]; p.e1z[lane] = e1[2];
+                p.e2x[lane] = e2[0]; p.e2y[lane] = e2[1]; p.e2z[lane] = e2[2];
+            }
+            mesh.packets.push_back(p);
+            return ~static_cast<std::int32_t>(mesh.packets.size() - 1);
+        }
+
+        // binary 를 LANES 갈래 노드 index 로 채우고, 내부 자식은 자리를 잡아 tasks 에 넣는다 (자식 깊이 depth + 1)
+        void node(std::int32_t binary, std::int32_t index, std::size_t depth, std::vector<CollapseTask>& tasks) {
+            std::int32_t children[LANES];
+            std::size_t childCount = 0;
+            const BuildNode& source = builder.nodes[binary];
+            if (source.left < 0) {
+                children[childCount++] = binary;
+            }
+            else {
+                children[childCount++] = source.left;
+                children[childCount++] = source.right;
+            }
+            while (childCount < LANES) {
+                std::size_t widest = LANES;
+                float widestArea = -1.0f;
+                for (std::size_t k = 0; k < childCount; ++k) {
+                    const BuildNode& c = builder.nodes[children[k]];
+                    if (c.left >= 0 && c.bounds.area() > widestArea) {
+                        widest = k;
+                        widestArea = c.bounds.area();
+                    }
+                }
+                if (widest == LANES) {
+                    break;
+                }
+                const BuildNode& opened = builder.nodes[children[widest]];
+                children[widest] = opened.left;
+                children[childCount++] = opened.right;
+            }
+
+            Node result;
+            for (std::size_t lane = 0; lane < LANES; ++lane) {
+                if (lane >= childCount) {
+                    result.minX[lane] = result.minY[lane] = result.minZ[lane] = INF;
+                    result.maxX[lane] = result.maxY[lane] = result.maxZ[lane] = -INF;
+                    result.child[lane] = EMPTY;
+                    continue;
+                }
+                const BuildNode& c = builder.nodes[children[lane]];
+                result.minX[lane] = c.bounds.min[0]; result.minY[lane] = c.bounds.min[1]; result.minZ[lane] = c.bounds.min[2];
+                result.maxX[lane] = c.bounds.max[0]; result.maxY[lane] = c.bounds.max[1]; result.maxZ[lane] = c.bounds.max[2];
+                if (c.left < 0) {
+                    result.child[lane] = packet(c);
+                }
+                else {
+                    result.child[lane] = static_cast<std::int32_t>(mesh.nodes.size());
+                    mesh.nodes.push_back(Node());
+                    tasks.push_back(CollapseTask{ children[lane], result.child[lane], depth + 1 });
+                }
+            }
+            mesh.nodes[index] = result;
+        }
+    };
+    nodes.reserve(builder.nodes.size() / 2 + 1);
+    packets.reserve(builder.nodes.size() / 2 + 1);
+    Collapse collapse{ *this, builder };
+
+    // 순회 스택은 깊이마다 형제 LANES - 1 개까지 쌓이므로 가장 깊은 내부 노드로 필요한 크기를 정한다
+    std::vector<CollapseTask> tasks;
+    std::size_t maxDepth = 0;
+    nodes.push_back(Node());
+    tasks.push_back(CollapseTask{ 0, 0, 0 });
+    while (!tasks.empty()) {
+        CollapseTask task = tasks.back();
+        tasks.pop_back();
+        maxDepth = std::max(maxDepth, task.depth);
+        collapse.node(task.binary, task.index, task.depth, tasks);
+    }
+    stackSize = (maxDepth + 1) * (LANES - 1) + 1;
+}
+
+bool TriangleMesh::raycast(const MeshRay& ray, MeshHit& hit) const {
+    return traverse(ray, false, hit);
+}
+
+bool TriangleMesh::intersectSegment(const Vector3<double>& a, const Vector3<double>& b, MeshHit& hit) const {
+    Vector3<double> delta = b - a;
+    double length = delta.magnitude();
+    if (!(length > 0.0)) {
+        hit.hit = false;
+        return false;
+    }
+    return traverse(MeshRay{ a, delta / length, length }, false, hit);
+}
+
+bool TriangleMesh::intersectsSegment(const Vector3<double>& a, const Vector3<double>& b) const {
+    Vector3<double> delta = b - a;
+    double length = delta.magnitude();
+    if (!(length > 0.0)) {
+        return false;
+    }
+    MeshHit hit;
+    return traverse(MeshRay{ a, delta / length, length }, true, hit);
+}
+
+std::size_t TriangleMesh::raycastBatch(const MeshRay* rays, std::size_t count, MeshHit* outHits) const {
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (traverse(rays[i], false, outHits[i])) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+// 가까운 자식부터 방문하는 스택 순회. 상자 LANES 개와 삼각형 LANES 개를 각각 레인 루프 한 번으로 검사한다.
+bool TriangleMesh::traverse(const MeshRay& ray, bool anyHit, MeshHit& hit) const {
+    hit.hit = false;
+    if (nodes.empty()) {
+        return false;
+    }
+
+    const float ox = static_cast<float>(ray.origin.x), oy = static_cast<float>(ray.origin.y), oz = static_cast<float>(ray.origin.z);
+    const float dx = static_cast<float>(ray.direction.x), dy = static_cast<float>(ray.direction.y), dz = static_cast<float>(ray.direction.z);
+    auto inverse = [](float d) { return std::fabs(d) > 1e-30f ? 1.0f / d : std::copysign(1e30f, d); };
+    const float ix = inverse(dx), iy = inverse(dy), iz = inverse(dz);
+
+    float closest = static_cast<float>(ray.maxDistance);
+    std::uint32_t closestTriangle = 0xFFFFFFFFu;
+
+    // 보통은 호출 스택의 고정 배열로 충분하고, 구축 시 잰 깊이가 더 깊은 퇴화 메시만 힙에 잡는다
+    std::int32_t fixedStack[MAX_STACK];
+    std::vector<std::int32_t> deepStack;
+    std::int32_t* stack = fixedStack;
+    if (stackSize > MAX_STACK) {
+        deepStack.resize(stackSize);
+        stack = deepStack.data();
+    }
+    std::size_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        std::int32_t id = stack[--top];
+
+        if (id < 0) {
+            // 묶음 안 삼각형 LANES 개에 대한 Möller–Trumbore
+            const TrianglePacket& p = packets[~id];
+            float t[LANES];
+            bool accept[LANES];
+            for (std::size_t k = 0; k < LANES; ++k) {
+                float px = dy * p.e2z[k] - dz * p.e2y[k];
+                float py = dz * p.e2x[k] - dx * p.e2z[k];
+                float pz = dx * p.e2y[k] - dy * p.e2x[k];
+                float det = p.e1x[k] * px + p.e1y[k] * py + p.e1z[k] * pz;
+                float invDet = det != 0.0f ? 1.0f / det : 0.0f;
+                float sx = ox - p.v0x[k], sy = oy - p.v0y[k], sz = oz - p.v0z[k];
+                float u = (sx * px + sy * py + sz * pz) * invDet;
+                float qx = sy * p.e1z[k] - sz * p.e1y[k];
+                float qy = sz * p.e1x[k] - sx * p.e1z[k];
+                float qz = sx * p.e1y[k] - sy * p.e1x[k];
+                float v = (dx * qx + dy * qy + dz * qz) * invDet;
+                t[k] = (p.e2x[k] * qx + p.e2y[k] * qy + p.e2z[k] * qz) * invDet;
+                accept[k] = det != 0.0f && u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t[k] >= 0.0f && t[k] <= closest;
+            }
+            for (std::size_t k = 0; k < LANES; ++k) {
+                if (accept[k] && t[k] <= closest) {
+                    closest = t[k];
+                    closestTriangle = p.triangle[k];
+                }
+            }
+            if (anyHit && closestTriangle != 0xFFFFFFFFu) {
+                break;
+            }
+            continue;
+        }
+
+        // 자식 상자 LANES 개에 대한 슬랩 검사
+        const Node& node = nodes[id];
+        float entry[LANES];
+        bool overlap[LANES];
+        for (std::size_t k = 0; k < LANES; ++k) {
+            float tx0 = (node.minX[k] - ox) * ix, tx1 = (node.maxX[k] - ox) * ix;
+            float ty0 = (node.minY[k] - oy) * iy, ty1 = (node.maxY[k] - oy) * iy;
+            float tz0 = (node.minZ[k] - oz) * iz, tz1 = (node.maxZ[k] - oz) * iz;
+            float tNear = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+            float tFar = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), closest));
+            entry[k] = tNear;
+            overlap[k] = tNear <= tFar;
+        }
+
+        // 먼 자식부터 쌓아 가까운 자식을 먼저 꺼낸다
+        std::int32_t order[LANES];
+        float orderEntry[LANES];
+        std::size_t hits = 0;
+        for (std::size_t k = 0; k < LANES; ++k) {
+            if (!overlap[k] || node.child[k] == EMPTY) {
+                continue;
+            }
+            std::size_t j = hits++;
+            while (j > 0 && orderEntry[j - 1] < entry[k]) {
+                order[j] = order[j - 1];
+                orderEntry[j] = orderEntry[j - 1];
+                --j;
+            }
+            order[j] = node.child[k];
+            orderEntry[j] = entry[k];
+        }
+        for (std::size_t j = 0; j < hits; ++j) {
+            stack[top++] = order[j];
+        }
+    }
+
+    if (closestTriangle == 0xFFFFFFFFu) {
+        return false;
+    }
+
+    const float* p0 = &vertices[3 * indices[3 * closestTriangle]];
+    const float* p1 = &vertices[3 * indices[3 * closestTriangle + 1]];
+    const float* p2 = &vertices[3 * indices[3 * closestTriangle + 2]];
+    Vector3<double> e1(p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]);
+    Vector3<double> e2(p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]);
+    Vector3<double> normal = e1 ^ e2;
+    double length = normal.magnitude();
+
+    hit.hit = true;
+    hit.distance = std::min(static_cast<double>(closest), ray.maxDistance);
+    hit.point = ray.origin + ray.direction * hit.distance;
+    hit.normal = length > 0.0 ? normal / length : Vector3<double>(0.0, 1.0, 0.0);
+    hit.triangle = closestTriangle;
+    return true;
+}
+
+#endif // TRIANGLEMESH_CPP
@@ -261,7 +261,10 @@ Vector3<T> vectorTripleProduct(const Vector3<T>& u, const Vector3<T>& v, const V
 template class Vector3<double>;
 template Vector3<double> operator+(const Vector3<double>& u, const Vector3<double>& v);
 template Vector3<double> operator-(const Vector3<double>& u, const Vector3<double>& v);
+template Vector3<double> operator^(const Vector3<double>& u, const Vector3<double>& v);
+template double operator*(const Vector3<double>& u, const Vector3<double>& v);
 template Vector3<double> operator*(const Vector3<double>& u, double s);
+template Vector3<double> operator*(double s, const Vector3<double>& u);
 template Vector3<double> operator/(const Vector3<double>& u, double s);
 template Vector3<double> operator*(const Matrix3x3<double>& m, const Vector3<double>& v);
 
@@ -0,0 +1,215 @@
+﻿#ifndef VECTORFIELD_CPP
+#define VECTORFIELD_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "VectorField.h"
+
+namespace {
+
+    // 한 성분의 삼선형 보간 (레인 루프는 자동 벡터화 대상)
+    template<std::size_t N>
+    void trilinear(const float* data, const std::size_t* base, const float* fx, const float* fy, const float* fz,
+        std::size_t count, std::size_t strideY, std::size_t strideZ, float* out)
+    {
+        float c000[N], c100[N], c010[N], c110[N], c001[N], c101[N], c011[N], c111[N];
+        for (std::size_t l = 0; l < count; ++l) {
+            const float* p = data + base[l];
+            c000[l] = p[0];
+            c100[l] = p[1];
+            c010[l] = p[strideY];
+            c110[l] = p[strideY + 1];
+            c001[l] = p[strideZ];
+            c101[l] = p[strideZ + 1];
+            c011[l] = p[strideZ + strideY];
+            c111[l] = p[strideZ + strideY + 1];
+        }
+        for (std::size_t l = 0; l < count; ++l) {
+            float x00 = c000[l] + (c100[l] - c000[l]) * fx[l];
+            float x10 = c010[l] + (c110[l] - c010[l]) * fx[l];
+            float x01 = c001[l] + (c101[l] - c001[l]) * fx[l];
+            float x11 = c011[l] + (c111[l] - c011[l]) * fx[l];
+            float y0 = x00 + (x10 - x00) * fy[l];
+            float y1 = x01 + (x11 - x01) * fy[l];
+            out[l] = y0 + (y1 - y0) * fz[l];
+        }
+    }
+
+} // namespace
+
+VectorField::VectorField(std::size_t sizeX, std::size_t sizeY, std::size_t sizeZ, double cellSize, const Vector3<double>& origin)
+    : sizeX(sizeX), sizeY(sizeY), sizeZ(sizeZ), cellSize(cellSize), inverseCellSize(1.0 / cellSize), origin(origin),
+    current(0), blend(0.0)
+{
+    if (sizeX < 2 || sizeY < 2 || sizeZ < 2) {
+        throw std::invalid_argument("VectorField requires at least 2 samples per axis");
+    }
+    if (cellSize <= 0.0) {
+        throw std::invalid_argument("VectorField cell size must be positive");
+    }
+    std::size_t count = sizeX * sizeY * sizeZ;
+    for (auto& frame : frames) {
+        frame.x.assign(count, 0.0f);
+        frame.y.assign(count, 0.0f);
+        frame.z.assign(count, 0.0f);
+    }
+}
+
+Vector3<double> VectorField::getVector(std::size_t i, std::size_t j, std::size_t k) const {
+    const Frame& frame = frames[current];
+    std::size_t n = index(i, j, k);
+    return Vector3<double>(frame.x[n], frame.y[n], frame.z[n]);
+}
+
+void VectorField::setVector(std::size_t i, std::size_t j, std::size_t k, const Vector3<double>& v) {
+    Frame& frame = frames[current];
+    std::size_t n = index(i, j, k);
+    frame.x[n] = static_cast<float>(v.x);
+    frame.y[n] = static_cast<float>(v.y);
+    frame.z[n] = static_cast<float>(v.z);
+}
+
+void VectorField::setNextVector(std::size_t i, std::size_t j, std::size_t k, const Vector3<double>& v) {
+    Frame& frame = frames[1 - current];
+    std::size_t n = index(i, j, k);
+    frame.x[n] = static_cast<float>(v.x);
+    frame.y[n] = static_cast<float>(v.y);
+    frame.z[n] = static_cast<float>(v.z);
+}
+
+void VectorField::fillFrame(Frame& frame, const Generator& generator) {
+    for (std::size_t k = 0; k < sizeZ; ++k) {
+        for (std::size_t j = 0; j < sizeY; ++j) {
+            for (std::size_t i = 0; i < sizeX; ++i) {
+                Vector3<double> position = origin + Vector3<double>(
+                    static_cast<double>(i), static_cast<double>(j), static_cast<double>(k)) * cellSize;
+                Vector3<double> v = generator(position);
+                std::size_t n = index(i, j, k);
+                frame.x[n] = static_cast<float>(v.x);
+                frame.y[n] = static_cast<float>(v.y);
+                frame.z[n] = static_cast<float>(v.z);
+            }
+        }
+    }
+}
+
+void VectorField::fill(const Generator& generator) {
+    fillFrame(frames[current], generator);
+    frames[1 - current] = frames[current];
+}
+
+void VectorField::fillNext(const Generator& generator) {
+    fillFrame(frames[1 - current], generator);
+}
+
+bool VectorField::advance(double deltaTime, double frameDuration) {
+    if (frameDuration <= 0.0) {
+        return false;
+    }
+    blend += deltaTime / frameDuration;
+    if (blend < 1.0) {
+        return false;
+    }
+    current = 1 - current;
+    blend = std::min(blend - 1.0, 1.0);
+    return true;
+}
+
+void VectorField::sampleLanes(const float* x, const float* y, const float* z, std::size_t count,
+    float* outX, float* outY, float* outZ) const
+{
+    const float inverse = static_cast<float>(inverseCellSize);
+    const float ox = static_cast<float>(origin.x);
+    const float oy = static_cast<float>(origin.y);
+    const float oz = static_cast<float>(origin.z);
+    const float maxU = static_cast<float>(sizeX - 1);
+    const float maxV = static_cast<float>(sizeY - 1);
+    const float maxW = static_cast<float>(sizeZ - 1);
+
+    // 셀 좌표와 셀 내부 비율
+    float fx[LANES], fy[LANES], fz[LANES];
+    std::size_t base[LANES];
+    for (std::size_t l = 0; l < count; ++l) {
+        float u = std::min(std::max((x[l] - ox) * inverse, 0.0f), maxU);
+        float v = std::min(std::max((y[l] - oy) * inverse, 0.0f), maxV);
+        float w = std::min(std::max((z[l] - oz) * inverse, 0.0f), maxW);
+        std::size_t i = std::min(static_cast<std::size_t>(u), sizeX - 2);
+        std::size_t j = std::min(static_cast<std::size_t>(v), sizeY - 2);
+        std::size_t k = std::min(static_cast<std::size_t>(w), sizeZ - 2);
+        fx[l] = u - static_cast<float>(i);
+        fy[l] = v - static_cast<float>(j);
+        fz[l] = w - static_cast<float>(k);
+        base[l] = index(i, j, k);
+    }
+
+    const std::size_t strideY = sizeX;
+    const std::size_t strideZ = sizeX * sizeY;
+    const Frame& now = frames[current];
+    trilinear<LANES>(now.x.data(), base, fx, fy, fz, count, strideY, strideZ, outX);
+    trilinear<LANES>(now.y.data(), base, fx, fy, fz, count, strideY, strideZ, outY);
+    trilinear<LANES>(now.z.data(), base, fx, fy, fz, count, strideY, strideZ, outZ);
+    if (blend <= 0.0) {
+        return;
+    }
+
+    // 다음 프레임과 시간 보간
+    const Frame& next = frames[1 - current];
+    float nextX[LANES], nextY[LANES], nextZ[LANES];
+    trilinear<LANES>(next.x.data(), base, fx, fy, fz, count, strideY, strideZ, nextX);
+    trilinear<LANES>(next.y.data(), base, fx, fy, fz, count, strideY, strideZ, nextY);
+    trilinear<LANES>(next.z.data(), base, fx, fy, fz, count, strideY, strideZ, nextZ);
+    const float t = static_cast<float>(blend);
+    for (std::size_t l = 0; l < count; ++l) {
+        outX[l] += (nextX[l] - outX[l]) * t;
+        outY[l] += (nextY[l] - outY[l]) * t;
+        outZ[l] += (nextZ[l] - outZ[l]) * t;
+    }
+}
+
+Vector3<double> VectorField::sample(const Vector3<double>& position) const {
+    Vector3<double> result;
+    sampleBatch(&position, 1, &result);
+    return result;
+}
+
+void VectorField::sampleBatch(const float* x, const float* y, const float* z, std::size_t count,
+    float* outX, float* outY, float* outZ) const
+{
+    for (std::size_t first = 0; first < count; first += LANES) {
+        std::size_t lanes = std::min(LANES, count - first);
+        sampleLanes(x + first, y + first, z + first, lanes, outX + first, outY + first, outZ + first);
+    }
+}
+
+void VectorField::sampleBatch(const Vector3<double>* positions, std::size_t count, Vector3<double>* out) const {
+    float x[LANES], y[LANES], z[LANES];
+    float ox[LANES], oy[LANES], oz[LANES];
+    for (std::size_t first = 0; first < count; first += LANES) {
+        std::size_t lanes = std::min(LANES, count - first);
+        for (std::size_t l = 0; l < lanes; ++l) {
+            x[l] = static_cast<float>(positions[first + l].x);
+            y[l] = static_cast<float>(positions[first + l].y);
+            z[l] = static_cast<float>(positions[first + l].z);
+        }
+        sampleLanes(x, y, z, lanes, ox, oy, oz);
+        for (std::size_t l = 0; l < lanes; ++l) {
+            out[first + l] = Vector3<double>(ox[l], oy[l], oz[l]);
+        }
+    }
+}
+
+FlowDragField::FlowDragField(std::shared_ptr<const VectorField> field, double linear, double quadratic)
+    : linear(linear), quadratic(quadratic), field(std::move(field)) {}
+
+void FlowDragField::accumulate(const ForceBatch& batch) const {
+    airVelocities.resize(batch.count);
+    field->sampleBatch(batch.positions, batch.count, airVelocities.data());
+    for (std::size_t i = 0; i < batch.count; ++i) {
+        Vector3<double> relative = batch.velocities[i] - airVelocities[i];
+        double speed = std::sqrt(relative * relative);
+        batch.forces[i] -= relative * (linear + quadratic * speed);
+    }
+}
+
+#endif // VECTORFIELD_CPP
@@ -0,0 +1,148 @@
+﻿#ifndef WORLDSNAPSHOT_CPP
+#define WORLDSNAPSHOT_CPP
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "WorldSnapshot.h"
+#include "PhysicsWorld.h"
+
+static_assert(std::is_trivially_copyable<Vector3<double>>::value, "Vector3 must be trivially copyable");
+static_assert(std::is_trivially_copyable<ContactEventBuffer::PairRecord>::value, "PairRecord must be trivially copyable");
+static_assert(sizeof(BodyHandle) == sizeof(std::uint64_t), "BodyHandle must fill one snapshot word");
+
+namespace {
+    std::size_t wordsFor(std::size_t bytes) {
+        return (bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    }
+}
+
+WorldSnapshot::WorldSnapshot()
+    : bodyOffset(0), positionOffset(0), velocityOffset(0), bodyOrderOffset(0), particleOrderOffset(0), pairOffset(0) {}
+
+void WorldSnapshot::layout(std::uint64_t frame, std::size_t bodyCount, std::size_t particleCount, std::size_t pairCount) {
+    Header header{ frame, bodyCount, particleCount, pairCount };
+    std::size_t headerWords = wordsFor(sizeof(Header));
+    std::size_t total = headerWords
+        + wordsFor(bodyCount * sizeof(PhysicsObject::State))
+        + 2 * wordsFor(particleCount * sizeof(Vector3<double>))
+        + bodyCount + particleCount
+        + wordsFor(pairCount * sizeof(ContactEventBuffer::PairRecord));
+
+    // 구조체 사이와 끝의 패딩 바이트까지 결정적으로 만들기 위해 0 으로 채운다 (저장 쪽은 값 바이트만 덮어씀)
+    words.assign(total, 0);
+    std::memcpy(words.data(), &header, sizeof(Header));
+    updateOffsets();
+}
+
+WorldSnapshot::Header WorldSnapshot::getHeader() const {
+    if (words.empty()) {
+        throw std::runtime_error("WorldSnapshot is empty");
+    }
+    Header header;
+    std::memcpy(&header, words.data(), sizeof(Header));
+    return header;
+}
+
+void WorldSnapshot::updateOffsets() {
+    Header header = getHeader();
+    bodyOffset = wordsFor(sizeof(Header));
+    positionOffset = bodyOffset + wordsFor(static_cast<std::size_t>(header.bodyCount) * sizeof(PhysicsObject::State));
+    velocityOffset = positionOffset + wordsFor(static_cast<std::size_t>(header.particleCount) * sizeof(Vector3<double>));
+    bodyOrderOffset = velocityOffset + wordsFor(static_cast<std::size_t>(header.particleCount) * sizeof(Vector3<double>));
+    particleOrderOffset = bodyOrderOffset + static_cast<std::size_t>(header.bodyCount);
+    pairOffset = particleOrderOffset + static_cast<std::size_t>(header.particleCount);
+}
+
+void WorldSnapshot::makeDelta(const WorldSnapshot& base, SnapshotDelta& out) const {
+    out.baseEmpty = base.isEmpty();
+    out.baseFrame = out.baseEmpty ? 0 : base.getFrame();
+    out.frame = getFrame();
+    out.wordCount = words.size();
+    out.runs.clear();
+    out.words.clear();
+
+    // 공통 길이 안에서는 다른 워드만, 그 뒤로 늘어난 부분은 통째로 기록
+    std::size_t common = std::min(words.size(), base.words.size());
+    std::size_t i = 0;
+    while (i < common) {
+        if (words[i] == base.words[i]) {
+            ++i;
+            continue;
+        }
+        std::size_t begin = i;
+        while (i < common && words[i] != base.words[i]) {
+            ++i;
+        }
+        out.runs.push_back(static_cast<std::uint32_t>(begin));
+        out.runs.push_back(static_cast<std::uint32_t>(i - begin));
+        out.words.insert(out.words.end(), words.begin() + begin, words.begin() + i);
+    }
+    if (words.size() > common) {
+        out.runs.push_back(static_cast<std::uint32_t>(common));
+        out.runs.push_back(static_cast<std::uint32_t>(words.size() - common));
+        out.words.insert(out.words.end(), words.begin() + common, words.end());
+    }
+}
+
+void WorldSnapshot::applyDelta(const SnapshotDelta& delta) {
+    if (isEmpty() != delta.baseEmpty || (!isEmpty() && getFrame() != delta.baseFrame)) {
+        throw std::invalid_argument("WorldSnapshot::applyDelta base frame mismatch");
+    }
+    words.resize(delta.wordCount, 0);
+
+    const std::uint64_t* source = delta.words.data();
+    for (std::size_t r = 0; r + 1 < delta.runs.size(); r += 2) {
+        std::size_t begin = delta.runs[r];
+        std::size_t count = delta.runs[r + 1];
+        if (begin + count > words.size()) {
+            throw std::invalid_argument("WorldSnapshot::applyDelta run out of range");
+        }
+        std::memcpy(words.data() + begin, source, count * sizeof(std::uint64_t));
+        source += count;
+    }
+    updateOffsets();
+}
+
+SnapshotHistory::SnapshotHistory(std::size_t capacity)
+    : slots(capacity), next(0), count(0)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("SnapshotHistory capacity must be positive");
+    }
+}
+
+const WorldSnapshot& SnapshotHistory::record(const PhysicsWorld& world) {
+    WorldSnapshot& slot = slots[next];
+    world.saveSnapshot(slot);
+    next = (next + 1) % slots.size();
+    count = std::min(count + 1, slots.size());
+    return slot;
+}
+
+const WorldSnapshot* SnapshotHistory::find(std::uint64_t frame) const {
+    for (std::size_t k = 0; k < count; ++k) {
+        const WorldSnapshot& slot = slots[(next + slots.size() - 1 - k) % slots.size()];
+        if (slot.getFrame() == frame) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+bool SnapshotHistory::rewind(PhysicsWorld& world, std::uint64_t frame) {
+    // 최신 기록부터 거슬러 올라가며, 찾은 슬롯이 가장 최근 기록이 되도록 이후 기록을 버린다
+    for (std::size_t k = 0; k < count; ++k) {
+        std::size_t index = (next + slots.size() - 1 - k) % slots.size();
+        if (slots[index].getFrame() == frame) {
+            world.restoreSnapshot(slots[index]);
+            next = (index + 1) % slots.size();
+            count -= k;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // WORLDSNAPSHOT_CPP
@@ -0,0 +1,530 @@
+﻿#ifndef XPBDSOLVER_CPP
+#define XPBDSOLVER_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "XPBDSolver.h"
+#include "Contact.h"
+#include "Constants.h"
+
+namespace {
+
+    // 제약 종류별 입자 수
+    std::size_t particleCount(XPBDSolver::ConstraintType type) {
+        switch (type) {
+        case XPBDSolver::ConstraintType::Distance: return 2;
+        case XPBDSolver::ConstraintType::Bending: return 3;
+        default: return 4;
+        }
+    }
+
+    // 제약의 풀이 순서: 가장 작은 입자 슬롯 순, 같으면 종류/입자 슬롯/매개변수 순 (완전히 같은 제약끼리만 동률)
+    // 이전 제약 순서와 무관한 전순서이므로 같은 입자 배치에서는 색칠과 풀이 순서가 항상 같다.
+    bool constraintBefore(const XPBDSolver::Constraint& a, const XPBDSolver::Constraint& b) {
+        std::uint32_t firstA = *std::min_element(a.particles, a.particles + particleCount(a.type));
+        std::uint32_t firstB = *std::min_element(b.particles, b.particles + particleCount(b.type));
+        if (firstA != firstB) {
+            return firstA < firstB;
+        }
+        if (a.type != b.type) {
+            return a.type < b.type;
+        }
+        for (std::size_t k = 0; k < particleCount(a.type); ++k) {
+            if (a.particles[k] != b.particles[k]) {
+                return a.particles[k] < b.particles[k];
+            }
+        }
+        if (a.rest != b.rest) {
+            return a.rest < b.rest;
+        }
+        return a.compliance < b.compliance;
+    }
+
+    // 병렬 풀이 시 작업 하나가 맡는 제약 수
+    constexpr std::size_t CONSTRAINTS_PER_TASK = 64;
+
+} // namespace
+
+XPBDSolver::XPBDSolver()
+    : gravity(0.0, -Constants<double>::GRAVITY, 0.0),
+    substeps(8),
+    iterations(1),
+    particleRadius(0.02),
+    friction(0.3),
+    parallelThreshold(256),
+    overflowBegin(0),
+    constraintsDirty(false) {}
+
+std::size_t XPBDSolver::addParticle(const Vector3<double>& position, double mass) {
+    positions.push_back(position);
+    previousPositions.push_back(position);
+    velocities.push_back(Vector3<double>(0.0, 0.0, 0.0));
+    restInverseMasses.push_back(mass > 0.0 ? 1.0 / mass : 0.0);
+    inverseMasses.push_back(restInverseMasses.back());
+    return particleSlots.add();
+}
+
+void XPBDSolver::addDistanceConstraint(std::size_t a, std::size_t b, double compliance, double restLength) {
+    a = particleSlots.getSlot(a);
+    b = particleSlots.getSlot(b);
+    if (restLength < 0.0) {
+        restLength = (positions.at(b) - positions.at(a)).magnitude();
+    }
+    Constraint c{ ConstraintType::Distance, { static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), 0, 0 }, restLength, compliance, 0.0 };
+    constraints.push_back(c);
+    constraintsDirty = true;
+}
+
+void XPBDSolver::addBendingConstraint(std::size_t a, std::size_t middle, std::size_t b, double compliance) {
+    a = particleSlots.getSlot(a);
+    middle = particleSlots.getSlot(middle);
+    b = particleSlots.getSlot(b);
+    Vector3<double> center = (positions.at(a) + positions.at(middle) + positions.at(b)) / 3.0;
+    double rest = (positions[middle] - center).magnitude();
+    Constraint c{ ConstraintType::Bending,
+        { static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(middle), static_cast<std::uint32_t>(b), 0 }, rest, compliance, 0.0 };
+    constraints.push_back(c);
+    constraintsDirty = true;
+}
+
+void XPBDSolver::addVolumeConstraint(std::size_t a, std::size_t b, std::size_t c, std::size_t d, double compliance) {
+    a = particleSlots.getSlot(a);
+    b = particleSlots.getSlot(b);
+    c = particleSlots.getSlot(c);
+    d = particleSlots.getSlot(d);
+    const Vector3<double>& p0 = positions.at(a);
+    double rest = ((positions.at(b) - p0) ^ (positions.at(c) - p0)) * (positions.at(d) - p0);
+    Constraint constraint{ ConstraintType::Volume,
+        { static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(c), static_cast<std::uint32_t>(d) },
+        rest, compliance, 0.0 };
+    constraints.push_back(constraint);
+    constraintsDirty = true;
+}
+
+std::size_t XPBDSolver::addRope(const Vector3<double>& start, const Vector3<double>& end, std::size_t segments,
+    double totalMass, double stretchCompliance, double bendCompliance)
+{
+    if (segments == 0) {
+        throw std::invalid_argument("XPBDSolver::addRope requires at least one segment");
+    }
+
+    std::size_t first = positions.size();
+    double particleMass = totalMass / static_cast<double>(segments + 1);
+    for (std::size_t i = 0; i <= segments; ++i) {
+        double t = static_cast<double>(i) / static_cast<double>(segments);
+        addParticle(start + (end - start) * t, particleMass);
+    }
+    for (std::size_t i = 0; i < segments; ++i) {
+        addDistanceConstraint(first + i, first + i + 1, stretchCompliance);
+    }
+    for (std::size_t i = 1; i < segments; ++i) {
+        addBendingConstraint(first + i - 1, first + i, first + i + 1, bendCompliance);
+    }
+    return first;
+}
+
+std::size_t XPBDSolver::addCloth(const Vector3<double>& origin, const Vector3<double>& uAxis, const Vector3<double>& vAxis,
+    std::size_t columns, std::size_t rows, double totalMass, double stretchCompliance, double bendCompliance)
+{
+    if (columns < 2 || rows < 2) {
+        throw std::invalid_argument("XPBDSolver::addCloth requires at least 2 x 2 particles");
+    }
+
+    std::size_t first = positions.size();
+    double particleMass = totalMass / static_cast<double>(columns * rows);
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < columns; ++c) {
+            double u = static_cast<double>(c) / static_cast<double>(columns - 1);
+            double v = static_cast<double>(r) / static_cast<double>(rows - 1);
+            addParticle(origin + uAxis * u + vAxis * v, particleMass);
+        }
+    }
+
+    auto at = [&](std::size_t c, std::size_t r) { return first + r * columns + c; };
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < columns; ++c) {
+            // 인장
+            if (c + 1 < columns) addDistanceConstraint(at(c, r), at(c + 1, r), stretchCompliance);
+            if (r + 1 < rows) addDistanceConstraint(at(c, r), at(c, r + 1), stretchCompliance);
+            // 전단
+            if (c + 1 < columns && r + 1 < rows) {
+                addDistanceConstraint(at(c, r), at(c + 1, r + 1), stretchCompliance);
+                addDistanceConstraint(at(c + 1, r), at(c, r + 1), stretchCompliance);
+            }
+            // 굽힘
+            if (c + 2 < columns) addBendingConstraint(at(c, r), at(c + 1, r), at(c + 2, r), bendCompliance);
+            if (r + 2 < rows) addBendingConstraint(at(c, r), at(c, r + 1), at(c, r + 2), bendCompliance);
+        }
+    }
+    return first;
+}
+
+std::size_t XPBDSolver::addTetrahedralBody(const std::vector<Vector3<double>>& vertices, const std::vector<unsigned int>& tetrahedra,
+    double totalMass, double edgeCompliance, double volumeCompliance)
+{
+    if (vertices.empty() || tetrahedra.empty() || tetrahedra.size() % 4 != 0) {
+        throw std::invalid_argument("XPBDSolver::addTetrahedralBody requires vertices and 4 indices per tetrahedron");
+    }
+
+    std::size_t first = positions.size();
+    double particleMass = totalMass / static_cast<double>(vertices.size());
+    for (const auto& v : vertices) {
+        addParticle(v, particleMass);
+    }
+
+    // 사면체끼리 공유하는 모서리는 한 번만 제약
+    std::map<std::pair<unsigned int, unsigned int>, bool> edges;
+    static const int edgeVertices[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+    for (std::size_t t = 0; t < tetrahedra.size(); t += 4) {
+        for (const auto& e : edgeVertices) {
+            unsigned int a = tetrahedra[t + e[0]];
+            unsigned int b = tetrahedra[t + e[1]];
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            if (edges.emplace(key, true).second) {
+                addDistanceConstraint(first + a, first + b, edgeCompliance);
+            }
+        }
+        addVolumeConstraint(first + tetrahedra[t], first + tetrahedra[t + 1], first + tetrahedra[t + 2], first + tetrahedra[t + 3],
+            volumeCompliance);
+    }
+    return first;
+}
+
+void XPBDSolver::setPinned(std::size_t handle, bool pinned) {
+    std::size_t index = particleSlots.getSlot(handle);
+    inverseMasses[index] = pinned ? 0.0 : restInverseMasses[index];
+    if (pinned) {
+        velocities[index] = Vector3<double>(0.0, 0.0, 0.0);
+    }
+}
+
+// 공간적으로 가까운 입자가 메모리에서도 가깝도록 모턴 순서로 재배치
+// 제약은 다시 색칠할 때 가장 작은 새 슬롯 순으로 정렬되므로, 색 안에서도 제약이 훑는 입자 구간이 좁아진다.
+void XPBDSolver::reorderParticles() {
+    if (positions.size() < 2) {
+        return;
+    }
+    computeMortonOrder(positions.data(), positions.size(), reorderOrder);
+    permuteParticles();
+}
+
+void XPBDSolver::setParticleOrder(const std::uint64_t* handleOfSlot) {
+    // 순열인지 확인하면서 order[새 슬롯] = 현재 슬롯 을 만든다
+    reorderOrder.resize(positions.size());
+    reorderPlaced.assign(positions.size(), 0);
+    for (std::size_t slot = 0; slot < positions.size(); ++slot) {
+        if (handleOfSlot[slot] >= positions.size() || reorderPlaced[handleOfSlot[slot]]) {
+            throw std::invalid_argument("XPBDSolver::setParticleOrder order is not a permutation of particle handles");
+        }
+        reorderPlaced[handleOfSlot[slot]] = 1;
+        reorderOrder[slot] = particleSlots.getSlot(static_cast<std::size_t>(handleOfSlot[slot]));
+    }
+    permuteParticles();
+}
+
+// reorderOrder 순열로 입자 배열과 제약의 입자 슬롯을 옮기고 다시 색칠하도록 표시
+void XPBDSolver::permuteParticles() {
+    particleSlots.permute(reorderOrder, reorderSlots);
+    applyOrder(positions, reorderOrder, reorderPlaced);
+    applyOrder(previousPositions, reorderOrder, reorderPlaced);
+    applyOrder(velocities, reorderOrder, reorderPlaced);
+    applyOrder(inverseMasses, reorderOrder, reorderPlaced);
+    applyOrder(restInverseMasses, reorderOrder, reorderPlaced);
+
+    for (Constraint& c : constraints) {
+        for (std::size_t k = 0; k < particleCount(c.type); ++k) {
+            c.particles[k] = static_cast<std::uint32_t>(reorderSlots[c.particles[k]]);
+        }
+    }
+    particleContacts.clear();
+    constraintsDirty = true;
+}
+
+// 제약을 정해진 전순서로 정렬하고, 입자를 공유하지 않는 제약끼리 같은 색이 되도록 탐욕적으로 색칠한 뒤 색 순서로 재배열
+void XPBDSolver::colorConstraints() {
+    std::sort(constraints.begin(), constraints.end(), constraintBefore);
+    std::vector<std::uint64_t> particleColors(positions.size(), 0);
+    std::vector<std::vector<Constraint>> buckets(MAX_COLORS);
+    std::vector<Constraint> overflow;
+
+    for (const auto& c : constraints) {
+        std::size_t count = particleCount(c.type);
+        std::uint64_t used = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            used |= particleColors[c.particles[k]];
+        }
+        if (used == ~std::uint64_t(0)) {
+            overflow.push_back(c);
+            continue;
+        }
+        std::size_t color = 0;
+        while (used & (std::uint64_t(1) << color)) {
+            ++color;
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+            particleColors[c.particles[k]] |= std::uint64_t(1) << color;
+        }
+        buckets[color].push_back(c);
+    }
+
+    constraints.clear();
+    colorOffsets.clear();
+    colorOffsets.push_back(0);
+    for (auto& bucket : buckets) {
+        if (bucket.empty()) {
+            break;
+        }
+        constraints.insert(constraints.end(), bucket.begin(), bucket.end());
+        colorOffsets.push_back(constraints.size());
+    }
+    overflowBegin = constraints.size();
+    constraints.insert(constraints.end(), overflow.begin(), overflow.end());
+    constraintsDirty = false;
+}
+
+// 일반화된 XPBD 갱신: Δλ = (-C - α̃ λ) / (Σ w |∇C|² + α̃), α̃ = α / h²
+void XPBDSolver::solveConstraint(Constraint& constraint, double timeStep) {
+    Vector3<double> gradients[4];
+    double value = 0.0;
+    const std::uint32_t* p = constraint.particles;
+    std::size_t count = particleCount(constraint.type);
+
+    switch (constraint.type) {
+    case ConstraintType::Distance: {
+        Vector3<double> delta = positions[p[0]] - positions[p[1]];
+        double length = delta.magnitude();
+        if (length <= Constants<double>::TOLERANCE) {
+            return;
+        }
+        Vector3<double> n = delta / length;
+        value = length - constraint.rest;
+        gradients[0] = n;
+        gradients[1] = -n;
+        break;
+    }
+    case ConstraintType::Bending: {
+        Vector3<double> center = (positions[p[0]] + positions[p[1]] + positions[p[2]]) / 3.0;
+        Vector3<double> delta = positions[p[1]] - center;
+        double length = delta.magnitude();
+        if (length <= Constants<double>::TOLERANCE) {
+            return;
+        }
+        Vector3<double> n = delta / length;
+        value = length - constraint.rest;
+        gradients[0] = n * (-1.0 / 3.0);
+        gradients[1] = n * (2.0 / 3.0);
+        gradients[2] = n * (-1.0 / 3.0);
+        break;
+    }
+    case ConstraintType::Volume: {
+        const Vector3<double>& p0 = positions[p[0]];
+        Vector3<double> e1 = positions[p[1]] - p0;
+        Vector3<double> e2 = positions[p[2]] - p0;
+        Vector3<double> e3 = positions[p[3]] - p0;
+        gradients[1] = e2 ^ e3;
+        gradients[2] = e3 ^ e1;
+        gradients[3] = e1 ^ e2;
+        gradients[0] = -(gradients[1] + gradients[2] + gradients[3]);
+        value = e1 * gradients[1] - constraint.rest;
+        break;
+    }
+    }
+
+    double denominator = 0.0;
+    for (std::size_t k = 0; k < count; ++k) {
+        denominator += inverseMasses[p[k]] * (gradients[k] * gradients[k]);
+    }
+    double alpha = constraint.compliance / (timeStep * timeStep);
+    if (denominator + alpha <= 0.0) {
+        return;
+    }
+
+    double deltaLambda = (-value - alpha * constraint.lambda) / (denominator + alpha);
+    constraint.lambda += deltaLambda;
+    for (std::size_t k = 0; k < count; ++k) {
+        positions[p[k]] += gradients[k] * (inverseMasses[p[k]] * deltaLambda);
+    }
+}
+
+// 색 단위 가우스-자이델: 같은 색의 제약은 입자를 공유하지 않으므로 병렬로 풀 수 있다
+void XPBDSolver::solveConstraints(ThreadPool& pool, double timeStep) {
+    for (std::size_t color = 0; color + 1 < colorOffsets.size(); ++color) {
+        std::size_t begin = colorOffsets[color];
+        std::size_t end = colorOffsets[color + 1];
+        std::size_t count = end - begin;
+        if (count < parallelThreshold) {
+            for (std::size_t i = begin; i < end; ++i) {
+                solveConstraint(constraints[i], timeStep);
+            }
+            continue;
+        }
+        std::size_t tasks = (count + CONSTRAINTS_PER_TASK - 1) / CONSTRAINTS_PER_TASK;
+        pool.parallelFor(tasks, [&](std::size_t task) {
+            std::size_t first = begin + task * CONSTRAINTS_PER_TASK;
+            std::size_t last = std::min(first + CONSTRAINTS_PER_TASK, end);
+            for (std::size_t i = first; i < last; ++i) {
+                solveConstraint(constraints[i], timeStep);
+            }
+        });
+    }
+    for (std::size_t i = overflowBegin; i < constraints.size(); ++i) {
+        solveConstraint(constraints[i], timeStep);
+    }
+}
+
+// 스텝 동안 닿을 수 있는 바닥/물체 접촉 후보 수집 (이동 거리만큼 여유를 둠)
+void XPBDSolver::collectContacts(const std::vector<PhysicsObject>& bodies, double groundHeight, const HeightField* terrain, double deltaTime) {
+    particleContacts.clear();
+
+    // 물체를 경계 구 중심 x 로 정렬해 입자마다 후보 범위만 훑는다
+    bodyOrder.clear();
+    double maxBodyRadius = 0.0;
+    for (std::size_t b = 0; b < bodies.size(); ++b) {
+        bodyOrder.push_back(b);
+        maxBodyRadius = std::max(maxBodyRadius, bodies[b].getBoundingRadius());
+    }
+    std::sort(bodyOrder.begin(), bodyOrder.end(), [&](std::size_t a, std::size_t b) {
+        return bodies[a].getPosition().x < bodies[b].getPosition().x;
+    });
+
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        if (inverseMasses[i] == 0.0) {
+            continue;
+        }
+        const Vector3<double>& p = positions[i];
+        double margin = particleRadius + velocities[i].magnitude() * deltaTime;
+
+        // 바닥 평면 또는 지형의 접평면
+        Vector3<double> normal(0.0, 1.0, 0.0);
+        double height = terrain ? terrain->getHeightAndNormal(p.x, p.z, normal) : groundHeight;
+        if ((p.y - height) * normal.y < margin) {
+            particleContacts.push_back(ParticleContact{ i, Contact::STATIC_BODY, normal, Vector3<double>(p.x, height, p.z), particleRadius, 0.0 });
+        }
+
+        double reach = margin + maxBodyRadius;
+        auto it = std::lower_bound(bodyOrder.begin(), bodyOrder.end(), p.x - reach, [&](std::size_t b, double x) {
+            return bodies[b].getPosition().x < x;
+        });
+        for (; it != bodyOrder.end() && bodies[*it].getPosition().x <= p.x + reach; ++it) {
+            const PhysicsObject& body = bodies[*it];
+            double distance = body.getBoundingRadius() + particleRadius;
+            Vector3<double> delta = p - body.getPosition();
+            double limit = distance + margin;
+            if (delta * delta < limit * limit) {
+                particleContacts.push_back(ParticleContact{ i, *it, Vector3<double>(0.0, 1.0, 0.0), body.getPosition(), distance, 0.0 });
+            }
+        }
+    }
+}
+
+// 접촉 부등식 제약 C = 거리 - 허용 거리 >= 0 (물체는 스텝 동안 고정, 질량비로 보정량 분배)
+void XPBDSolver::solveContacts(const std::vector<PhysicsObject>& bodies) {
+    for (auto& contact : particleContacts) {
+        Vector3<double>& x = positions[contact.particle];
+        double w = inverseMasses[contact.particle];
+
+        if (contact.body == Contact::STATIC_BODY) {
+            double value = (x - contact.point) * contact.normal - contact.distance;
+            if (value < 0.0) {
+                x -= contact.normal * value;
+            }
+            continue;
+        }
+
+        const PhysicsObject& body = bodies[contact.body];
+        Vector3<double> delta = x - contact.point;
+        double length = delta.magnitude();
+        double value = length - contact.distance;
+        if (value >= 0.0 || length <= Constants<double>::TOLERANCE) {
+            continue;
+        }
+        contact.normal = delta / length;
+        double bodyW = body.isSleeping() ? 0.0 : body.getInverseMass();
+        double deltaLambda = -value / (w + bodyW);
+        x += contact.normal * (w * deltaLambda);
+        contact.lambda += deltaLambda;
+    }
+}
+
+// 접촉 중인 입자의 하위 스텝 접선 변위를 friction 비율만큼 되돌림
+void XPBDSolver::applyFriction() {
+    for (const auto& contact : particleContacts) {
+        std::size_t i = contact.particle;
+        Vector3<double> normal = contact.normal;
+        double gap;
+        if (contact.body == Contact::STATIC_BODY) {
+            gap = (positions[i] - contact.point) * normal - contact.distance;
+        }
+        else {
+            gap = (positions[i] - contact.point).magnitude() - contact.distance;
+        }
+        if (gap > Constants<double>::TOLERANCE) {
+            continue;
+        }
+        Vector3<double> displacement = positions[i] - previousPositions[i];
+        Vector3<double> tangential = displacement - normal * (displacement * normal);
+        positions[i] -= tangential * friction;
+    }
+}
+
+// 입자가 물체에 가한 위치 보정을 충격량으로 환산해 동적 물체에 되돌려 줌
+void XPBDSolver::applyReactions(std::vector<PhysicsObject>& bodies, double timeStep) {
+    for (const auto& contact : particleContacts) {
+        if (contact.body == Contact::STATIC_BODY || contact.lambda <= 0.0) {
+            continue;
+        }
+        PhysicsObject& body = bodies[contact.body];
+        if (body.isStatic() || body.isSleeping()) {
+            continue;
+        }
+        body.applyImpulse(-contact.normal * (contact.lambda / timeStep), positions[contact.particle] - body.getPosition());
+    }
+}
+
+void XPBDSolver::step(double deltaTime, ThreadPool& pool, std::vector<PhysicsObject>& bodies,
+    double groundHeight, const HeightField* terrain)
+{
+    if (positions.empty() || substeps == 0) {
+        return;
+    }
+    if (constraintsDirty) {
+        colorConstraints();
+    }
+
+    const double h = deltaTime / static_cast<double>(substeps);
+    collectContacts(bodies, groundHeight, terrain, deltaTime);
+
+    for (std::size_t s = 0; s < substeps; ++s) {
+        // 예측
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            previousPositions[i] = positions[i];
+            if (inverseMasses[i] == 0.0) {
+                continue;
+            }
+            velocities[i] += gravity * h;
+            positions[i] += velocities[i] * h;
+        }
+
+        // 제약 투영 (λ 는 하위 스텝마다 초기화)
+        for (auto& c : constraints) {
+            c.lambda = 0.0;
+        }
+        for (std::size_t it = 0; it < iterations; ++it) {
+            solveConstraints(pool, h);
+            solveContacts(bodies);
+        }
+        applyFriction();
+
+        // 속도 갱신
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            velocities[i] = inverseMasses[i] == 0.0 ? Vector3<double>(0.0, 0.0, 0.0) : (positions[i] - previousPositions[i]) / h;
+        }
+    }
+
+    applyReactions(bodies, h);
+}
+
+#endif // XPBDSOLVER_CPP